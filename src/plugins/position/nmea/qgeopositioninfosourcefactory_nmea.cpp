@@ -4,12 +4,13 @@
 #include "qgeopositioninfosourcefactory_nmea.h"
 #include <QtPositioning/QNmeaPositionInfoSource>
 #include <QtPositioning/QNmeaSatelliteInfoSource>
+#include <QtPositioning/private/qnmeasentencedispatcher_p.h>
 #include <QtNetwork/QTcpSocket>
 #include <QLoggingCategory>
 #include <QSet>
 #include <QUrl>
 #include <QFile>
-#include <QSharedPointer>
+#include <QPointer>
 #include "qiopipe_p.h"
 
 #ifdef QT_NMEA_PLUGIN_HAS_SERIALPORT
@@ -29,6 +30,20 @@ static const auto serialScheme = QStringLiteral("serial:");
 static const auto baudRateParameterName = QStringLiteral("nmea.baudrate");
 static constexpr auto defaultBaudRate = 4800;
 
+static const auto simulationStartParameterName = QStringLiteral("nmea.simulation.start");
+
+// Makes the first seek() of a source save the index of the timestamps in a
+// log next to it, for the next sources to read instead of scanning the log.
+// Only done when asked for, as the directory of the log may be read-only or
+// shared. Both sources use the same name for the parameter.
+template <typename Source>
+static void setSimulationIndex(Source *source, const QVariantMap &parameters)
+{
+    const auto index = parameters.constFind(Source::SimulationIndex);
+    if (index != parameters.cend() && !source->setBackendProperty(Source::SimulationIndex, *index))
+        qWarning("nmea: invalid value %s to index the log", qPrintable(index->toString()));
+}
+
 #ifdef QT_NMEA_PLUGIN_HAS_SERIALPORT
 
 // This class is used only for SerialPort devices, because we can't open the
@@ -40,6 +55,9 @@ static constexpr auto defaultBaudRate = 4800;
 // TcpSocket could be used with QIOPipe, but it complicates error handling
 // dramatically, as we would need to somehow forward socket errors through
 // QIOPipes to the clients.
+// All the position and satellite sources using a serial port share one
+// QNmeaSentenceDispatcher. It reads the port through a child pipe of the
+// proxy pipe, and splits the NMEA stream once for all of them.
 class IODeviceContainer
 {
 public:
@@ -47,13 +65,11 @@ public:
     IODeviceContainer(IODeviceContainer const&) = delete;
     void operator=(IODeviceContainer const&)  = delete;
 
-    QSharedPointer<QIOPipe> serial(const QString &portName, qint32 baudRate)
+    QNmeaSentenceDispatcher *serial(const QString &portName, qint32 baudRate)
     {
         if (m_serialPorts.contains(portName)) {
             m_serialPorts[portName].refs++;
-            QIOPipe *endPipe = new QIOPipe(m_serialPorts[portName].proxy);
-            m_serialPorts[portName].proxy->addChildPipe(endPipe);
-            return QSharedPointer<QIOPipe>(endPipe);
+            return m_serialPorts[portName].dispatcher;
         }
         IODevice device;
         QSerialPort *port = new QSerialPort(portName);
@@ -68,18 +84,18 @@ public:
         device.device = port;
         device.refs = 1;
         device.proxy = new QIOPipe(port, QIOPipe::ProxyPipe);
-        m_serialPorts[portName] = device;
         QIOPipe *endPipe = new QIOPipe(device.proxy);
         device.proxy->addChildPipe(endPipe);
-        return QSharedPointer<QIOPipe>(endPipe);
+        device.dispatcher = new QNmeaSentenceDispatcher(endPipe, port);
+        m_serialPorts[portName] = device;
+        return device.dispatcher;
     }
 
-    void releaseSerial(const QString &portName, QSharedPointer<QIOPipe> &pipe)
+    void releaseSerial(const QString &portName)
     {
         if (!m_serialPorts.contains(portName))
             return;
 
-        pipe.clear(); // make sure to release the pipe returned by getSerial, or else, if there are still refs, data will be leaked through it
         IODevice &device = m_serialPorts[portName];
         if (device.refs > 1) {
             device.refs--;
@@ -93,9 +109,10 @@ public:
 private:
 
     struct IODevice {
-        QIODevice *device = nullptr;
+        QIODevice *device = nullptr; // owns the proxy and the dispatcher
         QIOPipe *proxy = nullptr; // adding client pipes as children of proxy
                                   // allows to dynamically add clients to one device.
+        QNmeaSentenceDispatcher *dispatcher = nullptr;
         unsigned int refs = 1;
     };
 
@@ -138,11 +155,11 @@ class NmeaSource : public QNmeaPositionInfoSource
     Q_OBJECT
 public:
     NmeaSource(QObject *parent, const QVariantMap &parameters);
-    NmeaSource(QObject *parent, const QString &fileName);
+    NmeaSource(QObject *parent, const QString &fileName, const QVariantMap &parameters);
     ~NmeaSource() override;
     bool isValid() const
     {
-        return !m_dataSource.isNull() || !m_fileSource.isNull() || !m_socket.isNull();
+        return !m_dispatcher.isNull() || !m_fileSource.isNull() || !m_socket.isNull();
     }
 
 private slots:
@@ -154,29 +171,55 @@ private:
     void setFileName(const QString &fileName);
     void connectSocket(const QString &source);
 
-    QSharedPointer<QIOPipe> m_dataSource;
+    QPointer<QNmeaSentenceDispatcher> m_dispatcher;
     QScopedPointer<QFile> m_fileSource;
     QScopedPointer<QTcpSocket> m_socket;
     QString m_sourceName;
 };
 
+// Sets the QNmeaPositionInfoSource::KeepSentences parameter, in both modes
+static void setKeepSentences(QNmeaPositionInfoSource *source, const QVariantMap &parameters)
+{
+    const auto keep = parameters.constFind(QNmeaPositionInfoSource::KeepSentences);
+    if (keep != parameters.cend()
+        && !source->setBackendProperty(QNmeaPositionInfoSource::KeepSentences, *keep)) {
+        qWarning("nmea: invalid value %s to keep sentences", qPrintable(keep->toString()));
+    }
+}
+
 NmeaSource::NmeaSource(QObject *parent, const QVariantMap &parameters)
     : QNmeaPositionInfoSource(RealTimeMode, parent)
 {
+    setKeepSentences(this, parameters);
     processParameters(NmeaParameters(parameters));
 }
 
-NmeaSource::NmeaSource(QObject *parent, const QString &fileName)
+// The replay speed is set with the QNmeaPositionInfoSource::SimulationSpeed
+// parameter. Invalid values are rejected by setBackendProperty(), and the
+// data is replayed at the recorded rate.
+NmeaSource::NmeaSource(QObject *parent, const QString &fileName,
+                       const QVariantMap &parameters)
     : QNmeaPositionInfoSource(SimulationMode, parent)
 {
+    const auto speed = parameters.constFind(QNmeaPositionInfoSource::SimulationSpeed);
+    if (speed != parameters.cend()
+        && !setBackendProperty(QNmeaPositionInfoSource::SimulationSpeed, *speed)) {
+        qWarning("nmea: invalid simulation speed %s", qPrintable(speed->toString()));
+    }
+    setKeepSentences(this, parameters);
     setFileName(fileName);
+    setSimulationIndex(this, parameters);
+
+    const auto start = parameters.constFind(simulationStartParameterName);
+    if (start != parameters.cend() && device() && !seek(start->toDateTime()))
+        qWarning("nmea: cannot start the simulation at %s", qPrintable(start->toString()));
 }
 
 NmeaSource::~NmeaSource()
 {
 #ifdef QT_NMEA_PLUGIN_HAS_SERIALPORT
-    if (deviceContainer.exists())
-        deviceContainer->releaseSerial(m_sourceName, m_dataSource);
+    if (deviceContainer.exists() && m_dispatcher)
+        deviceContainer->releaseSerial(m_sourceName);
 #endif
 }
 
@@ -256,11 +299,11 @@ void NmeaSource::addSerialDevice(const QString &requestedPort, quint32 baudRate)
     if (m_sourceName.isEmpty())
         return;
 
-    m_dataSource = deviceContainer->serial(m_sourceName, baudRate);
-    if (!m_dataSource)
+    m_dispatcher = deviceContainer->serial(m_sourceName, baudRate);
+    if (!m_dispatcher)
         return;
 
-    setDevice(m_dataSource.data());
+    m_dispatcher->addSource(this);
 #else
     Q_UNUSED(baudRate);
     // As we are not calling setDevice(), the source will be invalid, so
@@ -315,7 +358,10 @@ public:
     NmeaSatelliteSource(QObject *parent, const QString &fileName, const QVariantMap &parameters);
     ~NmeaSatelliteSource();
 
-    bool isValid() const { return !m_port.isNull() || !m_file.isNull() || !m_socket.isNull(); }
+    bool isValid() const
+    {
+        return !m_dispatcher.isNull() || !m_file.isNull() || !m_socket.isNull();
+    }
 
 private slots:
     void onSocketError(QAbstractSocket::SocketError error);
@@ -324,7 +370,7 @@ private:
     void processRealtimeParameters(const NmeaParameters &parameters);
     void parseSimulationSource(const QString &localFileName);
 
-    QSharedPointer<QIOPipe> m_port;
+    QPointer<QNmeaSentenceDispatcher> m_dispatcher;
     QScopedPointer<QFile> m_file;
     QScopedPointer<QTcpSocket> m_socket;
     QString m_sourceName;
@@ -350,13 +396,18 @@ NmeaSatelliteSource::NmeaSatelliteSource(QObject *parent, const QString &fileNam
     if (ok)
         setBackendProperty(QNmeaSatelliteInfoSource::SimulationUpdateInterval, interval);
     parseSimulationSource(fileName);
+    setSimulationIndex(this, parameters);
+
+    const auto start = parameters.constFind(simulationStartParameterName);
+    if (start != parameters.cend() && device() && !seek(start->toDateTime()))
+        qWarning("nmea: cannot start the simulation at %s", qPrintable(start->toString()));
 }
 
 NmeaSatelliteSource::~NmeaSatelliteSource()
 {
 #ifdef QT_NMEA_PLUGIN_HAS_SERIALPORT
-    if (deviceContainer.exists())
-        deviceContainer->releaseSerial(m_sourceName, m_port);
+    if (deviceContainer.exists() && m_dispatcher)
+        deviceContainer->releaseSerial(m_sourceName);
 #endif
 }
 
@@ -409,11 +460,11 @@ void NmeaSatelliteSource::processRealtimeParameters(const NmeaParameters &parame
         if (m_sourceName.isEmpty())
             return;
 
-        m_port = deviceContainer->serial(m_sourceName, parameters.baudRate);
-        if (!m_port)
+        m_dispatcher = deviceContainer->serial(m_sourceName, parameters.baudRate);
+        if (!m_dispatcher)
             return;
 
-        setDevice(m_port.data());
+        m_dispatcher->addSource(this);
 #else
         // As we are not calling setDevice(), the source will be invalid, so
         // the factory methods will return nullptr.
@@ -489,7 +540,7 @@ QGeoPositionInfoSource *QGeoPositionInfoSourceFactoryNmea::positionInfoSource(QO
     if (localFileName.isEmpty())
         src = std::make_unique<NmeaSource>(parent, parameters); // use RealTimeMode
     else
-        src = std::make_unique<NmeaSource>(parent, localFileName); // use SimulationMode
+        src = std::make_unique<NmeaSource>(parent, localFileName, parameters); // use SimulationMode
 
     return (src && src->isValid()) ? src.release() : nullptr;
 }
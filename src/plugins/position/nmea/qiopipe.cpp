@@ -2,14 +2,138 @@
 // SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
 
 #include "qiopipe_p.h"
+#include <QtCore/qmath.h>
 #include <QtCore/qmetaobject.h>
 #include <QDebug>
 
+#include <cstring>
+
 QT_BEGIN_NAMESPACE
 
+static void qiopipe_copyToRing(char *ring, qint64 ringSize, qint64 position,
+                               const char *data, qint64 size)
+{
+    const qint64 offset = position & (ringSize - 1);
+    const qint64 first = qMin(size, ringSize - offset);
+    memcpy(ring + offset, data, first);
+    memcpy(ring, data + first, size - first);
+}
+
+static void qiopipe_copyFromRing(const char *ring, qint64 ringSize, qint64 position,
+                                 char *data, qint64 size)
+{
+    const qint64 offset = position & (ringSize - 1);
+    const qint64 first = qMin(size, ringSize - offset);
+    memcpy(data, ring + offset, first);
+    memcpy(data + first, ring, size - first);
+}
+
+qsizetype QIOPipeBuffer::addReader()
+{
+    // a new reader only gets the data appended from now on
+    const qsizetype reader = m_cursors.indexOf(-1);
+    if (reader >= 0) {
+        m_cursors[reader] = m_end;
+        return reader;
+    }
+    m_cursors.append(m_end);
+    return m_cursors.size() - 1;
+}
+
+void QIOPipeBuffer::removeReader(qsizetype reader)
+{
+    m_cursors[reader] = -1;
+}
+
+// Drops the data that all readers have read
+void QIOPipeBuffer::release()
+{
+    qint64 begin = m_end;
+    for (qint64 c : std::as_const(m_cursors)) {
+        if (c >= 0)
+            begin = qMin(begin, c);
+    }
+    m_begin = qMax(m_begin, begin);
+}
+
+void QIOPipeBuffer::reserve(qint64 size)
+{
+    const qint64 capacity = m_data.size();
+    if (size <= capacity)
+        return;
+
+    QByteArray data(qMax(qint64(qNextPowerOfTwo(quint64(size - 1))), qint64(4096)),
+                    Qt::Uninitialized);
+    const qint64 used = m_end - m_begin;
+    if (used > 0) {
+        const qint64 offset = m_begin & (capacity - 1);
+        const qint64 first = qMin(used, capacity - offset);
+        qiopipe_copyToRing(data.data(), data.size(), m_begin, m_data.constData() + offset, first);
+        qiopipe_copyToRing(data.data(), data.size(), m_begin + first, m_data.constData(),
+                           used - first);
+    }
+    m_data.swap(data);
+}
+
+void QIOPipeBuffer::append(QByteArrayView data)
+{
+    if (data.isEmpty())
+        return;
+
+    if (m_cursors.count(-1) == m_cursors.size()) {
+        // nobody is reading
+        m_begin = m_end = m_end + data.size();
+        return;
+    }
+
+    if (data.size() > MaximumSize) {
+        m_end += data.size() - MaximumSize;
+        data = data.last(MaximumSize);
+    }
+    release();
+    // overrun: drop the oldest data of the readers that are too far behind
+    m_begin = qBound(m_begin, m_end + data.size() - MaximumSize, m_end);
+
+    reserve(m_end - m_begin + data.size());
+    qiopipe_copyToRing(m_data.data(), m_data.size(), m_end, data.data(), data.size());
+    m_end += data.size();
+}
+
+qint64 QIOPipeBuffer::bytesAvailable(qsizetype reader) const
+{
+    return m_end - cursor(reader);
+}
+
+qint64 QIOPipeBuffer::indexOf(qsizetype reader, char c) const
+{
+    const qint64 begin = cursor(reader);
+    const qint64 size = m_end - begin;
+    if (size == 0)
+        return -1;
+
+    const qint64 capacity = m_data.size();
+    const qint64 offset = begin & (capacity - 1);
+    const qint64 first = qMin(size, capacity - offset);
+    if (const void *p = memchr(m_data.constData() + offset, c, first))
+        return static_cast<const char *>(p) - (m_data.constData() + offset);
+    if (const void *p = memchr(m_data.constData(), c, size - first))
+        return first + (static_cast<const char *>(p) - m_data.constData());
+    return -1;
+}
+
+qint64 QIOPipeBuffer::read(qsizetype reader, char *data, qint64 maxlen)
+{
+    const qint64 begin = cursor(reader);
+    const qint64 size = qMin(maxlen, m_end - begin);
+    if (size > 0)
+        qiopipe_copyFromRing(m_data.constData(), m_data.size(), begin, data, size);
+    m_cursors[reader] = begin + size;
+    return size;
+}
+
 /*
-    proxying means do *not* emit readyRead, and instead pump data
-    into child pipes directly in a zero-copy fashion.
+    proxying means do *not* emit readyRead, and instead notify the child
+    pipes, which read from the buffer of this pipe.
 */
 QIOPipePrivate::QIOPipePrivate(QIODevice *iodevice, bool proxying)
     :  m_proxying(proxying), source(iodevice)
@@ -18,14 +142,24 @@ QIOPipePrivate::QIOPipePrivate(QIODevice *iodevice, bool proxying)
 
 QIOPipePrivate::~QIOPipePrivate()
 {
+    if (reader >= 0)
+        buffer->removeReader(reader);
 }
 
 void QIOPipePrivate::initialize()
 {
     const QIOPipe *parentPipe = qobject_cast<QIOPipe *>(source);
-    if (parentPipe && parentPipe->d_func()->m_proxying) // with proxying parent,
-        return;                                                     // don't do anything
+    if (parentPipe && parentPipe->d_func()->m_proxying) {
+        // with proxying parent, read from its buffer
+        buffer = parentPipe->d_func()->buffer;
+        if (!m_proxying)
+            reader = buffer->addReader();
+        return;
+    }
 
+    buffer = new QIOPipeBuffer;
+    if (!m_proxying)
+        reader = buffer->addReader();
     // read available data, does not emit.
     readAvailableData();
     // connect readyRead to onReadyRead
@@ -35,43 +169,34 @@ void QIOPipePrivate::initialize()
 bool QIOPipePrivate::readAvailableData() {
     if (!source)
         return false;
-    QByteArray ba = source->readAll();
-    if (ba.isEmpty())
-        return false;
 
-    pumpData(ba);
-    return true;
+    bool dataRead = false;
+    char buf[4096];
+    qint64 size;
+    while ((size = source->read(buf, sizeof(buf))) > 0) {
+        buffer->append(QByteArrayView{buf, static_cast<qsizetype>(size)});
+        dataRead = true;
+    }
+    return dataRead;
 }
 
-void QIOPipePrivate::pumpData(const QByteArray &ba)
+void QIOPipePrivate::notifyReadyRead()
 {
+    Q_Q(QIOPipe);
     if (m_proxying) {
         auto isNull = [](const auto &cp) { return cp == nullptr; };
         childPipes.removeIf(isNull);
         for (const auto &cp : std::as_const(childPipes))
-            cp->d_func()->pushData(ba);
+            cp->d_func()->notifyReadyRead();
     } else {
-        for (auto &buffer : readBuffers)
-            buffer.append(ba);
-    }
-}
-
-void QIOPipePrivate::pushData(const QByteArray &ba)
-{
-    Q_Q(QIOPipe);
-    if (ba.isEmpty())
-        return;
-
-    pumpData(ba);
-    if (!m_proxying)
         emit q->readyRead();
+    }
 }
 
 void QIOPipePrivate::_q_onReadyRead()
 {
-    Q_Q(QIOPipe);
-    if (readAvailableData() && !m_proxying)
-        emit q->readyRead();
+    if (readAvailableData())
+        notifyReadyRead();
 }
 
 void QIOPipePrivate::addChildPipe(QIOPipe *childPipe)
@@ -94,7 +219,8 @@ QIOPipe::QIOPipe(QIODevice *parent, Mode mode)
         qWarning() << "QIOPipe: Failed to open " << parent;
         return;
     }
-    open(ReadOnly);
+    // reads go straight to the shared buffer, see readData()
+    open(ReadOnly | Unbuffered);
 }
 
 QIOPipe::~QIOPipe()
@@ -121,10 +247,21 @@ bool QIOPipe::isSequential() const
     return true;
 }
 
-void QIOPipe::setReadChannelCount(int count)
+qint64 QIOPipe::bytesAvailable() const
 {
-    Q_D(QIOPipe);
-    d->setReadChannelCount(qMax(count, 1));
+    Q_D(const QIOPipe);
+    qint64 available = QIODevice::bytesAvailable();
+    if (d->reader >= 0)
+        available += d->buffer->bytesAvailable(d->reader);
+    return available;
+}
+
+bool QIOPipe::canReadLine() const
+{
+    Q_D(const QIOPipe);
+    if (QIODevice::canReadLine())
+        return true;
+    return d->reader >= 0 && d->buffer->indexOf(d->reader, '\n') >= 0;
 }
 
 void QIOPipe::addChildPipe(QIOPipe *childPipe)
@@ -137,20 +274,19 @@ void QIOPipe::addChildPipe(QIOPipe *childPipe)
     \reimp
 
     \omit
-    This function does not really read anything, as we use QIODevicePrivate's
-    buffer. The buffer will be read inside of QIODevice before this
-    method will be called.
-    See QIODevicePrivate::read, buffer.read(data, maxSize).
+    Copies the data from the buffer shared with the parent pipe and the
+    other child pipes, and moves the cursor of this pipe past it.
     \endomit
 */
 qint64 QIOPipe::readData(char *data, qint64 maxlen)
 {
-    Q_UNUSED(data);
-    Q_UNUSED(maxlen);
+    Q_D(QIOPipe);
+    if (d->reader < 0)
+        return qint64(0);
 
     // return 0 indicating there may be more data in the future
     // Returning -1 means no more data in the future (end of stream).
-    return qint64(0);
+    return d->buffer->read(d->reader, data, maxlen);
 }
 
 qint64 QIOPipe::writeData(const char * /*data*/, qint64 /*len*/)
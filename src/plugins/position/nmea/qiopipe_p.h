@@ -19,12 +19,44 @@
 #include <QtCore/qbytearray.h>
 #include <QtCore/private/qiodevice_p.h>
 #include <QtCore/qpointer.h>
+#include <QtCore/qshareddata.h>
 
 QT_BEGIN_NAMESPACE
 
 class QObject;
 class QIOPipePrivate;
 
+/*
+    Append-only ring buffer shared by a pipe and all the pipes reading from
+    it. Every reader has its own cursor into the stream, and the data that
+    all readers have read is dropped. A reader that falls behind by more than
+    MaximumSize bytes loses the oldest data, like on a serial port overrun,
+    so that a client that stops reading does not make the buffer grow.
+*/
+class QIOPipeBuffer : public QSharedData
+{
+public:
+    static constexpr qint64 MaximumSize = 1 << 20;
+
+    qsizetype addReader();
+    void removeReader(qsizetype reader);
+
+    void append(QByteArrayView data);
+    qint64 bytesAvailable(qsizetype reader) const;
+    qint64 indexOf(qsizetype reader, char c) const;
+    qint64 read(qsizetype reader, char *data, qint64 maxlen);
+
+private:
+    qint64 cursor(qsizetype reader) const { return qMax(m_cursors.at(reader), m_begin); }
+    void release();
+    void reserve(qint64 size);
+
+    QByteArray m_data; // the size is a power of two
+    qint64 m_begin = 0; // stream position of the oldest byte kept
+    qint64 m_end = 0; // stream position after the newest byte
+    QList<qint64> m_cursors; // stream position per reader, -1 for unused slots
+};
+
 class QIOPipe : public QIODevice
 {
     Q_OBJECT
@@ -40,7 +72,8 @@ public:
 
     bool open(OpenMode openMode) override;
     bool isSequential() const override;
-    void setReadChannelCount(int count);
+    qint64 bytesAvailable() const override;
+    bool canReadLine() const override;
     void addChildPipe(QIOPipe *childPipe);
 
 protected:
@@ -62,8 +95,7 @@ public:
 
     void initialize();
     bool readAvailableData();
-    void pumpData(const QByteArray &ba);
-    void pushData(const QByteArray &ba);
+    void notifyReadyRead();
     void _q_onReadyRead();
     void addChildPipe(QIOPipe *childPipe);
     void removeChildPipe(QIOPipe *childPipe);
@@ -71,6 +103,8 @@ public:
     bool m_proxying = false;
     QPointer<QIODevice> source;
     QList<QPointer<QIOPipe>> childPipes;
+    QExplicitlySharedDataPointer<QIOPipeBuffer> buffer;
+    qsizetype reader = -1;
 };
 
 QT_END_NAMESPACE
@@ -6,19 +6,21 @@
 #include <QtPositioning/qgeorectangle.h>
 #include <QtPositioning/qgeocircle.h>
 
+#include <QtCore/qbitarray.h>
 #include <QtCore/qhash.h>
 #include <QtCore/qmetaobject.h>
 #include <QtCore/qtimer.h>
 #include <QtCore/qdebug.h>
 #include <QtCore/qmutex.h>
-#include <QtCore/qset.h>
+#include <QtCore/qvarlengtharray.h>
 
+#include <algorithm>
+#include <cmath>
 #include <mutex>
+#include <utility>
 
 #define UPDATE_INTERVAL_5S  5000
 
-typedef QHash<QString, QGeoAreaMonitorInfo> MonitorTable;
-
 
 static QMetaMethod areaEnteredSignal()
 {
@@ -38,6 +40,239 @@ static QMetaMethod monitorExpiredSignal()
     return signal;
 }
 
+/*
+    A uniform grid over the bounding boxes of the monitored areas, in degrees,
+    referring to the monitors by their handles. A position update only has to
+    test the monitors registered in the cells of the new and the previous
+    position, instead of every active monitor.
+
+    The cell size follows the median size of the bounding boxes, and is
+    adjusted whenever the number of monitors has doubled since the last time.
+    Areas whose bounding box would cover too many cells, and shapes whose
+    bounding box does not bound QGeoShape::contains() (the width of a QGeoPath
+    is not part of it), are kept in a list that is always tested.
+*/
+class QGeoAreaMonitorPollingIndex
+{
+public:
+    void insert(int handle, const QGeoShape &area)
+    {
+        remove(handle);
+        if (handle >= entries.size())
+            entries.resize(handle + 1);
+
+        Entry &entry = entries[handle];
+        entry.used = true;
+        entry.indexed = boundingBox(area, &entry.box);
+        ++size;
+
+        if (size >= 2 * sizeAtRebuild + MinRebuildSize)
+            rebuild();
+        else
+            add(handle);
+    }
+
+    void remove(int handle)
+    {
+        if (handle >= entries.size() || !entries.at(handle).used)
+            return;
+
+        Entry &entry = entries[handle];
+        if (entry.wide) {
+            unindexed.removeOne(handle);
+        } else {
+            forEachCell(entry.box, [&](quint64 key) {
+                const auto cell = cells.find(key);
+                if (cell == cells.end())
+                    return;
+                cell->removeOne(handle);
+                if (cell->isEmpty())
+                    cells.erase(cell);
+            });
+        }
+        entry = Entry();
+        --size;
+    }
+
+    /*
+        Calls \a function for the handle of every monitor whose area may
+        contain \a previous or \a current. A handle may be passed more than
+        once.
+    */
+    template <typename Function>
+    void forEachCandidate(const QGeoCoordinate &previous, const QGeoCoordinate &current,
+                          Function function) const
+    {
+        for (int handle : unindexed)
+            function(handle);
+
+        const auto forEachInCell = [&](quint64 key) {
+            const auto cell = cells.constFind(key);
+            if (cell != cells.cend()) {
+                for (int handle : *cell)
+                    function(handle);
+            }
+        };
+        if (current.isValid())
+            forEachInCell(cellKey(current));
+        if (previous.isValid() && (!current.isValid() || cellKey(previous) != cellKey(current)))
+            forEachInCell(cellKey(previous));
+    }
+
+private:
+    // maxLongitude < minLongitude if the box crosses the dateline
+    struct Box
+    {
+        double minLatitude = 0;
+        double maxLatitude = 0;
+        double minLongitude = 0;
+        double maxLongitude = 0;
+    };
+
+    struct Entry
+    {
+        Box box;
+        bool used = false;
+        bool indexed = false;
+        bool wide = false;
+    };
+
+    static constexpr qsizetype MinRebuildSize = 16;
+    static constexpr qsizetype MaxCellsPerEntry = 64;
+    static constexpr double MinCellSize = 0.001;
+    static constexpr double MaxCellSize = 45.0;
+    // absorbs the rounding differences between the bounding box and contains()
+    static constexpr double Margin = 1e-6;
+
+    static bool boundingBox(const QGeoShape &area, Box *box)
+    {
+        switch (area.type()) {
+        case QGeoShape::RectangleType:
+        case QGeoShape::CircleType:
+        case QGeoShape::PolygonType:
+            break;
+        default:
+            return false;
+        }
+
+        const QGeoRectangle rect = area.boundingGeoRectangle();
+        if (!rect.isValid())
+            return false;
+
+        box->minLatitude = rect.bottomRight().latitude() - Margin;
+        box->maxLatitude = rect.topLeft().latitude() + Margin;
+        box->minLongitude = rect.topLeft().longitude() - Margin;
+        box->maxLongitude = rect.bottomRight().longitude() + Margin;
+        return true;
+    }
+
+    static double longitudeSpan(const Box &box)
+    {
+        return box.minLongitude <= box.maxLongitude ? box.maxLongitude - box.minLongitude
+                                                    : 360.0 - box.minLongitude + box.maxLongitude;
+    }
+
+    static quint64 cellKey(int latitudeIndex, int longitudeIndex)
+    {
+        return (quint64(quint32(latitudeIndex)) << 32) | quint32(longitudeIndex);
+    }
+
+    quint64 cellKey(const QGeoCoordinate &coordinate) const
+    {
+        return cellKey(latitudeIndex(coordinate.latitude()), longitudeIndex(coordinate.longitude()));
+    }
+
+    int latitudeIndex(double latitude) const
+    {
+        const int count = int(std::ceil(180.0 / cellSize));
+        return qBound(0, int(std::floor((latitude + 90.0) / cellSize)), count - 1);
+    }
+
+    int longitudeIndex(double longitude) const
+    {
+        const int count = int(std::ceil(360.0 / cellSize));
+        return qBound(0, int(std::floor((longitude + 180.0) / cellSize)), count - 1);
+    }
+
+    template <typename Function>
+    void forEachCell(const Box &box, Function function) const
+    {
+        const int minLatitude = latitudeIndex(box.minLatitude);
+        const int maxLatitude = latitudeIndex(box.maxLatitude);
+        const auto forEachInRange = [&](int minLongitude, int maxLongitude) {
+            for (int i = minLatitude; i <= maxLatitude; ++i) {
+                for (int j = minLongitude; j <= maxLongitude; ++j)
+                    function(cellKey(i, j));
+            }
+        };
+
+        const int minLongitude = longitudeIndex(box.minLongitude);
+        const int maxLongitude = longitudeIndex(box.maxLongitude);
+        if (minLongitude <= maxLongitude) {
+            forEachInRange(minLongitude, maxLongitude);
+        } else {
+            forEachInRange(minLongitude, longitudeIndex(180.0));
+            forEachInRange(0, maxLongitude);
+        }
+    }
+
+    qsizetype cellCount(const Box &box) const
+    {
+        qsizetype count = 0;
+        const qsizetype latitudes = latitudeIndex(box.maxLatitude) - latitudeIndex(box.minLatitude) + 1;
+        const int minLongitude = longitudeIndex(box.minLongitude);
+        const int maxLongitude = longitudeIndex(box.maxLongitude);
+        if (minLongitude <= maxLongitude)
+            count = maxLongitude - minLongitude + 1;
+        else
+            count = longitudeIndex(180.0) - minLongitude + 1 + maxLongitude + 1;
+        return count * latitudes;
+    }
+
+    void add(int handle)
+    {
+        Entry &entry = entries[handle];
+        entry.wide = !entry.indexed || cellCount(entry.box) > MaxCellsPerEntry;
+        if (entry.wide) {
+            unindexed.append(handle);
+            return;
+        }
+        forEachCell(entry.box, [&](quint64 key) { cells[key].append(handle); });
+    }
+
+    void rebuild()
+    {
+        QList<double> sizes;
+        sizes.reserve(size);
+        for (const Entry &entry : std::as_const(entries)) {
+            if (entry.used && entry.indexed) {
+                sizes.append(qMax(entry.box.maxLatitude - entry.box.minLatitude,
+                                  longitudeSpan(entry.box)));
+            }
+        }
+        if (!sizes.isEmpty()) {
+            const auto median = sizes.begin() + sizes.size() / 2;
+            std::nth_element(sizes.begin(), median, sizes.end());
+            cellSize = qBound(MinCellSize, *median, MaxCellSize);
+        }
+
+        cells.clear();
+        unindexed.clear();
+        for (int handle = 0; handle < entries.size(); ++handle) {
+            if (entries.at(handle).used)
+                add(handle);
+        }
+        sizeAtRebuild = size;
+    }
+
+    QList<Entry> entries; // by handle
+    QHash<quint64, QList<int>> cells;
+    QList<int> unindexed;
+    double cellSize = 1.0;
+    qsizetype size = 0;
+    qsizetype sizeAtRebuild = 0;
+};
+
 class QGeoAreaMonitorPollingPrivate : public QObject
 {
     Q_OBJECT
@@ -54,32 +289,27 @@ public:
     {
         const std::lock_guard<QRecursiveMutex> locker(mutex);
 
-        activeMonitorAreas.insert(monitor.identifier(), monitor);
-        singleShotTrigger.remove(monitor.identifier());
+        insertMonitor(monitor, -1);
 
         checkStartStop();
-        setupNextExpiryTimeout();
     }
 
     void requestUpdate(const QGeoAreaMonitorInfo &monitor, int signalId)
     {
         const std::lock_guard<QRecursiveMutex> locker(mutex);
 
-        activeMonitorAreas.insert(monitor.identifier(), monitor);
-        singleShotTrigger.insert(monitor.identifier(), signalId);
+        insertMonitor(monitor, signalId);
 
         checkStartStop();
-        setupNextExpiryTimeout();
     }
 
     QGeoAreaMonitorInfo stopMonitoring(const QGeoAreaMonitorInfo &monitor)
     {
         const std::lock_guard<QRecursiveMutex> locker(mutex);
 
-        QGeoAreaMonitorInfo mon = activeMonitorAreas.take(monitor.identifier());
+        QGeoAreaMonitorInfo mon = takeMonitor(handles.value(monitor.identifier(), -1));
 
         checkStartStop();
-        setupNextExpiryTimeout();
 
         return mon;
     }
@@ -141,11 +371,17 @@ public:
         return source;
     }
 
-    MonitorTable activeMonitors() const
+    QList<QGeoAreaMonitorInfo> activeMonitors() const
     {
         const std::lock_guard<QRecursiveMutex> locker(mutex);
 
-        return activeMonitorAreas;
+        QList<QGeoAreaMonitorInfo> result;
+        result.reserve(handles.size());
+        for (const Monitor &monitor : monitors) {
+            if (monitor.info.isValid())
+                result.append(monitor.info);
+        }
+        return result;
     }
 
     void checkStartStop()
@@ -160,7 +396,7 @@ public:
             }
         }
 
-        if (signalsConnected && !activeMonitorAreas.isEmpty()) {
+        if (signalsConnected && !handles.isEmpty()) {
             if (source)
                 source->startUpdates();
             else
@@ -173,23 +409,84 @@ public:
     }
 
 private:
+    /*
+        The monitors are referred to by dense integer handles, which index
+        monitors, insideArea and the spatial index. The handles of stopped
+        monitors are reused.
+    */
+    struct Monitor
+    {
+        QGeoAreaMonitorInfo info; // invalid if the handle is unused
+        int singleShotSignal = -1; // the signal index passed to requestUpdate()
+        quint32 visited = 0; // the last position update it was tested in
+    };
+
+    void insertMonitor(const QGeoAreaMonitorInfo &monitor, int singleShotSignal)
+    {
+        const QString identifier = monitor.identifier();
+        int handle = handles.value(identifier, -1);
+        if (handle < 0) {
+            if (freeHandles.isEmpty()) {
+                handle = int(monitors.size());
+                monitors.emplace_back();
+                if (handle >= insideArea.size())
+                    insideArea.resize(qMax(2 * insideArea.size(), qsizetype(64)));
+            } else {
+                handle = freeHandles.takeLast();
+            }
+            handles.insert(identifier, handle);
+        } else if (insideArea.testBit(handle)) {
+            // The new area may be nowhere near the last position, but it
+            // still has to be tested to detect that we have left it.
+            changedInside.append(handle);
+        }
+
+        Monitor &slot = monitors[handle];
+        slot.info = monitor;
+        slot.singleShotSignal = singleShotSignal;
+        monitorIndex.insert(handle, monitor.area());
+
+        // Only rescan all monitors if the next one to expire has changed
+        if (handle == activeExpiry.second) {
+            setupNextExpiryTimeout();
+        } else if (monitor.expiration().isValid()
+                   && (!activeExpiry.first.isValid() || monitor.expiration() < activeExpiry.first)) {
+            activeExpiry.first = monitor.expiration();
+            activeExpiry.second = handle;
+            nextExpiryTimer->start(QDateTime::currentDateTime().msecsTo(activeExpiry.first));
+        }
+    }
+
+    QGeoAreaMonitorInfo takeMonitor(int handle)
+    {
+        if (handle < 0)
+            return QGeoAreaMonitorInfo();
+
+        Monitor &slot = monitors[handle];
+        const QGeoAreaMonitorInfo monitor = std::exchange(slot.info, QGeoAreaMonitorInfo());
+        slot.singleShotSignal = -1;
+        handles.remove(monitor.identifier());
+        freeHandles.append(handle);
+        insideArea.clearBit(handle);
+        monitorIndex.remove(handle);
+
+        if (handle == activeExpiry.second)
+            setupNextExpiryTimeout();
+        return monitor;
+    }
+
     void setupNextExpiryTimeout()
     {
         nextExpiryTimer->stop();
         activeExpiry.first = QDateTime();
-        activeExpiry.second = QString();
+        activeExpiry.second = -1;
 
-        const auto infos = activeMonitors();
-        for (const QGeoAreaMonitorInfo &info : infos) {
-            if (info.expiration().isValid()) {
-                if (!activeExpiry.first.isValid()) {
-                    activeExpiry.first = info.expiration();
-                    activeExpiry.second = info.identifier();
-                    continue;
-                }
-                if (info.expiration() < activeExpiry.first) {
+        for (qsizetype handle = 0; handle < monitors.size(); ++handle) {
+            const QGeoAreaMonitorInfo &info = monitors.at(handle).info;
+            if (info.isValid() && info.expiration().isValid()) {
+                if (!activeExpiry.first.isValid() || info.expiration() < activeExpiry.first) {
                     activeExpiry.first = info.expiration();
-                    activeExpiry.second = info.identifier();
+                    activeExpiry.second = int(handle);
                 }
             }
         }
@@ -200,16 +497,14 @@ private:
 
 
     //returns true if areaEntered should be emitted
-    bool processInsideArea(const QString &monitorIdent)
+    bool processInsideArea(int handle)
     {
-        if (!insideArea.contains(monitorIdent)) {
-            if (singleShotTrigger.value(monitorIdent, -1) == areaEnteredSignal().methodIndex()) {
+        if (!insideArea.testBit(handle)) {
+            if (monitors.at(handle).singleShotSignal == areaEnteredSignal().methodIndex()) {
                 //this is the finishing singleshot event
-                singleShotTrigger.remove(monitorIdent);
-                activeMonitorAreas.remove(monitorIdent);
-                setupNextExpiryTimeout();
+                takeMonitor(handle);
             } else {
-                insideArea.insert(monitorIdent);
+                insideArea.setBit(handle);
             }
             return true;
         }
@@ -218,16 +513,14 @@ private:
     }
 
     //returns true if areaExited should be emitted
-    bool processOutsideArea(const QString &monitorIdent)
+    bool processOutsideArea(int handle)
     {
-        if (insideArea.contains(monitorIdent)) {
-            if (singleShotTrigger.value(monitorIdent, -1) == areaExitedSignal().methodIndex()) {
+        if (insideArea.testBit(handle)) {
+            if (monitors.at(handle).singleShotSignal == areaExitedSignal().methodIndex()) {
                 //this is the finishing singleShot event
-                singleShotTrigger.remove(monitorIdent);
-                activeMonitorAreas.remove(monitorIdent);
-                setupNextExpiryTimeout();
+                takeMonitor(handle);
             } else {
-                insideArea.remove(monitorIdent);
+                insideArea.clearBit(handle);
             }
             return true;
         }
@@ -248,34 +541,79 @@ private Q_SLOTS:
          * Don't block timer firing even if monitorExpiredSignal is not connected.
          * This allows us to continue to remove the existing monitors as they expire.
          **/
-        const QGeoAreaMonitorInfo info = activeMonitorAreas.take(activeExpiry.second);
-        setupNextExpiryTimeout();
+        QGeoAreaMonitorInfo info;
+        {
+            const std::lock_guard<QRecursiveMutex> locker(mutex);
+            info = takeMonitor(activeExpiry.second);
+        }
         emit timeout(info);
 
     }
 
     void positionUpdated(const QGeoPositionInfo &info)
     {
-        const auto monInfos = activeMonitors();
-        for (const QGeoAreaMonitorInfo &monInfo : monInfos) {
-            const QString identifier = monInfo.identifier();
-            if (monInfo.area().contains(info.coordinate())) {
-                if (processInsideArea(identifier))
-                    emit areaEventDetected(monInfo, info, true);
-            } else {
-                if (processOutsideArea(identifier))
-                    emit areaEventDetected(monInfo, info, false);
+        const QGeoCoordinate coordinate = info.coordinate();
+
+        // The events are emitted after the lock is released, as the clients
+        // may start or stop monitors in response.
+        QVarLengthArray<std::pair<QGeoAreaMonitorInfo, bool>, 8> events;
+        {
+            const std::lock_guard<QRecursiveMutex> locker(mutex);
+
+            // Whether we are inside of an area is only known at the positions
+            // reported, so a monitor can only have been entered if its bounding
+            // box contains the current position, and only have been exited if
+            // it contains the previous one. Areas that were changed while we
+            // were inside of them are tested as well.
+            if (++visitGeneration == 0) {
+                for (Monitor &monitor : monitors)
+                    monitor.visited = 0;
+                visitGeneration = 1;
+            }
+            QVarLengthArray<int, 32> candidates;
+            const auto visit = [&](int handle) {
+                quint32 &visited = monitors[handle].visited;
+                if (visited != visitGeneration) {
+                    visited = visitGeneration;
+                    candidates.append(handle);
+                }
+            };
+            for (int handle : std::as_const(changedInside))
+                visit(handle);
+            changedInside.clear();
+            monitorIndex.forEachCandidate(lastCoordinate, coordinate, visit);
+            lastCoordinate = coordinate;
+
+            for (int handle : std::as_const(candidates)) {
+                const QGeoAreaMonitorInfo monInfo = monitors.at(handle).info;
+                if (!monInfo.isValid())
+                    continue;
+                if (monInfo.area().contains(coordinate)) {
+                    if (processInsideArea(handle))
+                        events.append({ monInfo, true });
+                } else {
+                    if (processOutsideArea(handle))
+                        events.append({ monInfo, false });
+                }
             }
         }
+
+        for (const auto &[monInfo, isEnteredEvent] : std::as_const(events))
+            emit areaEventDetected(monInfo, info, isEnteredEvent);
     }
 
 private:
-    QPair<QDateTime, QString> activeExpiry;
-    QHash<QString, int> singleShotTrigger;
+    QPair<QDateTime, int> activeExpiry = { QDateTime(), -1 };
     QTimer* nextExpiryTimer;
-    QSet<QString> insideArea;
 
-    MonitorTable activeMonitorAreas;
+    QList<Monitor> monitors; // by handle
+    QList<int> freeHandles;
+    QHash<QString, int> handles;
+    QBitArray insideArea; // by handle
+    QList<int> changedInside;
+    QGeoAreaMonitorPollingIndex monitorIndex;
+    QGeoCoordinate lastCoordinate;
+    quint32 visitGeneration = 0;
 
     QGeoPositionInfoSource* source = nullptr;
     QList<QGeoAreaMonitorPolling*> registeredClients;
@@ -392,7 +730,7 @@ bool QGeoAreaMonitorPolling::stopMonitoring(const QGeoAreaMonitorInfo &monitor)
 
 QList<QGeoAreaMonitorInfo> QGeoAreaMonitorPolling::activeMonitors() const
 {
-    return d->activeMonitors().values();
+    return d->activeMonitors();
 }
 
 QList<QGeoAreaMonitorInfo> QGeoAreaMonitorPolling::activeMonitors(const QGeoShape &region) const
@@ -401,7 +739,7 @@ QList<QGeoAreaMonitorInfo> QGeoAreaMonitorPolling::activeMonitors(const QGeoShap
     if (region.isEmpty())
         return results;
 
-    const MonitorTable list = d->activeMonitors();
+    const QList<QGeoAreaMonitorInfo> list = d->activeMonitors();
     for (const QGeoAreaMonitorInfo &monitor : list) {
         if (region.contains(monitor.area().center()))
             results.append(monitor);
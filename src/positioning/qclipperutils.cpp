@@ -4,15 +4,137 @@
 #include "qclipperutils_p.h"
 #include <clip2tri.h>
 
+#include <vector>
+
 QT_BEGIN_NAMESPACE
 
+/*
+    The edges of a polygon sorted into horizontal slabs, so that testing a
+    point only has to look at the edges overlapping its slab instead of all
+    of them. The result is the same as from PointInPolygon(), which decides
+    the result edge by edge, regardless of their order, and only ever looks
+    at edges whose vertical range includes the point.
+*/
+class QClipperSlabIndex
+{
+public:
+    void build(const Path &polygon);
+    int pointInPolygon(const IntPoint &pt, const Path &polygon) const;
+
+private:
+    qsizetype slabOf(cInt y) const
+    {
+        return qBound(qsizetype(0), qsizetype((y - m_minY) / m_slabHeight), m_slabCount - 1);
+    }
+
+    cInt m_minY = 0;
+    cInt m_maxY = 0;
+    cInt m_slabHeight = 1;
+    qsizetype m_slabCount = 0;
+    std::vector<quint32> m_slabStarts; // m_slabCount + 1 offsets into m_edges
+    std::vector<quint32> m_edges; // the index of the first vertex of each edge
+};
+
 class QClipperUtilsPrivate
 {
 public:
     c2t::clip2tri m_clipper;
     Path m_cachedPolygon;
+    // built by setPolygon() for large polygons, as pointInPolygon() is const
+    QClipperSlabIndex m_slabIndex;
 };
 
+// Below this, scanning all edges is as fast as the slab lookup
+static constexpr size_t kSlabIndexMinimumSize = 64;
+
+// The contribution of the edge from ip to ipNext to PointInPolygon(): -1 if
+// pt is on the edge, 1 if the edge is crossed by the ray from pt, 0 otherwise.
+static int edgeCrossing(const IntPoint &pt, const IntPoint &ip, const IntPoint &ipNext)
+{
+    if (ipNext.Y == pt.Y) {
+        if ((ipNext.X == pt.X) || (ip.Y == pt.Y && ((ipNext.X > pt.X) == (ip.X < pt.X))))
+            return -1;
+    }
+    if ((ip.Y < pt.Y) == (ipNext.Y < pt.Y))
+        return 0;
+    if (ip.X >= pt.X && ipNext.X > pt.X)
+        return 1;
+    if (ip.X < pt.X && ipNext.X <= pt.X)
+        return 0;
+
+    const double d = double(ip.X - pt.X) * double(ipNext.Y - pt.Y)
+            - double(ipNext.X - pt.X) * double(ip.Y - pt.Y);
+    if (!d)
+        return -1;
+    return (d > 0) == (ipNext.Y > ip.Y) ? 1 : 0;
+}
+
+void QClipperSlabIndex::build(const Path &polygon)
+{
+    const size_t count = polygon.size();
+    m_minY = m_maxY = polygon.front().Y;
+    for (const IntPoint &p : polygon) {
+        m_minY = qMin(m_minY, p.Y);
+        m_maxY = qMax(m_maxY, p.Y);
+    }
+
+    const auto forEachEdge = [&](auto function) {
+        for (size_t i = 0; i < count; ++i) {
+            const cInt y1 = polygon[i].Y;
+            const cInt y2 = polygon[i + 1 == count ? 0 : i + 1].Y;
+            function(slabOf(qMin(y1, y2)), slabOf(qMax(y1, y2)), quint32(i));
+        }
+    };
+
+    // About eight edges per slab for a polygon without long edges. Fewer
+    // slabs are used if long edges would be repeated in too many of them.
+    m_slabCount = qsizetype(qMax(count / 8, size_t(1)));
+    for (;;) {
+        m_slabHeight = (m_maxY - m_minY) / m_slabCount + 1;
+        size_t total = 0;
+        forEachEdge([&](qsizetype first, qsizetype last, quint32) {
+            total += size_t(last - first + 1);
+        });
+        if (total <= 16 * count || m_slabCount == 1)
+            break;
+        m_slabCount /= 2;
+    }
+
+    // count the edges of each slab, then store them
+    m_slabStarts.assign(m_slabCount + 1, 0);
+    forEachEdge([this](qsizetype first, qsizetype last, quint32) {
+        for (qsizetype slab = first; slab <= last; ++slab)
+            ++m_slabStarts[slab + 1];
+    });
+    for (qsizetype slab = 0; slab < m_slabCount; ++slab)
+        m_slabStarts[slab + 1] += m_slabStarts[slab];
+
+    m_edges.resize(m_slabStarts.back());
+    std::vector<quint32> next(m_slabStarts.begin(), m_slabStarts.end() - 1);
+    forEachEdge([&](qsizetype first, qsizetype last, quint32 edge) {
+        for (qsizetype slab = first; slab <= last; ++slab)
+            m_edges[next[slab]++] = edge;
+    });
+}
+
+int QClipperSlabIndex::pointInPolygon(const IntPoint &pt, const Path &polygon) const
+{
+    if (pt.Y < m_minY || pt.Y > m_maxY)
+        return 0;
+
+    const size_t count = polygon.size();
+    const qsizetype slab = slabOf(pt.Y);
+    int result = 0;
+    for (quint32 i = m_slabStarts[slab]; i < m_slabStarts[slab + 1]; ++i) {
+        const size_t edge = m_edges[i];
+        const int crossing = edgeCrossing(pt, polygon[edge], polygon[edge + 1 == count ? 0 : edge + 1]);
+        if (crossing < 0)
+            return -1;
+        result ^= crossing;
+    }
+    return result;
+}
+
 static const double kClipperScaleFactor = 281474976710656.0;  // 48 bits of precision
 static const double kClipperScaleFactorInv = 1.0 / kClipperScaleFactor;
 
@@ -108,13 +230,19 @@ QList<QList<QDoubleVector2D>> QClipperUtils::execute(QClipperUtils::Operation op
 void QClipperUtils::setPolygon(const QList<QDoubleVector2D> &polygon)
 {
     d_ptr->m_cachedPolygon = qListToPath(polygon);
+    d_ptr->m_slabIndex = QClipperSlabIndex();
+    if (d_ptr->m_cachedPolygon.size() >= kSlabIndexMinimumSize)
+        d_ptr->m_slabIndex.build(d_ptr->m_cachedPolygon);
 }
 
 int QClipperUtils::pointInPolygon(const QDoubleVector2D &point) const
 {
-    if (d_ptr->m_cachedPolygon.empty())
+    const Path &polygon = d_ptr->m_cachedPolygon;
+    if (polygon.empty())
         qWarning("No vertices are specified for the polygon!");
-    return c2t::clip2tri::pointInPolygon(toIntPoint(point), d_ptr->m_cachedPolygon);
+    if (polygon.size() < kSlabIndexMinimumSize)
+        return c2t::clip2tri::pointInPolygon(toIntPoint(point), polygon);
+    return d_ptr->m_slabIndex.pointInPolygon(toIntPoint(point), polygon);
 }
 
 QT_END_NAMESPACE
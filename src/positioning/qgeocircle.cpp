@@ -10,6 +10,7 @@
 
 #include "qdoublevector2d_p.h"
 #include "qdoublevector3d_p.h"
+#include <algorithm>
 #include <cmath>
 QT_BEGIN_NAMESPACE
 
@@ -185,6 +186,28 @@ bool QGeoCirclePrivate::contains(const QGeoCoordinate &coordinate) const
     return false;
 }
 
+void QGeoCirclePrivate::containsEach(QSpan<const QGeoCoordinate> coordinates,
+                                     QSpan<bool> results) const
+{
+    if (!isValid()) {
+        std::fill(results.begin(), results.end(), false);
+        return;
+    }
+
+    // A point further north or south than the radius (plus some slack for the
+    // fuzzy comparison in contains()) cannot be inside, whatever its longitude.
+    const double maxLatitudeDelta =
+            qRadiansToDegrees((m_radius * (1.0 + 1e-6) + 1.0) / QLocationUtils::earthMeanRadius());
+    const double centerLatitude = m_center.latitude();
+    for (qsizetype i = 0; i < coordinates.size(); ++i) {
+        const QGeoCoordinate &coordinate = coordinates[i];
+        if (qAbs(coordinate.latitude() - centerLatitude) > maxLatitudeDelta)
+            results[i] = false;
+        else
+            results[i] = QGeoCirclePrivate::contains(coordinate);
+    }
+}
+
 QGeoCoordinate QGeoCirclePrivate::center() const
 {
     return m_center;
@@ -31,6 +31,8 @@ public:
     bool isValid() const override;
     bool isEmpty() const override;
     bool contains(const QGeoCoordinate &coordinate) const override;
+    void containsEach(QSpan<const QGeoCoordinate> coordinates,
+                      QSpan<bool> results) const override;
 
     QGeoCoordinate center() const override;
 
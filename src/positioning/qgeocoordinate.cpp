@@ -3,6 +3,7 @@
 #include "qgeocoordinate.h"
 #include "qgeocoordinate_p.h"
 #include "qlocationutils_p.h"
+#include "qgeodistancekernels_p.h"
 
 #include <QDateTime>
 #include <QHash>
@@ -12,6 +13,8 @@
 #include <qnumeric.h>
 #include <qmath.h>
 
+#include <algorithm>
+
 QT_BEGIN_NAMESPACE
 
 QT_IMPL_METATYPE_EXTERN(QGeoCoordinate)
@@ -443,6 +446,131 @@ qreal QGeoCoordinate::azimuthTo(const QGeoCoordinate &other) const
     return qreal((int(whole + 360) % 360) + fraction);
 }
 
+// Passes the latitudes and longitudes of \a coordinates to \a kernel in
+// blocks, with invalid coordinates replaced by 0, and stores its results in
+// \a results. Result i is computed from coordinates i and i + overlap, and is
+// 0 if either of them is invalid.
+template <typename Kernel>
+static void qgeocoordinate_applyInBlocks(QSpan<const QGeoCoordinate> coordinates,
+                                         qsizetype overlap, QSpan<qreal> results,
+                                         Kernel kernel)
+{
+    constexpr qsizetype blockSize = 256;
+    double latitudes[blockSize + 1];
+    double longitudes[blockSize + 1];
+    bool valid[blockSize + 1];
+    double blockResults[blockSize];
+
+    for (qsizetype from = 0; from < results.size(); from += blockSize) {
+        const qsizetype count = qMin(blockSize, results.size() - from);
+        for (qsizetype i = 0; i < count + overlap; ++i) {
+            const QGeoCoordinatePrivate *d = QGeoCoordinatePrivate::get(&coordinates[from + i]);
+            valid[i] = QLocationUtils::isValidLat(d->lat) && QLocationUtils::isValidLong(d->lng);
+            latitudes[i] = valid[i] ? d->lat : 0.0;
+            longitudes[i] = valid[i] ? d->lng : 0.0;
+        }
+        kernel(latitudes, longitudes, blockResults, count);
+        for (qsizetype i = 0; i < count; ++i)
+            results[from + i] = valid[i] && valid[i + overlap] ? qreal(blockResults[i]) : qreal(0);
+    }
+}
+
+/*!
+    \since 6.9
+
+    Stores the distance (in meters) from this coordinate to each of the
+    \a others in the element of \a distances with the same index.
+    \a distances must have at least as many elements as \a others.
+
+    The distances are the same as those returned by distanceTo(), but are
+    computed several at a time, with polynomial approximations of the
+    trigonometric functions. They may therefore differ from the results of
+    distanceTo() by a relative error of up to 1e-12, except for coordinates
+    that are nearly antipodal to this one, where both lose precision.
+
+    \sa consecutiveDistances(), azimuthsTo()
+*/
+void QGeoCoordinate::distancesTo(QSpan<const QGeoCoordinate> others,
+                                 QSpan<qreal> distances) const
+{
+    Q_ASSERT(distances.size() >= others.size());
+    distances = distances.first(others.size());
+    if (type() == QGeoCoordinate::InvalidCoordinate) {
+        std::fill(distances.begin(), distances.end(), qreal(0));
+        return;
+    }
+
+    const double latitude = d->lat;
+    const double longitude = d->lng;
+    qgeocoordinate_applyInBlocks(others, 0, distances,
+            [latitude, longitude](const double *latitudes, const double *longitudes,
+                                  double *results, qsizetype count) {
+        QGeoDistanceKernels::distances(latitude, longitude, latitudes, longitudes,
+                                       results, count);
+    });
+}
+
+/*!
+    \since 6.9
+
+    Stores the azimuth (in degrees) from this coordinate to each of the
+    \a others in the element of \a azimuths with the same index.
+    \a azimuths must have at least as many elements as \a others.
+
+    The azimuths are the same as those returned by azimuthTo(), up to small
+    differences caused by the polynomial approximations they are computed
+    with. These are below 1e-9 degrees, except for coordinates very close to
+    or nearly antipodal to this one, where the azimuth is ill-conditioned.
+
+    \sa distancesTo()
+*/
+void QGeoCoordinate::azimuthsTo(QSpan<const QGeoCoordinate> others,
+                                QSpan<qreal> azimuths) const
+{
+    Q_ASSERT(azimuths.size() >= others.size());
+    azimuths = azimuths.first(others.size());
+    if (type() == QGeoCoordinate::InvalidCoordinate) {
+        std::fill(azimuths.begin(), azimuths.end(), qreal(0));
+        return;
+    }
+
+    const double latitude = d->lat;
+    const double longitude = d->lng;
+    qgeocoordinate_applyInBlocks(others, 0, azimuths,
+            [latitude, longitude](const double *latitudes, const double *longitudes,
+                                  double *results, qsizetype count) {
+        QGeoDistanceKernels::azimuths(latitude, longitude, latitudes, longitudes,
+                                      results, count);
+    });
+}
+
+/*!
+    \since 6.9
+
+    Stores the distance (in meters) from each of the \a coordinates to the
+    next one in \a distances, so that the first element of \a distances is
+    the distance from the first to the second coordinate. \a distances must
+    have at least one element less than \a coordinates. The sum of the
+    distances is the length of the path through the coordinates.
+
+    The distances are computed like those of distancesTo().
+
+    \sa distanceTo()
+*/
+void QGeoCoordinate::consecutiveDistances(QSpan<const QGeoCoordinate> coordinates,
+                                          QSpan<qreal> distances)
+{
+    if (coordinates.size() < 2)
+        return;
+
+    Q_ASSERT(distances.size() >= coordinates.size() - 1);
+    qgeocoordinate_applyInBlocks(coordinates, 1, distances.first(coordinates.size() - 1),
+            [](const double *latitudes, const double *longitudes,
+               double *results, qsizetype count) {
+        QGeoDistanceKernels::consecutiveDistances(latitudes, longitudes, results, count);
+    });
+}
+
 void QGeoCoordinatePrivate::atDistanceAndAzimuth(const QGeoCoordinate &coord,
                                                  qreal distance, qreal azimuth,
                                                  double *lon, double *lat)
@@ -651,14 +779,21 @@ QString QGeoCoordinate::toString(CoordinateFormat format) const
 
 bool QGeoCoordinate::equals(const QGeoCoordinate &lhs, const QGeoCoordinate &rhs)
 {
-    bool latEqual = (qIsNaN(lhs.d->lat) && qIsNaN(rhs.d->lat))
-                        || qFuzzyCompare(lhs.d->lat, rhs.d->lat);
-    bool lngEqual = (qIsNaN(lhs.d->lng) && qIsNaN(rhs.d->lng))
-                        || qFuzzyCompare(lhs.d->lng, rhs.d->lng);
-    bool altEqual = (qIsNaN(lhs.d->alt) && qIsNaN(rhs.d->alt))
-                        || qFuzzyCompare(lhs.d->alt, rhs.d->alt);
-
-    if (!qIsNaN(lhs.d->lat) && ((lhs.d->lat == 90.0) || (lhs.d->lat == -90.0)))
+    return QGeoCoordinatePrivate::equals(lhs.d->lat, lhs.d->lng, lhs.d->alt,
+                                         rhs.d->lat, rhs.d->lng, rhs.d->alt);
+}
+
+bool QGeoCoordinatePrivate::equals(double lat1, double lng1, double alt1,
+                                   double lat2, double lng2, double alt2)
+{
+    bool latEqual = (qIsNaN(lat1) && qIsNaN(lat2))
+                        || qFuzzyCompare(lat1, lat2);
+    bool lngEqual = (qIsNaN(lng1) && qIsNaN(lng2))
+                        || qFuzzyCompare(lng1, lng2);
+    bool altEqual = (qIsNaN(alt1) && qIsNaN(alt2))
+                        || qFuzzyCompare(alt1, alt2);
+
+    if (!qIsNaN(lat1) && ((lat1 == 90.0) || (lat1 == -90.0)))
         lngEqual = true;
 
     return (latEqual && lngEqual && altEqual);
@@ -744,13 +879,19 @@ QDataStream &QGeoCoordinate::dataStreamIn(QDataStream &stream, QGeoCoordinate &c
     Returns a hash value for \a coordinate, using \a seed to seed the calculation.
 */
 size_t qHash(const QGeoCoordinate &coordinate, size_t seed)
+{
+    return QGeoCoordinatePrivate::hash(coordinate.latitude(), coordinate.longitude(),
+                                       coordinate.altitude(), seed);
+}
+
+size_t QGeoCoordinatePrivate::hash(double lat, double lng, double alt, size_t seed)
 {
     QtPrivate::QHashCombine hash;
     // north and south pole are geographically equivalent (no matter the longitude)
-    if (coordinate.latitude() != 90.0 && coordinate.latitude() != -90.0)
-        seed = hash(seed, coordinate.longitude());
-    seed = hash(seed, coordinate.latitude());
-    seed = hash(seed, coordinate.altitude());
+    if (lat != 90.0 && lat != -90.0)
+        seed = hash(seed, lng);
+    seed = hash(seed, lat);
+    seed = hash(seed, alt);
     return seed;
 }
 
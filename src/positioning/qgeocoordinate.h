@@ -8,6 +8,7 @@
 #include <QtCore/QString>
 #include <QtCore/QSharedDataPointer>
 #include <QtCore/QDebug>
+#include <QtCore/qspan.h>
 #include <QtPositioning/qpositioningglobal.h>
 
 QT_BEGIN_NAMESPACE
@@ -81,6 +82,11 @@ public:
     Q_INVOKABLE qreal distanceTo(const QGeoCoordinate &other) const;
     Q_INVOKABLE qreal azimuthTo(const QGeoCoordinate &other) const;
 
+    void distancesTo(QSpan<const QGeoCoordinate> others, QSpan<qreal> distances) const;
+    void azimuthsTo(QSpan<const QGeoCoordinate> others, QSpan<qreal> azimuths) const;
+    static void consecutiveDistances(QSpan<const QGeoCoordinate> coordinates,
+                                     QSpan<qreal> distances);
+
     Q_INVOKABLE QGeoCoordinate atDistanceAndAzimuth(qreal distance, qreal azimuth, qreal distanceUp = 0.0) const;
 
     Q_INVOKABLE QString toString(CoordinateFormat format = DegreesMinutesSecondsWithHemisphere) const;
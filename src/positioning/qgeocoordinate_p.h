@@ -41,6 +41,11 @@ public:
     static const QGeoCoordinatePrivate *get(const QGeoCoordinate *c) {
            return c->d.constData();
     }
+
+    // QGeoCoordinate::equals() and qHash() on unpacked coordinates
+    static bool equals(double lat1, double lng1, double alt1,
+                       double lat2, double lng2, double alt2);
+    static size_t hash(double lat, double lng, double alt, size_t seed);
 };
 
 class Q_POSITIONING_EXPORT QGeoMercatorCoordinatePrivate : public QGeoCoordinatePrivate
@@ -0,0 +1,364 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+#include "qgeocoordinatebuffer.h"
+#include "qgeocoordinatebuffer_p.h"
+#include "qgeocoordinate_p.h"
+#include "qlocationutils_p.h"
+
+#include <QtCore/QHash>
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \class QGeoCoordinateBuffer
+    \inmodule QtPositioning
+    \ingroup QtPositioning-positioning
+    \since 6.9
+
+    \brief The QGeoCoordinateBuffer class stores a sequence of coordinates
+    in contiguous memory.
+
+    Where a QList<QGeoCoordinate> holds a separately allocated object per
+    coordinate, QGeoCoordinateBuffer keeps the latitudes, longitudes and
+    altitudes of all its coordinates in three arrays. This makes building,
+    copying and iterating over paths with many elements considerably cheaper.
+
+    The arrays can be accessed without copying through latitudes(),
+    longitudes() and altitudes(). The element at index \c i of the three
+    arrays together make up the coordinate returned by at(\c i).
+
+    QGeoPath and QGeoPolygon store their coordinates in a
+    QGeoCoordinateBuffer, and can be constructed from one without converting
+    it to a list.
+
+    \sa QGeoPath::pathBuffer(), QGeoPolygon::perimeterBuffer()
+*/
+
+void QGeoCoordinateBufferPrivate::translate(double degreesLatitude, double degreesLongitude)
+{
+    for (double &latitude : latitudes)
+        latitude += degreesLatitude;
+    for (double &longitude : longitudes)
+        longitude = QLocationUtils::wrapLong(longitude + degreesLongitude);
+}
+
+/*!
+    Constructs an empty buffer.
+*/
+QGeoCoordinateBuffer::QGeoCoordinateBuffer()
+    : d(new QGeoCoordinateBufferPrivate)
+{
+}
+
+/*!
+    Constructs a buffer holding the elements of \a coordinates.
+*/
+QGeoCoordinateBuffer::QGeoCoordinateBuffer(const QList<QGeoCoordinate> &coordinates)
+    : d(new QGeoCoordinateBufferPrivate)
+{
+    reserve(coordinates.size());
+    for (const QGeoCoordinate &coordinate : coordinates)
+        append(coordinate);
+}
+
+/*!
+    Constructs a buffer from the contents of \a other.
+*/
+QGeoCoordinateBuffer::QGeoCoordinateBuffer(const QGeoCoordinateBuffer &other)
+    : d(other.d)
+{
+}
+
+/*!
+    \fn QGeoCoordinateBuffer::QGeoCoordinateBuffer(QGeoCoordinateBuffer &&other)
+
+    Constructs a buffer by moving from \a other.
+
+    \note The moved-from QGeoCoordinateBuffer object can only be destroyed or
+    assigned to. The effect of calling other functions than the destructor
+    or one of the assignment operators is undefined.
+*/
+
+/*!
+    Destroys the buffer.
+*/
+QGeoCoordinateBuffer::~QGeoCoordinateBuffer()
+{
+}
+
+QT_DEFINE_QSDP_SPECIALIZATION_DTOR(QGeoCoordinateBufferPrivate)
+
+/*!
+    Assigns \a other to this buffer and returns a reference to this buffer.
+*/
+QGeoCoordinateBuffer &QGeoCoordinateBuffer::operator=(const QGeoCoordinateBuffer &other)
+{
+    d = other.d;
+    return *this;
+}
+
+/*!
+    \fn QGeoCoordinateBuffer &QGeoCoordinateBuffer::operator=(QGeoCoordinateBuffer &&other)
+
+    Move-assigns \a other to this buffer and returns a reference to this
+    buffer.
+
+    \note The moved-from QGeoCoordinateBuffer object can only be destroyed or
+    assigned to. The effect of calling other functions than the destructor
+    or one of the assignment operators is undefined.
+*/
+
+/*!
+    \fn void QGeoCoordinateBuffer::swap(QGeoCoordinateBuffer &other)
+
+    Swaps this buffer with \a other. This operation is very fast and never
+    fails.
+*/
+
+/*!
+    \fn bool QGeoCoordinateBuffer::operator==(const QGeoCoordinateBuffer &lhs, const QGeoCoordinateBuffer &rhs)
+
+    Returns \c true if \a lhs and \a rhs have the same size, and their
+    coordinates compare equal element by element, as with
+    QGeoCoordinate::operator==(); otherwise returns \c false.
+*/
+
+/*!
+    \fn bool QGeoCoordinateBuffer::operator!=(const QGeoCoordinateBuffer &lhs, const QGeoCoordinateBuffer &rhs)
+
+    Returns \c true if \a lhs and \a rhs differ in size or in any coordinate;
+    otherwise returns \c false.
+*/
+
+bool QGeoCoordinateBuffer::equals(const QGeoCoordinateBuffer &lhs, const QGeoCoordinateBuffer &rhs)
+{
+    if (lhs.d == rhs.d)
+        return true;
+    if (lhs.size() != rhs.size())
+        return false;
+    for (qsizetype i = 0; i < lhs.size(); ++i) {
+        if (!QGeoCoordinatePrivate::equals(lhs.d->latitudes.at(i), lhs.d->longitudes.at(i),
+                                           lhs.d->altitudes.at(i), rhs.d->latitudes.at(i),
+                                           rhs.d->longitudes.at(i), rhs.d->altitudes.at(i))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/*!
+    Returns the number of coordinates in the buffer.
+*/
+qsizetype QGeoCoordinateBuffer::size() const
+{
+    return d->latitudes.size();
+}
+
+/*!
+    Returns \c true if the buffer holds no coordinates.
+*/
+bool QGeoCoordinateBuffer::isEmpty() const
+{
+    return d->latitudes.isEmpty();
+}
+
+/*!
+    Allocates memory for at least \a size coordinates.
+*/
+void QGeoCoordinateBuffer::reserve(qsizetype size)
+{
+    d->latitudes.reserve(size);
+    d->longitudes.reserve(size);
+    d->altitudes.reserve(size);
+}
+
+/*!
+    Removes all coordinates from the buffer.
+*/
+void QGeoCoordinateBuffer::clear()
+{
+    d->latitudes.clear();
+    d->longitudes.clear();
+    d->altitudes.clear();
+}
+
+/*!
+    Returns the coordinate at position \a index.
+
+    \a index must be a valid index position in the buffer.
+*/
+QGeoCoordinate QGeoCoordinateBuffer::at(qsizetype index) const
+{
+    QGeoCoordinate coordinate;
+    coordinate.setLatitude(d->latitudes.at(index));
+    coordinate.setLongitude(d->longitudes.at(index));
+    coordinate.setAltitude(d->altitudes.at(index));
+    return coordinate;
+}
+
+/*!
+    Returns the index of the first coordinate that compares equal to
+    \a coordinate, or -1 if there is none.
+*/
+qsizetype QGeoCoordinateBuffer::indexOf(const QGeoCoordinate &coordinate) const
+{
+    const QGeoCoordinatePrivate *c = QGeoCoordinatePrivate::get(&coordinate);
+    for (qsizetype i = 0; i < size(); ++i) {
+        if (QGeoCoordinatePrivate::equals(d->latitudes.at(i), d->longitudes.at(i),
+                                          d->altitudes.at(i), c->lat, c->lng, c->alt)) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+/*!
+    Returns the index of the last coordinate that compares equal to
+    \a coordinate, or -1 if there is none.
+*/
+qsizetype QGeoCoordinateBuffer::lastIndexOf(const QGeoCoordinate &coordinate) const
+{
+    const QGeoCoordinatePrivate *c = QGeoCoordinatePrivate::get(&coordinate);
+    for (qsizetype i = size() - 1; i >= 0; --i) {
+        if (QGeoCoordinatePrivate::equals(d->latitudes.at(i), d->longitudes.at(i),
+                                          d->altitudes.at(i), c->lat, c->lng, c->alt)) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+/*!
+    Appends \a coordinate to the buffer.
+*/
+void QGeoCoordinateBuffer::append(const QGeoCoordinate &coordinate)
+{
+    const QGeoCoordinatePrivate *c = QGeoCoordinatePrivate::get(&coordinate);
+    d->latitudes.append(c->lat);
+    d->longitudes.append(c->lng);
+    d->altitudes.append(c->alt);
+}
+
+/*!
+    Appends the coordinate with the given \a latitude and \a longitude to
+    the buffer, without creating a QGeoCoordinate.
+
+    Unlike the QGeoCoordinate constructor, this function does not check the
+    values.
+*/
+void QGeoCoordinateBuffer::append(double latitude, double longitude)
+{
+    append(latitude, longitude, qQNaN());
+}
+
+/*!
+    Appends the coordinate with the given \a latitude, \a longitude and
+    \a altitude to the buffer, without creating a QGeoCoordinate.
+
+    Unlike the QGeoCoordinate constructor, this function does not check the
+    values.
+*/
+void QGeoCoordinateBuffer::append(double latitude, double longitude, double altitude)
+{
+    d->latitudes.append(latitude);
+    d->longitudes.append(longitude);
+    d->altitudes.append(altitude);
+}
+
+/*!
+    Inserts \a coordinate at position \a index, which must be in the range
+    from 0 to size().
+*/
+void QGeoCoordinateBuffer::insert(qsizetype index, const QGeoCoordinate &coordinate)
+{
+    const QGeoCoordinatePrivate *c = QGeoCoordinatePrivate::get(&coordinate);
+    d->latitudes.insert(index, c->lat);
+    d->longitudes.insert(index, c->lng);
+    d->altitudes.insert(index, c->alt);
+}
+
+/*!
+    Replaces the coordinate at position \a index with \a coordinate.
+    \a index must be a valid index position in the buffer.
+*/
+void QGeoCoordinateBuffer::replace(qsizetype index, const QGeoCoordinate &coordinate)
+{
+    const QGeoCoordinatePrivate *c = QGeoCoordinatePrivate::get(&coordinate);
+    d->latitudes[index] = c->lat;
+    d->longitudes[index] = c->lng;
+    d->altitudes[index] = c->alt;
+}
+
+/*!
+    Removes \a count coordinates starting at position \a index.
+*/
+void QGeoCoordinateBuffer::remove(qsizetype index, qsizetype count)
+{
+    d->latitudes.remove(index, count);
+    d->longitudes.remove(index, count);
+    d->altitudes.remove(index, count);
+}
+
+/*!
+    Returns the latitudes of all coordinates, in degrees.
+
+    The span refers to the data of the buffer. It is invalidated by any
+    modification of the buffer, or of a copy sharing its data.
+*/
+QSpan<const double> QGeoCoordinateBuffer::latitudes() const
+{
+    return d->latitudes;
+}
+
+/*!
+    Returns the longitudes of all coordinates, in degrees.
+
+    The span refers to the data of the buffer. It is invalidated by any
+    modification of the buffer, or of a copy sharing its data.
+*/
+QSpan<const double> QGeoCoordinateBuffer::longitudes() const
+{
+    return d->longitudes;
+}
+
+/*!
+    Returns the altitudes of all coordinates, in meters. Coordinates without
+    an altitude have the value NaN.
+
+    The span refers to the data of the buffer. It is invalidated by any
+    modification of the buffer, or of a copy sharing its data.
+*/
+QSpan<const double> QGeoCoordinateBuffer::altitudes() const
+{
+    return d->altitudes;
+}
+
+/*!
+    Returns the coordinates as a list.
+*/
+QList<QGeoCoordinate> QGeoCoordinateBuffer::toList() const
+{
+    QList<QGeoCoordinate> list;
+    list.reserve(size());
+    for (qsizetype i = 0; i < size(); ++i)
+        list.append(at(i));
+    return list;
+}
+
+/*! \fn size_t qHash(const QGeoCoordinateBuffer &buffer, size_t seed = 0)
+    \relates QGeoCoordinateBuffer
+
+    Returns a hash value for \a buffer, using \a seed to seed the calculation.
+*/
+size_t qHash(const QGeoCoordinateBuffer &buffer, size_t seed)
+{
+    const QGeoCoordinateBufferPrivate *d = QGeoCoordinateBufferPrivate::get(buffer);
+    QtPrivate::QHashCombine hash;
+    for (qsizetype i = 0; i < buffer.size(); ++i) {
+        seed = hash(seed, QGeoCoordinatePrivate::hash(d->latitudes.at(i), d->longitudes.at(i),
+                                                      d->altitudes.at(i), 0));
+    }
+    return seed;
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,75 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QGEOCOORDINATEBUFFER_H
+#define QGEOCOORDINATEBUFFER_H
+
+#include <QtCore/QList>
+#include <QtCore/QSharedDataPointer>
+#include <QtCore/qspan.h>
+#include <QtPositioning/qgeocoordinate.h>
+
+QT_BEGIN_NAMESPACE
+
+class QGeoCoordinateBufferPrivate;
+QT_DECLARE_QSDP_SPECIALIZATION_DTOR_WITH_EXPORT(QGeoCoordinateBufferPrivate, Q_POSITIONING_EXPORT)
+
+class Q_POSITIONING_EXPORT QGeoCoordinateBuffer
+{
+public:
+    QGeoCoordinateBuffer();
+    explicit QGeoCoordinateBuffer(const QList<QGeoCoordinate> &coordinates);
+    QGeoCoordinateBuffer(const QGeoCoordinateBuffer &other);
+    QGeoCoordinateBuffer(QGeoCoordinateBuffer &&other) noexcept = default;
+    ~QGeoCoordinateBuffer();
+
+    QGeoCoordinateBuffer &operator=(const QGeoCoordinateBuffer &other);
+    QT_MOVE_ASSIGNMENT_OPERATOR_IMPL_VIA_PURE_SWAP(QGeoCoordinateBuffer)
+
+    void swap(QGeoCoordinateBuffer &other) noexcept { d.swap(other.d); }
+
+    friend bool operator==(const QGeoCoordinateBuffer &lhs, const QGeoCoordinateBuffer &rhs)
+    {
+        return equals(lhs, rhs);
+    }
+    friend bool operator!=(const QGeoCoordinateBuffer &lhs, const QGeoCoordinateBuffer &rhs)
+    {
+        return !equals(lhs, rhs);
+    }
+
+    qsizetype size() const;
+    bool isEmpty() const;
+    void reserve(qsizetype size);
+    void clear();
+
+    QGeoCoordinate at(qsizetype index) const;
+    qsizetype indexOf(const QGeoCoordinate &coordinate) const;
+    qsizetype lastIndexOf(const QGeoCoordinate &coordinate) const;
+
+    void append(const QGeoCoordinate &coordinate);
+    void append(double latitude, double longitude);
+    void append(double latitude, double longitude, double altitude);
+    void insert(qsizetype index, const QGeoCoordinate &coordinate);
+    void replace(qsizetype index, const QGeoCoordinate &coordinate);
+    void remove(qsizetype index, qsizetype count = 1);
+
+    QSpan<const double> latitudes() const;
+    QSpan<const double> longitudes() const;
+    QSpan<const double> altitudes() const;
+
+    QList<QGeoCoordinate> toList() const;
+
+private:
+    static bool equals(const QGeoCoordinateBuffer &lhs, const QGeoCoordinateBuffer &rhs);
+
+    QSharedDataPointer<QGeoCoordinateBufferPrivate> d;
+    friend class QGeoCoordinateBufferPrivate;
+};
+
+Q_DECLARE_SHARED(QGeoCoordinateBuffer)
+
+Q_POSITIONING_EXPORT size_t qHash(const QGeoCoordinateBuffer &buffer, size_t seed = 0);
+
+QT_END_NAMESPACE
+
+#endif // QGEOCOORDINATEBUFFER_H
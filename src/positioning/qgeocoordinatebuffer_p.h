@@ -0,0 +1,47 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QGEOCOORDINATEBUFFER_P_H
+#define QGEOCOORDINATEBUFFER_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtPositioning/private/qpositioningglobal_p.h>
+#include <QtPositioning/qgeocoordinatebuffer.h>
+#include <QtCore/QSharedData>
+
+QT_BEGIN_NAMESPACE
+
+class Q_POSITIONING_EXPORT QGeoCoordinateBufferPrivate : public QSharedData
+{
+public:
+    // Shifts all coordinates; the latitudes must stay valid, the longitudes are wrapped
+    void translate(double degreesLatitude, double degreesLongitude);
+
+    static QGeoCoordinateBufferPrivate *get(QGeoCoordinateBuffer &buffer)
+    {
+        return buffer.d.data();
+    }
+    static const QGeoCoordinateBufferPrivate *get(const QGeoCoordinateBuffer &buffer)
+    {
+        return buffer.d.constData();
+    }
+
+    // parallel arrays, all of the same size
+    QList<double> latitudes;
+    QList<double> longitudes;
+    QList<double> altitudes;
+};
+
+QT_END_NAMESPACE
+
+#endif // QGEOCOORDINATEBUFFER_P_H
@@ -0,0 +1,423 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+#include "qgeodistancekernels_p.h"
+
+#include <QtCore/private/qsimd_p.h>
+
+#include <cmath>
+#include <iterator>
+
+QT_BEGIN_NAMESPACE
+
+// The kernels take AvxOps vectors by value until they are inlined into the
+// AVX function, which GCC warns about although they are never called so.
+QT_WARNING_DISABLE_GCC("-Wpsabi")
+
+// The same as qgeocoordinate_EARTH_MEAN_RADIUS, in kilometers
+static constexpr double qgeodistancekernels_earthMeanRadius = 6371.0072;
+
+static constexpr double qgeodistancekernels_pi = 3.141592653589793;
+static constexpr double qgeodistancekernels_piLow = 1.2246467991473532e-16; // pi - double(pi)
+static constexpr double qgeodistancekernels_degreesToRadians = qgeodistancekernels_pi / 180;
+static constexpr double qgeodistancekernels_radiansToDegrees = 180 / qgeodistancekernels_pi;
+
+namespace {
+
+// The operations the kernels below are written with, one lane at a time here,
+// and for a whole SSE2 or AVX register below.
+struct ScalarOps
+{
+    using Vector = double;
+    using Mask = bool;
+    static constexpr qsizetype Size = 1;
+
+    static Vector broadcast(double v) { return v; }
+    static Vector load(const double *p) { return *p; }
+    static void store(double *p, Vector v) { *p = v; }
+    static Vector add(Vector a, Vector b) { return a + b; }
+    static Vector sub(Vector a, Vector b) { return a - b; }
+    static Vector mul(Vector a, Vector b) { return a * b; }
+    static Vector div(Vector a, Vector b) { return a / b; }
+    static Vector sqrt(Vector a) { return std::sqrt(a); }
+    static Vector min(Vector a, Vector b) { return a < b ? a : b; }
+    static Vector max(Vector a, Vector b) { return a > b ? a : b; }
+    static Vector abs(Vector a) { return std::fabs(a); }
+    static Vector round(Vector a) { return std::nearbyint(a); }
+    static Mask lessThan(Vector a, Vector b) { return a < b; }
+    static Mask greaterThan(Vector a, Vector b) { return a > b; }
+    static Vector select(Mask m, Vector a, Vector b) { return m ? a : b; }
+};
+
+#ifdef __SSE2__
+struct Sse2Ops
+{
+    using Vector = __m128d;
+    using Mask = __m128d;
+    static constexpr qsizetype Size = 2;
+
+    static Vector broadcast(double v) { return _mm_set1_pd(v); }
+    static Vector load(const double *p) { return _mm_loadu_pd(p); }
+    static void store(double *p, Vector v) { _mm_storeu_pd(p, v); }
+    static Vector add(Vector a, Vector b) { return _mm_add_pd(a, b); }
+    static Vector sub(Vector a, Vector b) { return _mm_sub_pd(a, b); }
+    static Vector mul(Vector a, Vector b) { return _mm_mul_pd(a, b); }
+    static Vector div(Vector a, Vector b) { return _mm_div_pd(a, b); }
+    static Vector sqrt(Vector a) { return _mm_sqrt_pd(a); }
+    static Vector min(Vector a, Vector b) { return _mm_min_pd(a, b); }
+    static Vector max(Vector a, Vector b) { return _mm_max_pd(a, b); }
+    static Vector abs(Vector a) { return _mm_andnot_pd(_mm_set1_pd(-0.0), a); }
+    static Vector round(Vector a)
+    {
+        // rounds to nearest even like nearbyint(), for |a| < 2^51
+        const __m128d magic = _mm_set1_pd(6755399441055744.0); // 1.5 * 2^52
+        return _mm_sub_pd(_mm_add_pd(a, magic), magic);
+    }
+    static Mask lessThan(Vector a, Vector b) { return _mm_cmplt_pd(a, b); }
+    static Mask greaterThan(Vector a, Vector b) { return _mm_cmpgt_pd(a, b); }
+    static Vector select(Mask m, Vector a, Vector b)
+    {
+        return _mm_or_pd(_mm_and_pd(m, a), _mm_andnot_pd(m, b));
+    }
+};
+#endif
+
+#if defined(Q_PROCESSOR_X86) && QT_COMPILER_SUPPORTS_HERE(AVX)
+// Built for AVX also when the rest of the file is not, and only used when
+// qCpuHasFeature(AVX) says so. The kernels below are always inlined into
+// qgeodistancekernels_runAvx(), so they are compiled for AVX there too.
+struct AvxOps
+{
+    using Vector = __m256d;
+    using Mask = __m256d;
+    static constexpr qsizetype Size = 4;
+
+    static QT_FUNCTION_TARGET(AVX) Vector broadcast(double v) { return _mm256_set1_pd(v); }
+    static QT_FUNCTION_TARGET(AVX) Vector load(const double *p) { return _mm256_loadu_pd(p); }
+    static QT_FUNCTION_TARGET(AVX) void store(double *p, Vector v) { _mm256_storeu_pd(p, v); }
+    static QT_FUNCTION_TARGET(AVX) Vector add(Vector a, Vector b) { return _mm256_add_pd(a, b); }
+    static QT_FUNCTION_TARGET(AVX) Vector sub(Vector a, Vector b) { return _mm256_sub_pd(a, b); }
+    static QT_FUNCTION_TARGET(AVX) Vector mul(Vector a, Vector b) { return _mm256_mul_pd(a, b); }
+    static QT_FUNCTION_TARGET(AVX) Vector div(Vector a, Vector b) { return _mm256_div_pd(a, b); }
+    static QT_FUNCTION_TARGET(AVX) Vector sqrt(Vector a) { return _mm256_sqrt_pd(a); }
+    static QT_FUNCTION_TARGET(AVX) Vector min(Vector a, Vector b) { return _mm256_min_pd(a, b); }
+    static QT_FUNCTION_TARGET(AVX) Vector max(Vector a, Vector b) { return _mm256_max_pd(a, b); }
+    static QT_FUNCTION_TARGET(AVX) Vector abs(Vector a)
+    {
+        return _mm256_andnot_pd(_mm256_set1_pd(-0.0), a);
+    }
+    static QT_FUNCTION_TARGET(AVX) Vector round(Vector a)
+    {
+        return _mm256_round_pd(a, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    }
+    static QT_FUNCTION_TARGET(AVX) Mask lessThan(Vector a, Vector b)
+    {
+        return _mm256_cmp_pd(a, b, _CMP_LT_OQ);
+    }
+    static QT_FUNCTION_TARGET(AVX) Mask greaterThan(Vector a, Vector b)
+    {
+        return _mm256_cmp_pd(a, b, _CMP_GT_OQ);
+    }
+    static QT_FUNCTION_TARGET(AVX) Vector select(Mask m, Vector a, Vector b)
+    {
+        return _mm256_blendv_pd(b, a, m);
+    }
+};
+#endif
+
+} // unnamed namespace
+
+// Sine and cosine of \a x in [-pi/4, pi/4], from their Taylor series up to
+// x^19 and x^18. The first omitted terms are below 1e-19 in that range.
+template <typename Ops>
+static Q_ALWAYS_INLINE
+void qgeodistancekernels_sinCosQuarter(typename Ops::Vector x,
+                                       typename Ops::Vector *sine,
+                                       typename Ops::Vector *cosine)
+{
+    static constexpr double sineCoefficients[] = {
+        1.0, -1.0 / 6.0, 1.0 / 120.0, -1.0 / 5040.0, 1.0 / 362880.0, -1.0 / 39916800.0,
+        1.0 / 6227020800.0, -1.0 / 1307674368000.0, 1.0 / 355687428096000.0,
+        -1.0 / 121645100408832000.0
+    };
+    static constexpr double cosineCoefficients[] = {
+        1.0, -1.0 / 2.0, 1.0 / 24.0, -1.0 / 720.0, 1.0 / 40320.0, -1.0 / 3628800.0,
+        1.0 / 479001600.0, -1.0 / 87178291200.0, 1.0 / 20922789888000.0,
+        -1.0 / 6402373705728000.0
+    };
+    constexpr int degree = int(std::size(sineCoefficients)) - 1;
+
+    const typename Ops::Vector x2 = Ops::mul(x, x);
+    typename Ops::Vector s = Ops::broadcast(sineCoefficients[degree]);
+    typename Ops::Vector c = Ops::broadcast(cosineCoefficients[degree]);
+    for (int i = degree - 1; i >= 0; --i) {
+        s = Ops::add(Ops::mul(s, x2), Ops::broadcast(sineCoefficients[i]));
+        c = Ops::add(Ops::mul(c, x2), Ops::broadcast(cosineCoefficients[i]));
+    }
+    *sine = Ops::mul(s, x);
+    *cosine = c;
+}
+
+// Sine and cosine of \a x in [-pi/2, pi/2]. Above pi/4 they are computed from
+// pi/2 - |x|, which keeps the cosine of latitudes close to the poles as exact
+// as that of std::cos(), and its sign right.
+template <typename Ops>
+static Q_ALWAYS_INLINE
+void qgeodistancekernels_sinCos(typename Ops::Vector x,
+                                typename Ops::Vector *sine,
+                                typename Ops::Vector *cosine)
+{
+    using Vector = typename Ops::Vector;
+    constexpr double piOver2 = 1.5707963267948966;
+    constexpr double piOver2Low = 6.123233995736766e-17; // pi/2 - double(pi/2)
+
+    const Vector absX = Ops::abs(x);
+    const typename Ops::Mask complement = Ops::greaterThan(absX, Ops::broadcast(piOver2 / 2));
+    const Vector complementX = Ops::add(Ops::sub(Ops::broadcast(piOver2), absX),
+                                        Ops::broadcast(piOver2Low));
+    Vector s;
+    Vector c;
+    qgeodistancekernels_sinCosQuarter<Ops>(Ops::select(complement, complementX, x), &s, &c);
+
+    // sin(x) = sign(x) * cos(pi/2 - |x|) and cos(x) = sin(pi/2 - |x|)
+    const Vector signedC = Ops::select(Ops::lessThan(x, Ops::broadcast(0.0)),
+                                       Ops::sub(Ops::broadcast(0.0), c), c);
+    *sine = Ops::select(complement, signedC, s);
+    *cosine = Ops::select(complement, s, c);
+}
+
+// Returns x - k * pi, with the integer k chosen so that the result is in
+// [-pi/2, pi/2]. Its sine and cosine are those of \a x, up to their signs.
+template <typename Ops>
+static Q_ALWAYS_INLINE
+typename Ops::Vector qgeodistancekernels_reduceHalfTurns(typename Ops::Vector x)
+{
+    const typename Ops::Vector k =
+            Ops::round(Ops::mul(x, Ops::broadcast(1 / qgeodistancekernels_pi)));
+    x = Ops::sub(x, Ops::mul(k, Ops::broadcast(qgeodistancekernels_pi)));
+    return Ops::sub(x, Ops::mul(k, Ops::broadcast(qgeodistancekernels_piLow)));
+}
+
+// Arc tangent of \a t in [0, 1], with the rational approximation of Cephes'
+// atan() for |z| <= tan(pi/8).
+template <typename Ops>
+static Q_ALWAYS_INLINE
+typename Ops::Vector qgeodistancekernels_atanUnit(typename Ops::Vector t)
+{
+    using Vector = typename Ops::Vector;
+    static constexpr double p[] = {
+        -8.750608600031904122785e-1, -1.615753718733365076637e1, -7.500855792314704667340e1,
+        -1.228866684490136173410e2, -6.485021904942025371773e1
+    };
+    static constexpr double q[] = {
+        2.485846490142306297962e1, 1.650270098316988542046e2, 4.328810604912902668951e2,
+        4.853903996359136964868e2, 1.945506571482613964425e2
+    };
+    constexpr double tanPiOver8 = 0.41421356237309504880;
+    constexpr double piOver4 = 0.7853981633974483;
+    constexpr double piOver4Low = 3.061616997868383e-17; // pi/4 - double(pi/4)
+
+    const Vector zero = Ops::broadcast(0.0);
+    const Vector one = Ops::broadcast(1.0);
+
+    // atan(t) = pi/4 + atan((t - 1) / (t + 1))
+    const typename Ops::Mask large = Ops::greaterThan(t, Ops::broadcast(tanPiOver8));
+    const Vector z = Ops::select(large, Ops::div(Ops::sub(t, one), Ops::add(t, one)), t);
+    const Vector z2 = Ops::mul(z, z);
+
+    Vector numerator = Ops::broadcast(p[0]);
+    Vector denominator = Ops::add(z2, Ops::broadcast(q[0]));
+    for (int i = 1; i < int(std::size(p)); ++i) {
+        numerator = Ops::add(Ops::mul(numerator, z2), Ops::broadcast(p[i]));
+        denominator = Ops::add(Ops::mul(denominator, z2), Ops::broadcast(q[i]));
+    }
+    Vector result = Ops::add(z, Ops::mul(Ops::mul(z, z2), Ops::div(numerator, denominator)));
+    result = Ops::add(result, Ops::select(large, Ops::broadcast(piOver4Low), zero));
+    return Ops::add(Ops::select(large, Ops::broadcast(piOver4), zero), result);
+}
+
+template <typename Ops>
+static Q_ALWAYS_INLINE
+typename Ops::Vector qgeodistancekernels_atan2(typename Ops::Vector y,
+                                               typename Ops::Vector x)
+{
+    using Vector = typename Ops::Vector;
+    const Vector zero = Ops::broadcast(0.0);
+    const Vector absY = Ops::abs(y);
+    const Vector absX = Ops::abs(x);
+    const Vector larger = Ops::max(absY, absX);
+    // atan2(0, 0) is 0, as with std::atan2()
+    const Vector ratio = Ops::select(Ops::greaterThan(larger, zero),
+                                     Ops::div(Ops::min(absY, absX), larger), zero);
+
+    Vector angle = qgeodistancekernels_atanUnit<Ops>(ratio);
+    angle = Ops::select(Ops::greaterThan(absY, absX),
+                        Ops::sub(Ops::broadcast(qgeodistancekernels_pi / 2), angle), angle);
+    angle = Ops::select(Ops::lessThan(x, zero),
+                        Ops::sub(Ops::broadcast(qgeodistancekernels_pi), angle), angle);
+    return Ops::select(Ops::lessThan(y, zero), Ops::sub(zero, angle), angle);
+}
+
+// QGeoCoordinate::distanceTo()
+template <typename Ops>
+static Q_ALWAYS_INLINE
+typename Ops::Vector qgeodistancekernels_distance(typename Ops::Vector lat1,
+                                                  typename Ops::Vector lon1,
+                                                  typename Ops::Vector lat2,
+                                                  typename Ops::Vector lon2)
+{
+    using Vector = typename Ops::Vector;
+    const Vector degreesToRadians = Ops::broadcast(qgeodistancekernels_degreesToRadians);
+    const Vector half = Ops::broadcast(0.5);
+    const Vector one = Ops::broadcast(1.0);
+
+    // Haversine formula
+    const Vector dlat = Ops::mul(Ops::sub(lat2, lat1), degreesToRadians);
+    const Vector dlon = Ops::mul(Ops::sub(lon2, lon1), degreesToRadians);
+    Vector unused;
+    Vector sinHalfDlat;
+    qgeodistancekernels_sinCos<Ops>(Ops::mul(dlat, half), &sinHalfDlat, &unused);
+    // only the square is used, so the sign does not matter
+    Vector sinHalfDlon;
+    qgeodistancekernels_sinCos<Ops>(
+            qgeodistancekernels_reduceHalfTurns<Ops>(Ops::mul(dlon, half)), &sinHalfDlon, &unused);
+    Vector cosLat1;
+    Vector cosLat2;
+    qgeodistancekernels_sinCos<Ops>(Ops::mul(lat1, degreesToRadians), &unused, &cosLat1);
+    qgeodistancekernels_sinCos<Ops>(Ops::mul(lat2, degreesToRadians), &unused, &cosLat2);
+
+    Vector y = Ops::add(Ops::mul(sinHalfDlat, sinHalfDlat),
+                        Ops::mul(Ops::mul(cosLat1, cosLat2),
+                                 Ops::mul(sinHalfDlon, sinHalfDlon)));
+    // rounding can push antipodal points above 1
+    y = Ops::min(y, one);
+    // 2 * asin(sqrt(y))
+    const Vector x = Ops::mul(Ops::broadcast(2.0),
+                              qgeodistancekernels_atan2<Ops>(Ops::sqrt(y),
+                                                             Ops::sqrt(Ops::sub(one, y))));
+    return Ops::mul(Ops::mul(x, Ops::broadcast(qgeodistancekernels_earthMeanRadius)),
+                    Ops::broadcast(1000.0));
+}
+
+// QGeoCoordinate::azimuthTo()
+template <typename Ops>
+static Q_ALWAYS_INLINE
+typename Ops::Vector qgeodistancekernels_azimuth(typename Ops::Vector lat1,
+                                                 typename Ops::Vector lon1,
+                                                 typename Ops::Vector lat2,
+                                                 typename Ops::Vector lon2)
+{
+    using Vector = typename Ops::Vector;
+    const Vector degreesToRadians = Ops::broadcast(qgeodistancekernels_degreesToRadians);
+
+    // sin(dlon) and cos(dlon) from the half angle, whose sign cancels out
+    const Vector dlon = Ops::mul(Ops::sub(lon2, lon1), degreesToRadians);
+    Vector sinHalfDlon;
+    Vector cosHalfDlon;
+    qgeodistancekernels_sinCos<Ops>(
+            qgeodistancekernels_reduceHalfTurns<Ops>(Ops::mul(dlon, Ops::broadcast(0.5))),
+            &sinHalfDlon, &cosHalfDlon);
+    const Vector sinDlon = Ops::mul(Ops::broadcast(2.0), Ops::mul(sinHalfDlon, cosHalfDlon));
+    const Vector cosDlon = Ops::mul(Ops::sub(cosHalfDlon, sinHalfDlon),
+                                    Ops::add(cosHalfDlon, sinHalfDlon));
+
+    Vector sinLat1;
+    Vector cosLat1;
+    Vector sinLat2;
+    Vector cosLat2;
+    qgeodistancekernels_sinCos<Ops>(Ops::mul(lat1, degreesToRadians), &sinLat1, &cosLat1);
+    qgeodistancekernels_sinCos<Ops>(Ops::mul(lat2, degreesToRadians), &sinLat2, &cosLat2);
+
+    const Vector y = Ops::mul(sinDlon, cosLat2);
+    const Vector x = Ops::sub(Ops::mul(cosLat1, sinLat2),
+                              Ops::mul(Ops::mul(sinLat1, cosLat2), cosDlon));
+
+    const Vector fullTurn = Ops::broadcast(360.0);
+    const Vector azimuth = Ops::add(Ops::mul(qgeodistancekernels_atan2<Ops>(y, x),
+                                             Ops::broadcast(qgeodistancekernels_radiansToDegrees)),
+                                    fullTurn);
+    return Ops::select(Ops::lessThan(azimuth, fullTurn), azimuth, Ops::sub(azimuth, fullTurn));
+}
+
+namespace {
+enum class Kernel { Distance, Azimuth };
+}
+
+// Applies \a kernel from index \a from on, as long as whole vectors are left,
+// and returns the index of the rest. The first coordinate is the same for all
+// results if \a firstStep is 0, otherwise it advances with the second one.
+template <Kernel kernel, typename Ops>
+static Q_ALWAYS_INLINE
+qsizetype qgeodistancekernels_run(const double *lat1, const double *lon1,
+                                  qsizetype firstStep,
+                                  const double *lat2, const double *lon2,
+                                  double *results, qsizetype from, qsizetype count)
+{
+    using Vector = typename Ops::Vector;
+    for (; count - from >= Ops::Size; from += Ops::Size) {
+        const Vector a = firstStep ? Ops::load(lat1 + from) : Ops::broadcast(*lat1);
+        const Vector b = firstStep ? Ops::load(lon1 + from) : Ops::broadcast(*lon1);
+        const Vector c = Ops::load(lat2 + from);
+        const Vector d = Ops::load(lon2 + from);
+        if constexpr (kernel == Kernel::Distance)
+            Ops::store(results + from, qgeodistancekernels_distance<Ops>(a, b, c, d));
+        else
+            Ops::store(results + from, qgeodistancekernels_azimuth<Ops>(a, b, c, d));
+    }
+    return from;
+}
+
+#if defined(Q_PROCESSOR_X86) && QT_COMPILER_SUPPORTS_HERE(AVX)
+template <Kernel kernel>
+static QT_FUNCTION_TARGET(AVX)
+qsizetype qgeodistancekernels_runAvx(const double *lat1, const double *lon1, qsizetype firstStep,
+                                     const double *lat2, const double *lon2,
+                                     double *results, qsizetype count)
+{
+    return qgeodistancekernels_run<kernel, AvxOps>(lat1, lon1, firstStep, lat2, lon2, results, 0,
+                                                   count);
+}
+#endif
+
+template <Kernel kernel>
+static void qgeodistancekernels_forEach(const double *lat1, const double *lon1,
+                                        qsizetype firstStep,
+                                        const double *lat2, const double *lon2,
+                                        double *results, qsizetype count)
+{
+    qsizetype i = 0;
+#if defined(Q_PROCESSOR_X86) && QT_COMPILER_SUPPORTS_HERE(AVX)
+    if (qCpuHasFeature(AVX))
+        i = qgeodistancekernels_runAvx<kernel>(lat1, lon1, firstStep, lat2, lon2, results, count);
+#endif
+#ifdef __SSE2__
+    i = qgeodistancekernels_run<kernel, Sse2Ops>(lat1, lon1, firstStep, lat2, lon2, results, i,
+                                                 count);
+#endif
+    qgeodistancekernels_run<kernel, ScalarOps>(lat1, lon1, firstStep, lat2, lon2, results, i,
+                                               count);
+}
+
+void QGeoDistanceKernels::distances(double latitude, double longitude,
+                                    const double *latitudes, const double *longitudes,
+                                    double *results, qsizetype count)
+{
+    qgeodistancekernels_forEach<Kernel::Distance>(&latitude, &longitude, 0,
+                                                  latitudes, longitudes, results, count);
+}
+
+void QGeoDistanceKernels::azimuths(double latitude, double longitude,
+                                   const double *latitudes, const double *longitudes,
+                                   double *results, qsizetype count)
+{
+    qgeodistancekernels_forEach<Kernel::Azimuth>(&latitude, &longitude, 0,
+                                                 latitudes, longitudes, results, count);
+}
+
+void QGeoDistanceKernels::consecutiveDistances(const double *latitudes, const double *longitudes,
+                                               double *results, qsizetype count)
+{
+    qgeodistancekernels_forEach<Kernel::Distance>(latitudes, longitudes, 1,
+                                                  latitudes + 1, longitudes + 1, results, count);
+}
+
+QT_END_NAMESPACE
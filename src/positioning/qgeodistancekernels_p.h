@@ -0,0 +1,62 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+#ifndef QGEODISTANCEKERNELS_P_H
+#define QGEODISTANCEKERNELS_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtPositioning/private/qpositioningglobal_p.h>
+
+QT_BEGIN_NAMESPACE
+
+/*
+    Great-circle distances and azimuths for arrays of coordinates, computed
+    the same way as QGeoCoordinate::distanceTo() and azimuthTo(), but several
+    at a time with SSE2 or AVX where available. Instead of calling the libm
+    functions, sine, cosine and arc tangent are computed with polynomials.
+
+    The results differ from those of the scalar functions by less than
+    MaxDistanceError times the distance, or meters below a meter, and by less
+    than MaxAzimuthError degrees plus the angle under which MaxAzimuthOffset
+    meters appear at the distance. The latter covers close coordinates, whose
+    azimuth depends on the rounding of either implementation. Both bounds do
+    not hold within MinAntipodalDistance of antipodal coordinates, where the
+    haversine formula itself loses precision.
+
+    All latitudes and longitudes are in degrees and must be valid; the
+    callers handle invalid coordinates. Distances are in meters, azimuths in
+    degrees in the range [0, 360).
+*/
+class Q_POSITIONING_EXPORT QGeoDistanceKernels
+{
+public:
+    static constexpr double MaxDistanceError = 1e-12;
+    static constexpr double MaxAzimuthError = 1e-9;
+    static constexpr double MaxAzimuthOffset = 1e-7;
+    static constexpr double MinAntipodalDistance = 100000;
+
+    // from (latitude, longitude) to each of the count coordinates
+    static void distances(double latitude, double longitude,
+                          const double *latitudes, const double *longitudes,
+                          double *results, qsizetype count);
+    static void azimuths(double latitude, double longitude,
+                         const double *latitudes, const double *longitudes,
+                         double *results, qsizetype count);
+
+    // from coordinate i to coordinate i + 1, so count + 1 coordinates are read
+    static void consecutiveDistances(const double *latitudes, const double *longitudes,
+                                     double *results, qsizetype count);
+};
+
+QT_END_NAMESPACE
+
+#endif // QGEODISTANCEKERNELS_P_H
@@ -4,6 +4,8 @@
 #include "qgeopath.h"
 #include "qgeopolygon.h"
 #include "qgeopath_p.h"
+#include "qgeocoordinatebuffer_p.h"
+#include "qgeodistancekernels_p.h"
 
 #include "qgeocoordinate.h"
 #include "qnumeric.h"
@@ -12,6 +14,16 @@
 
 #include "qdoublevector2d_p.h"
 #include "qdoublevector3d_p.h"
+
+#include <QtCore/QMutex>
+#include <QtCore/QVarLengthArray>
+#include <QtCore/qmath.h>
+
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <numeric>
+
 QT_BEGIN_NAMESPACE
 
 QT_IMPL_METATYPE_EXTERN(QGeoPath)
@@ -85,6 +97,17 @@ QGeoPath::QGeoPath(const QList<QGeoCoordinate> &path, const qreal &width)
 {
 }
 
+/*!
+    \since 6.9
+
+    Constructs a new geo path from the coordinates in \a path, with the
+    given \a width. The coordinates are shared with \a path, not copied.
+*/
+QGeoPath::QGeoPath(const QGeoCoordinateBuffer &path, const qreal &width)
+:   QGeoShape(new QGeoPathPrivate(path, width))
+{
+}
+
 /*!
     Constructs a new geo path from the contents of \a other.
 */
@@ -128,6 +151,12 @@ void QGeoPath::setPath(const QList<QGeoCoordinate> &path)
 
 /*!
     Returns all the elements of the path.
+
+    The list is created from the coordinates of the path on the first call
+    after they were all set, translated or cleared, which takes time and
+    memory proportional to the size of the path. Adding, inserting, replacing
+    or removing single coordinates updates it instead. pathBuffer() does not
+    need the list.
 */
 const QList<QGeoCoordinate> &QGeoPath::path() const
 {
@@ -135,6 +164,34 @@ const QList<QGeoCoordinate> &QGeoPath::path() const
     return d->path();
 }
 
+/*!
+    \since 6.9
+
+    Sets all the elements of the path to the coordinates in \a path.
+
+    As with the list overload, the path is left unchanged if any of the
+    coordinates is invalid.
+*/
+void QGeoPath::setPath(const QGeoCoordinateBuffer &path)
+{
+    Q_D(QGeoPath);
+    return d->setPath(path);
+}
+
+/*!
+    \since 6.9
+
+    Returns all the elements of the path.
+
+    Unlike path(), this does not need to create a QGeoCoordinate per element,
+    and is therefore preferable for processing large paths.
+*/
+QGeoCoordinateBuffer QGeoPath::pathBuffer() const
+{
+    Q_D(const QGeoPath);
+    return d->pathBuffer();
+}
+
 /*!
     Clears the path.
 
@@ -225,6 +282,28 @@ QGeoPath QGeoPath::translated(double degreesLatitude, double degreesLongitude) c
     return result;
 }
 
+/*!
+    \since 6.9
+
+    Returns the centroid of the coordinates of the path on the sphere, the
+    direction of the sum of their unit vectors, ignoring their altitudes.
+    Unlike center(), which is the center of boundingGeoRectangle(), it
+    weighs every coordinate the same.
+
+    It is kept up to date as coordinates are added, so that calling it after
+    each addCoordinate() on a growing path takes constant time.
+
+    Returns an invalid coordinate if the path is empty, or if its
+    coordinates cancel each other out, as two antipodal ones do.
+
+    \sa center()
+*/
+QGeoCoordinate QGeoPath::centroid() const
+{
+    Q_D(const QGeoPath);
+    return d->centroid();
+}
+
 /*!
     Returns the length of the path, in meters, from the element \a indexFrom to the element \a indexTo.
     The length is intended to be the sum of the shortest distances for each pair of adjacent points.
@@ -232,6 +311,10 @@ QGeoPath QGeoPath::translated(double degreesLatitude, double degreesLongitude) c
     If \a indexTo is -1 (the default value), the length will be including the distance between last coordinate
     and the first (closed loop).
     To retrieve the length for the path, use 0 for \a indexFrom and \l QGeoPath::size() - 1 for \a indexTo.
+
+    The distances from the first element are computed once and then kept up to
+    date as elements are added, inserted, replaced or removed, so that the
+    length between any two elements takes constant time.
 */
 double QGeoPath::length(qsizetype indexFrom, qsizetype indexTo) const
 {
@@ -264,6 +347,29 @@ void QGeoPath::addCoordinate(const QGeoCoordinate &coordinate)
         qWarning() << kWarningString;
 }
 
+/*!
+    \since 6.9
+
+    Appends \a coordinate to the path, simplifying it as it grows: while the
+    elements appended by consecutive calls with the same \a tolerance stay
+    within \a tolerance meters of the segment from the element before them
+    to the last one, only that last one is kept, and replaced as new ones
+    come in.
+
+    This keeps the memory used by long recorded tracks bounded. Unlike
+    simplified(), each call takes constant time, but the result can have more
+    elements. Any other change to the path starts over from its last element.
+    If \a tolerance is not positive, \a coordinate is appended as by
+    addCoordinate().
+
+    \sa simplified()
+*/
+void QGeoPath::addCoordinateSimplified(const QGeoCoordinate &coordinate, double tolerance)
+{
+    Q_D(QGeoPath);
+    d->addCoordinateSimplified(coordinate, tolerance);
+}
+
 /*!
     Inserts \a coordinate at the specified \a index.
 */
@@ -300,6 +406,59 @@ bool QGeoPath::containsCoordinate(const QGeoCoordinate &coordinate) const
     return d->containsCoordinate(coordinate);
 }
 
+/*!
+    \since 6.9
+
+    Returns the point of the path that is closest to \a coordinate, or an
+    invalid coordinate if the path is empty or \a coordinate is invalid.
+    The distance of \a coordinate from the path is the distanceTo() of the
+    returned coordinate, which has no altitude.
+
+    The segments between the path elements are taken to be straight lines in
+    the Web Mercator projection, as contains() does for paths with a width.
+
+    If \a segmentIndex is not \nullptr, it is set to the index of the element
+    starting the segment holding the returned point, or to -1 if there is no
+    such point. When several segments are equally close, the first one is
+    chosen. If \a distanceAlongPath is not \nullptr, it is set to the length
+    of the path from its first element to the returned point.
+
+    On long paths the segments are indexed, so that the query does not have to
+    look at all of them.
+
+    \sa length(), contains()
+*/
+QGeoCoordinate QGeoPath::nearestCoordinate(const QGeoCoordinate &coordinate,
+                                           qsizetype *segmentIndex,
+                                           double *distanceAlongPath) const
+{
+    Q_D(const QGeoPath);
+    return d->nearestCoordinate(coordinate, segmentIndex, distanceAlongPath);
+}
+
+/*!
+    \since 6.9
+
+    Returns a copy of this path with as few elements as needed for no element
+    to be farther than \a tolerance meters from it. The first and the last
+    element are always kept, and the width is the same.
+
+    The elements are chosen with the Douglas-Peucker algorithm, measuring the
+    distances to the segments as straight lines in the Web Mercator projection,
+    like contains() does. If \a tolerance is not positive, the path is
+    returned unchanged.
+
+    This is useful to reduce the size of recorded tracks, which are usually
+    much denser than needed to display or process them.
+
+    \sa addCoordinateSimplified()
+*/
+QGeoPath QGeoPath::simplified(double tolerance) const
+{
+    Q_D(const QGeoPath);
+    return QGeoPath(d->simplifiedPath(tolerance), d->width());
+}
+
 /*!
     Removes the last occurrence of \a coordinate from the path.
 */
@@ -341,6 +500,247 @@ QString QGeoPath::toString() const
  *
 *******************************************************************************/
 
+// Below this, testing all segments is as fast as looking them up
+static constexpr qsizetype kSegmentIndexMinimumSize = 64;
+static constexpr qsizetype kSegmentIndexLeafSize = 4;
+
+static bool qgeopath_overlaps(const QGeoPathSegmentIndex::Box &box,
+                              const QGeoPathSegmentIndex::Box &window)
+{
+    if (box.minY > window.maxY || box.maxY < window.minY)
+        return false;
+    // the mercator x wraps around, and either range may be unbounded
+    for (double shift : { 0.0, -1.0, 1.0 }) {
+        if (box.minX <= window.maxX + shift && box.maxX >= window.minX + shift)
+            return true;
+    }
+    return false;
+}
+
+/*
+    Returns the mercator area holding every point within radius meters of
+    coordinate, as measured by distanceTo(). The haversine formula gives
+    hav(d) = hav(dLat) + cos(lat1) * cos(lat2) * hav(dLon), so the latitudes
+    differ by at most the angle d, and the longitudes by the dLon for which
+    the second term alone reaches hav(d).
+*/
+static QGeoPathSegmentIndex::Box qgeopath_searchWindow(const QGeoCoordinate &coordinate,
+                                                       double radius)
+{
+    // a little more, for the rounding of distanceTo() and the projection
+    constexpr double margin = 1e-12;
+    const double angle = (radius * (1 + 1e-6) + 1) / QLocationUtils::earthMeanRadius();
+    const double latitude = coordinate.latitude();
+    const double deltaLatitude = qRadiansToDegrees(angle);
+
+    QGeoPathSegmentIndex::Box window;
+    window.minY = QWebMercator::coordToMercator(qMin(latitude + deltaLatitude, 90.0), 0.0).y()
+            - margin;
+    window.maxY = QWebMercator::coordToMercator(qMax(latitude - deltaLatitude, -90.0), 0.0).y()
+            + margin;
+
+    const double absLatitude = qDegreesToRadians(qAbs(latitude));
+    double sinHalfDelta = 1;
+    if (absLatitude + angle < M_PI_2) {
+        sinHalfDelta = std::sin(angle / 2)
+                / std::sqrt(std::cos(absLatitude) * std::cos(absLatitude + angle));
+    }
+    const double halfWidth = sinHalfDelta < 1
+            ? std::asin(sinHalfDelta) * (1 + 1e-9) / M_PI + margin
+            : 1.0;
+    if (halfWidth < 0.5) {
+        const double x = QWebMercator::coordToMercator(coordinate).x();
+        window.minX = x - halfWidth;
+        window.maxX = x + halfWidth;
+    } else {
+        window.minX = -qInf();
+        window.maxX = qInf();
+    }
+    return window;
+}
+
+void QGeoPathSegmentIndex::build(const QList<QDoubleVector2D> &mercatorPath,
+                                 double leftBoundWrapped)
+{
+    // Points interpolated on a segment may round slightly out of its box
+    constexpr double margin = 1e-12;
+
+    const qsizetype count = mercatorPath.size() - 1;
+    std::vector<Box> boxes(count);
+    for (qsizetype i = 0; i < count; ++i) {
+        const QDoubleVector2D &a = mercatorPath.at(i);
+        const QDoubleVector2D &b = mercatorPath.at(i + 1);
+        Box &box = boxes[i];
+        box.minY = qMin(a.y(), b.y()) - margin;
+        box.maxY = qMax(a.y(), b.y()) + margin;
+        const double minX = qMin(a.x(), b.x());
+        const double maxX = qMax(a.x(), b.x());
+        if (maxX <= 1.0) {
+            box.minX = minX - margin;
+            box.maxX = maxX + margin;
+        } else if (minX > 1.0) { // wrapped back by lineContainsMercator()
+            box.minX = minX - leftBoundWrapped - margin;
+            box.maxX = maxX - leftBoundWrapped + margin;
+        } else {
+            box.minX = -qInf();
+            box.maxX = qInf();
+        }
+    }
+
+    m_segments.resize(count);
+    std::iota(m_segments.begin(), m_segments.end(), quint32(0));
+    m_nodes.clear();
+    m_nodes.reserve(2 * (count / kSegmentIndexLeafSize + 1));
+    buildNode(boxes, m_segments.data(), m_segments.data() + count);
+
+    m_segmentBoxes.resize(count);
+    for (qsizetype i = 0; i < count; ++i)
+        m_segmentBoxes[i] = boxes[m_segments[i]];
+}
+
+// Splits [first, last) at the median of the box centers along the longer axis
+quint32 QGeoPathSegmentIndex::buildNode(const std::vector<Box> &boxes,
+                                        quint32 *first, quint32 *last)
+{
+    const auto center = [&boxes](quint32 segment, bool alongX) {
+        const Box &box = boxes[segment];
+        if (!alongX)
+            return (box.minY + box.maxY) / 2;
+        return qIsFinite(box.minX) ? (box.minX + box.maxX) / 2 : 0.5;
+    };
+
+    Box box;
+    Box centers;
+    for (const quint32 *segment = first; segment != last; ++segment) {
+        const Box &segmentBox = boxes[*segment];
+        box.minX = qMin(box.minX, segmentBox.minX);
+        box.maxX = qMax(box.maxX, segmentBox.maxX);
+        box.minY = qMin(box.minY, segmentBox.minY);
+        box.maxY = qMax(box.maxY, segmentBox.maxY);
+        centers.minX = qMin(centers.minX, center(*segment, true));
+        centers.maxX = qMax(centers.maxX, center(*segment, true));
+        centers.minY = qMin(centers.minY, center(*segment, false));
+        centers.maxY = qMax(centers.maxY, center(*segment, false));
+    }
+
+    const quint32 index = quint32(m_nodes.size());
+    m_nodes.emplace_back();
+    m_nodes[index].box = box;
+    if (last - first <= kSegmentIndexLeafSize) {
+        m_nodes[index].start = quint32(first - m_segments.data());
+        m_nodes[index].count = quint32(last - first);
+        return index;
+    }
+
+    const bool alongX = centers.maxX - centers.minX > centers.maxY - centers.minY;
+    quint32 *middle = first + (last - first) / 2;
+    std::nth_element(first, middle, last, [&](quint32 lhs, quint32 rhs) {
+        return center(lhs, alongX) < center(rhs, alongX);
+    });
+    buildNode(boxes, first, middle); // at index + 1
+    const quint32 right = buildNode(boxes, middle, last);
+    m_nodes[index].start = right;
+    return index;
+}
+
+template <typename Function>
+bool QGeoPathSegmentIndex::findSegment(const Box &window, Function function) const
+{
+    if (m_nodes.empty())
+        return false;
+
+    QVarLengthArray<quint32, 64> stack;
+    stack.append(0);
+    while (!stack.isEmpty()) {
+        const quint32 index = stack.takeLast();
+        const Node &node = m_nodes[index];
+        if (!qgeopath_overlaps(node.box, window))
+            continue;
+        if (!node.count) {
+            stack.append(node.start);
+            stack.append(index + 1);
+            continue;
+        }
+        for (quint32 i = node.start; i < node.start + node.count; ++i) {
+            if (qgeopath_overlaps(m_segmentBoxes[i], window) && function(qsizetype(m_segments[i])))
+                return true;
+        }
+    }
+    return false;
+}
+
+template <typename LowerBound, typename Function>
+void QGeoPathSegmentIndex::findNearest(LowerBound lowerBound, Function function) const
+{
+    if (m_nodes.empty())
+        return;
+
+    struct Entry
+    {
+        quint32 index;
+        double bound;
+    };
+    QVarLengthArray<Entry, 64> stack;
+    stack.append({ 0, lowerBound(m_nodes.front().box) });
+    double best = qInf();
+    while (!stack.isEmpty()) {
+        const Entry entry = stack.takeLast();
+        if (entry.bound > best)
+            continue;
+        const Node &node = m_nodes[entry.index];
+        if (node.count) {
+            for (quint32 i = node.start; i < node.start + node.count; ++i) {
+                if (lowerBound(m_segmentBoxes[i]) <= best)
+                    best = function(qsizetype(m_segments[i]));
+            }
+            continue;
+        }
+        Entry nearer = { entry.index + 1, lowerBound(m_nodes[entry.index + 1].box) };
+        Entry farther = { node.start, lowerBound(m_nodes[node.start].box) };
+        if (farther.bound < nearer.bound)
+            std::swap(nearer, farther);
+        stack.append(farther);
+        stack.append(nearer);
+    }
+}
+
+/*
+    Returns a lower bound for the distanceTo() from coordinate, whose
+    projection is point, to the points in box, with the same haversine
+    inequality as qgeopath_searchWindow().
+*/
+static double qgeopath_minimumDistance(const QGeoCoordinate &coordinate,
+                                       const QDoubleVector2D &point,
+                                       const QGeoPathSegmentIndex::Box &box)
+{
+    const double maxLatitude = QWebMercator::mercatorToCoord(QDoubleVector2D(0.5, box.minY)).latitude();
+    const double minLatitude = QWebMercator::mercatorToCoord(QDoubleVector2D(0.5, box.maxY)).latitude();
+    const double latitude = coordinate.latitude();
+    const double deltaLatitude =
+            qDegreesToRadians(qMax(0.0, qMax(minLatitude - latitude, latitude - maxLatitude)));
+
+    double deltaX = 0.5;
+    for (double shift : { 0.0, -1.0, 1.0 }) {
+        const double minX = box.minX + shift;
+        const double maxX = box.maxX + shift;
+        deltaX = qMin(deltaX, qMax(0.0, qMax(minX - point.x(), point.x() - maxX)));
+    }
+    const double deltaLongitude = deltaX * 2 * M_PI;
+
+    const double cosLatitude = std::cos(qDegreesToRadians(latitude));
+    const double minCosLatitude =
+            std::cos(qDegreesToRadians(qMax(qAbs(minLatitude), qAbs(maxLatitude))));
+    const double sinHalfLatitude = std::sin(deltaLatitude / 2);
+    const double sinHalfLongitude = std::sin(deltaLongitude / 2);
+    const double haversine = qBound(0.0, sinHalfLatitude * sinHalfLatitude
+                                    + cosLatitude * minCosLatitude
+                                    * sinHalfLongitude * sinHalfLongitude, 1.0);
+
+    // a little less, for the rounding of distanceTo() and the projection
+    const double distance = 2 * std::asin(std::sqrt(haversine)) * QLocationUtils::earthMeanRadius();
+    return distance * (1 - 1e-9) - 1e-3;
+}
+
 QGeoPathPrivate::QGeoPathPrivate()
 :   QGeoShapePrivate(QGeoShape::PathType)
 {
@@ -354,6 +754,13 @@ QGeoPathPrivate::QGeoPathPrivate(const QList<QGeoCoordinate> &path, const qreal
     setWidth(width);
 }
 
+QGeoPathPrivate::QGeoPathPrivate(const QGeoCoordinateBuffer &path, const qreal width)
+:   QGeoShapePrivate(QGeoShape::PathType)
+{
+    setPath(path);
+    setWidth(width);
+}
+
 QGeoPathPrivate::~QGeoPathPrivate()
 {
 
@@ -371,7 +778,7 @@ bool QGeoPathPrivate::isValid() const
 
 bool QGeoPathPrivate::isEmpty() const
 {
-    return path().isEmpty(); // this should perhaps return geometric emptiness, less than 2 points for line, or empty polygon for polygons
+    return m_path.isEmpty(); // this should perhaps return geometric emptiness, less than 2 points for line, or empty polygon for polygons
 }
 
 QGeoCoordinate QGeoPathPrivate::center() const
@@ -379,6 +786,13 @@ QGeoCoordinate QGeoPathPrivate::center() const
     return boundingGeoRectangle().center();
 }
 
+QGeoCoordinate QGeoPathPrivate::centroid() const
+{
+    if (m_bboxDirty)
+        const_cast<QGeoPathPrivate &>(*this).computeBoundingBox();
+    return m_bounds.centroid();
+}
+
 bool QGeoPathPrivate::operator==(const QGeoShapePrivate &other) const
 {
     if (!QGeoShapePrivate::operator==(other))
@@ -390,12 +804,77 @@ bool QGeoPathPrivate::operator==(const QGeoShapePrivate &other) const
     return m_width == otherPath.m_width && m_path == otherPath.m_path;
 }
 
+// path(), mercatorPath() and cumulativeLengths() are const, so they may build
+// their caches for copies of a path sharing their data in several threads
+Q_CONSTINIT static QBasicMutex qgeopath_cacheMutex;
+
+/*
+    Returns the coordinates as a list, which is built from m_path on the first
+    call after setting or moving all coordinates only, and kept up to date by
+    the edits of single coordinates, see markCoordinatesChanged(). Code working
+    on all coordinates should use m_path instead.
+*/
 const QList<QGeoCoordinate> &QGeoPathPrivate::path() const
+{
+    if (m_pathListDirty.loadAcquire()) {
+        const QMutexLocker locker(&qgeopath_cacheMutex);
+        if (m_pathListDirty.loadRelaxed()) {
+            m_pathList = m_path.toList();
+            m_pathListDirty.storeRelease(0);
+        }
+    }
+    return m_pathList;
+}
+
+const QGeoCoordinateBuffer &QGeoPathPrivate::pathBuffer() const
 {
     return m_path;
 }
 
 bool QGeoPathPrivate::lineContains(const QGeoCoordinate &coordinate) const
+{
+    mercatorPath();
+    return lineContainsMercator(coordinate);
+}
+
+/*
+    Returns the path projected into mercator space, with the x values left of
+    the bounding box unwrapped the way lineContainsMercator() expects. The
+    projection, and for long paths an index of its segments, is cached until
+    the coordinates change.
+*/
+const QList<QDoubleVector2D> &QGeoPathPrivate::mercatorPath() const
+{
+    if (!m_mercatorPathDirty.loadAcquire())
+        return m_mercatorPath;
+
+    const QMutexLocker locker(&qgeopath_cacheMutex);
+    if (!m_mercatorPathDirty.loadRelaxed())
+        return m_mercatorPath;
+    // the bounding box is dirty only if the coordinates changed
+    if (m_bboxDirty)
+        const_cast<QGeoPathPrivate &>(*this).computeBoundingBox();
+
+    const QSpan<const double> latitudes = m_path.latitudes();
+    const QSpan<const double> longitudes = m_path.longitudes();
+    m_mercatorPath.clear();
+    m_mercatorPath.reserve(m_path.size());
+    for (qsizetype i = 0; i < m_path.size(); ++i) {
+        QDoubleVector2D crd = QWebMercator::coordToMercator(latitudes[i], longitudes[i]);
+        if (crd.x() < m_leftBoundWrapped)
+            crd.setX(crd.x() + m_leftBoundWrapped);  // unwrap X
+        m_mercatorPath.append(crd);
+    }
+
+    m_segmentIndex = QGeoPathSegmentIndex();
+    if (m_mercatorPath.size() >= kSegmentIndexMinimumSize)
+        m_segmentIndex.build(m_mercatorPath, m_leftBoundWrapped);
+    m_mercatorPathDirty.storeRelease(0);
+    return m_mercatorPath;
+}
+
+// lineContains() without the update of the cached projection
+bool QGeoPathPrivate::lineContainsMercator(const QGeoCoordinate &coordinate) const
 {
     // Unoptimized approach:
     // - consider each segment of the path
@@ -408,61 +887,559 @@ bool QGeoPathPrivate::lineContains(const QGeoCoordinate &coordinate) const
     // To keep wrapping into the equation:
     //   If the mercator x value of a coordinate of the line, or the coordinate parameter, is less
     // than mercator(m_bbox).x, add that to the conversion.
-
-    if (m_bboxDirty)
-        const_cast<QGeoPathPrivate &>(*this).computeBoundingBox();
+    //
+    // Long paths only consider the segments near coordinate, see qgeopath_searchWindow().
 
     double lineRadius = qMax(width() * 0.5, 0.2); // minimum radius: 20cm
 
     if (m_path.isEmpty())
         return false;
     else if (m_path.size() == 1)
-        return (m_path[0].distanceTo(coordinate) <= lineRadius);
+        return (m_path.at(0).distanceTo(coordinate) <= lineRadius);
 
     QDoubleVector2D p = QWebMercator::coordToMercator(coordinate);
     if (p.x() < m_leftBoundWrapped)
         p.setX(p.x() + m_leftBoundWrapped);  // unwrap X
 
-    QDoubleVector2D a;
-    QDoubleVector2D b;
-    if (!m_path.isEmpty()) {
-        a = QWebMercator::coordToMercator(m_path[0]);
-        if (a.x() < m_leftBoundWrapped)
-            a.setX(a.x() + m_leftBoundWrapped);  // unwrap X
+    const auto segmentContains = [&](qsizetype segment) {
+        if (m_mercatorPath.at(segment) == m_mercatorPath.at(segment + 1))
+            return false;
+
+        QGeoCoordinate closest = segmentCandidate(p, segment);
+
+        double distanceMeters = coordinate.distanceTo(closest);
+        return distanceMeters <= lineRadius;
+    };
+
+    // distanceTo() is 0 for invalid coordinates, which are thus near every segment
+    if (!m_segmentIndex.isEmpty() && coordinate.isValid()) {
+        if (m_segmentIndex.findSegment(qgeopath_searchWindow(coordinate, lineRadius),
+                                       segmentContains)) {
+            return true;
+        }
+    } else {
+        for (qsizetype i = 0; i + 1 < m_mercatorPath.size(); i++) {
+            if (segmentContains(i))
+                return true;
+        }
     }
-    for (qsizetype i = 1; i < m_path.size(); i++) {
-        b = QWebMercator::coordToMercator(m_path[i]);
-        if (b.x() < m_leftBoundWrapped)
-            b.setX(b.x() + m_leftBoundWrapped);  // unwrap X
-        if (b == a)
-            continue;
 
+    // Last check if the coordinate is on the left of leftBoundMercator, but close enough to
+    // m_path[0]
+    return (m_path.at(0).distanceTo(coordinate) <= lineRadius);
+}
+
+/*
+    Returns the point of the segment from vertex segment to segment + 1 that
+    is closest to point in the cached mercator projection, where the segment
+    is a straight line. point is the projection of a coordinate, unwrapped like
+    the path.
+*/
+QGeoCoordinate QGeoPathPrivate::segmentCandidate(const QDoubleVector2D &point,
+                                                 qsizetype segment) const
+{
+    const QDoubleVector2D &p = point;
+    const QDoubleVector2D &a = m_mercatorPath.at(segment);
+    const QDoubleVector2D &b = m_mercatorPath.at(segment + 1);
+
+    QDoubleVector2D candidate = ( (p-a).length() < (p-b).length() ) ? a : b;
+
+    if (b != a) {
         double u = ((p.x() - a.x()) * (b.x() - a.x()) + (p.y() - a.y()) * (b.y() - a.y()) ) / (b - a).lengthSquared();
         QDoubleVector2D intersection(a.x() + u * (b.x() - a.x()) , a.y() + u * (b.y() - a.y()) );
 
-        QDoubleVector2D candidate = ( (p-a).length() < (p-b).length() ) ? a : b;
-
         if (u > 0 && u < 1
             && (p-intersection).length() < (p-candidate).length()  ) // And it falls in the segment
                 candidate = intersection;
+    }
+
+    if (candidate.x() > 1.0)
+        candidate.setX(candidate.x() - m_leftBoundWrapped); // wrap X
+
+    return QWebMercator::mercatorToCoord(candidate);
+}
 
+// The distance from vertex index to vertex index + 1, as cumulativeLengths() measures it
+static double qgeopath_segmentLength(const QGeoCoordinateBuffer &path, qsizetype index)
+{
+    double length;
+    QGeoDistanceKernels::consecutiveDistances(path.latitudes().data() + index,
+                                              path.longitudes().data() + index, &length, 1);
+    return length;
+}
 
-        if (candidate.x() > 1.0)
-            candidate.setX(candidate.x() - m_leftBoundWrapped); // wrap X
+/*
+    Returns the length of the path from its first vertex to each vertex, for
+    length() to take differences of. Once built, it is kept up to date by
+    the edits of single coordinates, see markCoordinatesChanged().
+*/
+const QList<double> &QGeoPathPrivate::cumulativeLengths() const
+{
+    if (!m_cumulativeLengthsDirty.loadAcquire())
+        return m_cumulativeLengths;
+
+    const QMutexLocker locker(&qgeopath_cacheMutex);
+    if (!m_cumulativeLengthsDirty.loadRelaxed())
+        return m_cumulativeLengths;
+
+    const qsizetype count = m_path.size();
+    m_cumulativeLengths.resize(count);
+    if (count > 0) {
+        double *lengths = m_cumulativeLengths.data();
+        lengths[0] = 0.0;
+        QGeoDistanceKernels::consecutiveDistances(m_path.latitudes().data(),
+                                                  m_path.longitudes().data(),
+                                                  lengths + 1, count - 1);
+        for (qsizetype i = 1; i < count; ++i)
+            lengths[i] += lengths[i - 1];
+    }
+    m_cumulativeLengthsDirty.storeRelease(0);
+    return m_cumulativeLengths;
+}
 
-        QGeoCoordinate closest = QWebMercator::mercatorToCoord(candidate);
+/*
+    Returns the point of the path closest to coordinate, taking the segments
+    as lineContains() does, and the segment it is on. Long paths only look at
+    the segments whose boxes in the segment index can be closer than the
+    nearest point found so far.
+*/
+QGeoCoordinate QGeoPathPrivate::nearestCoordinate(const QGeoCoordinate &coordinate,
+                                                  qsizetype *segmentIndex,
+                                                  double *distanceAlongPath) const
+{
+    if (segmentIndex)
+        *segmentIndex = -1;
+    if (distanceAlongPath)
+        *distanceAlongPath = 0.0;
+    if (m_path.isEmpty() || !coordinate.isValid())
+        return QGeoCoordinate();
 
-        double distanceMeters = coordinate.distanceTo(closest);
-        if (distanceMeters <= lineRadius)
-            return true;
+    if (m_path.size() == 1) {
+        if (segmentIndex)
+            *segmentIndex = 0;
+        const QGeoCoordinate vertex = m_path.at(0);
+        return QGeoCoordinate(vertex.latitude(), vertex.longitude());
+    }
 
-        // swap
-        a = b;
+    mercatorPath();
+    QDoubleVector2D p = QWebMercator::coordToMercator(coordinate);
+    if (p.x() < m_leftBoundWrapped)
+        p.setX(p.x() + m_leftBoundWrapped);  // unwrap X
+
+    // The first of equally distant segments, as when testing all of them in order
+    QGeoCoordinate nearest;
+    qsizetype nearestSegment = -1;
+    double nearestDistance = qInf();
+    const auto visitSegment = [&](qsizetype segment) {
+        const QGeoCoordinate candidate = segmentCandidate(p, segment);
+        const double distance = coordinate.distanceTo(candidate);
+        if (distance < nearestDistance
+                || (distance == nearestDistance && segment < nearestSegment)) {
+            nearest = candidate;
+            nearestSegment = segment;
+            nearestDistance = distance;
+        }
+        return nearestDistance;
+    };
+
+    if (!m_segmentIndex.isEmpty()) {
+        const QDoubleVector2D projected = QWebMercator::coordToMercator(coordinate);
+        m_segmentIndex.findNearest([&](const QGeoPathSegmentIndex::Box &box) {
+            return qgeopath_minimumDistance(coordinate, projected, box);
+        }, visitSegment);
+    } else {
+        for (qsizetype i = 0; i + 1 < m_mercatorPath.size(); ++i)
+            visitSegment(i);
     }
 
-    // Last check if the coordinate is on the left of leftBoundMercator, but close enough to
-    // m_path[0]
-    return (m_path[0].distanceTo(coordinate) <= lineRadius);
+    if (segmentIndex)
+        *segmentIndex = nearestSegment;
+    if (distanceAlongPath) {
+        *distanceAlongPath = cumulativeLengths().at(nearestSegment)
+                + m_path.at(nearestSegment).distanceTo(nearest);
+    }
+    return QGeoCoordinate(nearest.latitude(), nearest.longitude());
+}
+
+// The length of a unit of the Web Mercator projection, in meters, at latitude
+static double qgeopath_metersPerUnit(double latitude)
+{
+    return 2 * M_PI * QLocationUtils::earthMeanRadius() * std::cos(qDegreesToRadians(latitude));
+}
+
+// The distance from p to the segment from a to b
+static double qgeopath_segmentDistance(const QDoubleVector2D &p, const QDoubleVector2D &a,
+                                       const QDoubleVector2D &b)
+{
+    const QDoubleVector2D ab = b - a;
+    const double lengthSquared = ab.lengthSquared();
+    const double u = lengthSquared > 0.0
+            ? qBound(0.0, QDoubleVector2D::dotProduct(p - a, ab) / lengthSquared, 1.0)
+            : 0.0;
+    return (p - (a + u * ab)).length();
+}
+
+namespace {
+
+/*
+    The convex hulls of the points of a path in blocks of BlockSize
+    consecutive points, and of the unions of neighboring blocks up a binary
+    tree, with the greatest scale of their points. The point of a range that
+    lies farthest in a direction is on the hulls of the O(log n) nodes that
+    cover the whole blocks in the range, where a binary search finds it.
+*/
+class QGeoPathHullTree
+{
+public:
+    static constexpr qsizetype BlockSize = 32;
+    using Directions = std::array<QDoubleVector2D, 4>;
+    using Indices = std::array<qsizetype, 4>;
+
+    QGeoPathHullTree(const QList<QDoubleVector2D> &points, const QList<double> &scales);
+
+    // The points of [first, last] farthest in each of the directions, and
+    // the greatest scale of the points in the range
+    void farthest(qsizetype first, qsizetype last, const Directions &directions,
+                  Indices *indices, double *maxScale) const;
+
+private:
+    struct Node
+    {
+        // The upper hull, then the lower one, both from left to right
+        qsizetype upper = 0;
+        qsizetype lower = 0;
+        qsizetype end = 0;
+        double maxScale = 0.0;
+    };
+
+    void buildHulls(Node *node, const quint32 *begin, const quint32 *end);
+    qsizetype extreme(const Node &node, const QDoubleVector2D &direction) const;
+
+    const QList<QDoubleVector2D> &m_points;
+    const QList<double> &m_scales;
+    QList<Node> m_nodes; // 1 is the root, the children of n are 2n and 2n + 1
+    QList<quint32> m_hulls;
+    qsizetype m_blockCount = 0;
+    qsizetype m_leafCount = 1; // the blocks are the nodes from m_leafCount on
+};
+
+QGeoPathHullTree::QGeoPathHullTree(const QList<QDoubleVector2D> &points,
+                                   const QList<double> &scales)
+    : m_points(points), m_scales(scales)
+{
+    const qsizetype count = points.size();
+    m_blockCount = (count + BlockSize - 1) / BlockSize;
+    while (m_leafCount < m_blockCount)
+        m_leafCount *= 2;
+    m_nodes.resize(2 * m_leafCount);
+
+    // The points of each node sorted by x, then y. Those of a node are
+    // merged from its children's, which are next to each other.
+    QList<quint32> sorted(count);
+    std::iota(sorted.begin(), sorted.end(), 0);
+    const auto lessThan = [&points](quint32 lhs, quint32 rhs) {
+        const QDoubleVector2D &a = points.at(lhs);
+        const QDoubleVector2D &b = points.at(rhs);
+        return a.x() < b.x() || (a.x() == b.x() && a.y() < b.y());
+    };
+    const auto blockBegin = [&](qsizetype node) {
+        while (node < m_leafCount)
+            node *= 2;
+        return qMin((node - m_leafCount) * BlockSize, count);
+    };
+    const auto blockEnd = [&](qsizetype node) {
+        while (node < m_leafCount)
+            node = 2 * node + 1;
+        return qMin((node - m_leafCount + 1) * BlockSize, count);
+    };
+    for (qsizetype i = 2 * m_leafCount - 1; i > 0; --i) {
+        quint32 *begin = sorted.data() + blockBegin(i);
+        quint32 *end = sorted.data() + blockEnd(i);
+        Node &node = m_nodes[i];
+        if (i >= m_leafCount) {
+            std::sort(begin, end, lessThan);
+            for (const quint32 *point = begin; point != end; ++point)
+                node.maxScale = qMax(node.maxScale, scales.at(*point));
+        } else {
+            std::inplace_merge(begin, sorted.data() + blockBegin(2 * i + 1), end, lessThan);
+            node.maxScale = qMax(m_nodes.at(2 * i).maxScale, m_nodes.at(2 * i + 1).maxScale);
+        }
+        buildHulls(&node, begin, end);
+    }
+}
+
+// Andrew's monotone chain, on the sorted points of a node
+void QGeoPathHullTree::buildHulls(Node *node, const quint32 *begin, const quint32 *end)
+{
+    // Positive if the last two points of the hulls and point turn left
+    const auto turn = [this](quint32 point) {
+        const QDoubleVector2D &a = m_points.at(m_hulls.at(m_hulls.size() - 2));
+        const QDoubleVector2D &b = m_points.at(m_hulls.constLast());
+        const QDoubleVector2D &c = m_points.at(point);
+        return (b.x() - a.x()) * (c.y() - a.y()) - (b.y() - a.y()) * (c.x() - a.x());
+    };
+
+    node->upper = m_hulls.size();
+    for (const quint32 *point = begin; point != end; ++point) {
+        while (m_hulls.size() - node->upper >= 2 && turn(*point) >= 0.0)
+            m_hulls.removeLast();
+        m_hulls.append(*point);
+    }
+    node->lower = m_hulls.size();
+    for (const quint32 *point = begin; point != end; ++point) {
+        while (m_hulls.size() - node->lower >= 2 && turn(*point) <= 0.0)
+            m_hulls.removeLast();
+        m_hulls.append(*point);
+    }
+    node->end = m_hulls.size();
+}
+
+/*
+    Returns the point of the node farthest in direction. It is on the upper
+    hull if direction points up, else on the lower one, where the projections
+    of the edges on direction go from positive to negative only once.
+*/
+qsizetype QGeoPathHullTree::extreme(const Node &node, const QDoubleVector2D &direction) const
+{
+    const bool up = direction.y() >= 0.0;
+    qsizetype low = up ? node.upper : node.lower;
+    qsizetype high = (up ? node.lower : node.end) - 1;
+    while (low < high) {
+        const qsizetype middle = low + (high - low) / 2;
+        const QDoubleVector2D edge =
+                m_points.at(m_hulls.at(middle + 1)) - m_points.at(m_hulls.at(middle));
+        if (QDoubleVector2D::dotProduct(edge, direction) > 0.0)
+            low = middle + 1;
+        else
+            high = middle;
+    }
+    return m_hulls.at(low);
+}
+
+void QGeoPathHullTree::farthest(qsizetype first, qsizetype last, const Directions &directions,
+                                Indices *indices, double *maxScale) const
+{
+    std::array<double, 4> projections;
+    projections.fill(-std::numeric_limits<double>::infinity());
+    *maxScale = 0.0;
+    const auto visitPoint = [&](qsizetype point, qsizetype direction) {
+        const double projection =
+                QDoubleVector2D::dotProduct(m_points.at(point), directions.at(direction));
+        if (projection > projections.at(direction)) {
+            projections[direction] = projection;
+            (*indices)[direction] = point;
+        }
+    };
+    const auto visitRange = [&](qsizetype begin, qsizetype end) {
+        for (qsizetype point = begin; point < end; ++point) {
+            for (qsizetype direction = 0; direction < 4; ++direction)
+                visitPoint(point, direction);
+            *maxScale = qMax(*maxScale, m_scales.at(point));
+        }
+    };
+    const auto visitNode = [&](qsizetype i) {
+        const Node &node = m_nodes.at(i);
+        for (qsizetype direction = 0; direction < 4; ++direction)
+            visitPoint(extreme(node, directions.at(direction)), direction);
+        *maxScale = qMax(*maxScale, node.maxScale);
+    };
+
+    // The whole blocks in the range; the last block may be shorter
+    const qsizetype count = m_points.size();
+    qsizetype firstBlock = (first + BlockSize - 1) / BlockSize;
+    qsizetype endBlock = last + 1 == count ? m_blockCount : (last + 1) / BlockSize;
+    if (firstBlock >= endBlock) {
+        visitRange(first, last + 1);
+        return;
+    }
+    visitRange(first, firstBlock * BlockSize);
+    visitRange(qMin(endBlock * BlockSize, count), last + 1);
+    for (firstBlock += m_leafCount, endBlock += m_leafCount; firstBlock < endBlock;
+         firstBlock /= 2, endBlock /= 2) {
+        if (firstBlock & 1)
+            visitNode(firstBlock++);
+        if (endBlock & 1)
+            visitNode(--endBlock);
+    }
+}
+
+} // namespace
+
+/*
+    Returns the coordinates kept by the Douglas-Peucker algorithm: a range
+    keeps its coordinate farthest from the segment between its ends if that
+    is farther than tolerance, and is split there. The distances are those in
+    the cached mercator projection, scaled to meters at each coordinate.
+
+    Rather than testing every coordinate of a long range, a bound on their
+    distances from the hulls of QGeoPathHullTree drops the range when it is
+    within tolerance, and otherwise the range is split at the farthest of the
+    few coordinates that bound it. This keeps the result within tolerance,
+    possibly with a few more coordinates than the plain algorithm, in
+    O(n log² n) rather than O(n²) when most ranges are split unevenly, like
+    on a zig-zag or a spiral track.
+*/
+QGeoCoordinateBuffer QGeoPathPrivate::simplifiedPath(double tolerance) const
+{
+    const qsizetype count = m_path.size();
+    if (count < 3 || !(tolerance > 0.0))
+        return m_path;
+
+    const QList<QDoubleVector2D> &points = mercatorPath();
+    const QSpan<const double> latitudes = m_path.latitudes();
+    QList<double> scales(count);
+    for (qsizetype i = 0; i < count; ++i)
+        scales[i] = qgeopath_metersPerUnit(latitudes[i]);
+
+    const QGeoPathHullTree hulls(points, scales);
+    QList<bool> keep(count, false);
+    keep.first() = keep.last() = true;
+    QVarLengthArray<std::pair<qsizetype, qsizetype>, 64> ranges;
+    ranges.append({ 0, count - 1 });
+    while (!ranges.isEmpty()) {
+        const auto [first, last] = ranges.takeLast();
+        const QDoubleVector2D &a = points.at(first);
+        const QDoubleVector2D &b = points.at(last);
+        qsizetype farthest = -1;
+        double farthestDistance = tolerance;
+        const auto visit = [&](qsizetype i) {
+            const double distance = qgeopath_segmentDistance(points.at(i), a, b) * scales.at(i);
+            if (distance > farthestDistance) {
+                farthest = i;
+                farthestDistance = distance;
+            }
+        };
+
+        const QDoubleVector2D along = b - a;
+        const double length = along.length();
+        if (last - first - 1 <= 2 * QGeoPathHullTree::BlockSize || length == 0.0) {
+            for (qsizetype i = first + 1; i < last; ++i)
+                visit(i);
+        } else {
+            // No point is farther from the segment than the farthest ones
+            // from its line and beyond its ends, at the greatest scale.
+            const QDoubleVector2D across(-along.y(), along.x());
+            QGeoPathHullTree::Indices extremes;
+            double maxScale = 0.0;
+            hulls.farthest(first + 1, last - 1, { across, -across, along, -along },
+                           &extremes, &maxScale);
+            const auto projection = [&](qsizetype i, const QDoubleVector2D &direction) {
+                return QDoubleVector2D::dotProduct(points.at(i) - a, direction) / length;
+            };
+            const double fromLine = qMax(projection(extremes[0], across),
+                                         projection(extremes[1], -across));
+            const double beyondEnds = qMax(projection(extremes[2], along) - length,
+                                           projection(extremes[3], -along));
+            if (std::hypot(fromLine, qMax(beyondEnds, 0.0)) * maxScale <= tolerance)
+                continue;
+            // The range is split at the farthest of the extremes even if it is
+            // within tolerance, as the points between them might not be.
+            farthestDistance = -1.0;
+            for (qsizetype i : extremes)
+                visit(i);
+        }
+        if (farthest < 0)
+            continue;
+        keep[farthest] = true;
+        ranges.append({ first, farthest });
+        ranges.append({ farthest, last });
+    }
+
+    const QSpan<const double> longitudes = m_path.longitudes();
+    const QSpan<const double> altitudes = m_path.altitudes();
+    QGeoCoordinateBuffer simplified;
+    simplified.reserve(std::count(keep.cbegin(), keep.cend(), true));
+    for (qsizetype i = 0; i < count; ++i) {
+        if (keep.at(i))
+            simplified.append(latitudes[i], longitudes[i], altitudes[i]);
+    }
+    return simplified;
+}
+
+// The vector from one coordinate to another in meters, in the Web Mercator
+// projection scaled at the first one
+static QDoubleVector2D qgeopath_localVector(const QGeoCoordinate &from, const QGeoCoordinate &to)
+{
+    const QDoubleVector2D a = QWebMercator::coordToMercator(from);
+    const QDoubleVector2D b = QWebMercator::coordToMercator(to);
+    double dx = b.x() - a.x();
+    dx -= std::round(dx); // the short way around
+    return QDoubleVector2D(dx, b.y() - a.y()) * qgeopath_metersPerUnit(from.latitude());
+}
+
+/*
+    Appends coordinate, or replaces the last coordinate with it when the last
+    one and the ones it replaced before stay within tolerance of the segment
+    from the last but one coordinate to the new one. That is the case when
+    the new coordinate is at least as far from the last but one as the last
+    one, in a direction within the intersection of their cones: the directions
+    in which each of them is within tolerance of the line.
+
+    The bounds without the last coordinate are kept, so that replacing it
+    only adds the new one to them, without going through all coordinates.
+*/
+void QGeoPathPrivate::addCoordinateSimplified(const QGeoCoordinate &coordinate, double tolerance)
+{
+    if (!coordinate.isValid())
+        return;
+
+    if (m_path.size() >= 2 && tolerance > 0.0 && tolerance == m_streamTolerance) {
+        const QDoubleVector2D vector = qgeopath_localVector(m_path.at(m_path.size() - 2),
+                                                            coordinate);
+        const double radius = vector.length();
+        // the direction, turned to be within a turn after the start of the cone
+        const double angle = m_streamMinAngle
+                + std::fmod(std::fmod(std::atan2(vector.y(), vector.x()) - m_streamMinAngle,
+                                      2 * M_PI) + 2 * M_PI, 2 * M_PI);
+        // the cone of a single coordinate is at most half a turn wide
+        const bool fullCone = m_streamMaxAngle - m_streamMinAngle > M_PI;
+        if (radius >= m_streamMaxRadius && (fullCone || angle <= m_streamMaxAngle)) {
+            double minAngle = m_streamMinAngle;
+            double maxAngle = m_streamMaxAngle;
+            if (radius > tolerance) {
+                const double halfWidth = std::asin(tolerance / radius);
+                if (fullCone) {
+                    minAngle = angle - halfWidth;
+                    maxAngle = angle + halfWidth;
+                } else {
+                    minAngle = qMax(minAngle, angle - halfWidth);
+                    maxAngle = qMin(maxAngle, angle + halfWidth);
+                }
+            }
+            const qsizetype last = m_path.size() - 1;
+            m_path.replace(last, coordinate);
+            markCoordinatesChanged(last, 1, 1);
+            if (m_streamBoundsValid && !m_bboxDirty) {
+                m_bounds = m_streamBounds;
+                updateBoundingBox();
+            } else {
+                m_streamBoundsValid = false;
+                markDirty();
+            }
+            m_streamTolerance = tolerance;
+            m_streamMinAngle = minAngle;
+            m_streamMaxAngle = maxAngle;
+            m_streamMaxRadius = radius;
+            return;
+        }
+    }
+
+    const QGeoCoordinate anchor = m_path.isEmpty() ? QGeoCoordinate() : m_path.at(m_path.size() - 1);
+    m_streamBounds = m_bounds;
+    m_streamBoundsValid = !m_bboxDirty;
+    addCoordinate(coordinate);
+    if (!anchor.isValid() || !(tolerance > 0.0))
+        return;
+
+    // a new run, from the formerly last coordinate
+    const QDoubleVector2D vector = qgeopath_localVector(anchor, coordinate);
+    const double radius = vector.length();
+    const double angle = std::atan2(vector.y(), vector.x());
+    const double halfWidth = radius > tolerance ? std::asin(tolerance / radius) : M_PI;
+    m_streamTolerance = tolerance;
+    m_streamMinAngle = angle - halfWidth;
+    m_streamMaxAngle = angle + halfWidth;
+    m_streamMaxRadius = radius;
 }
 
 bool QGeoPathPrivate::contains(const QGeoCoordinate &coordinate) const
@@ -470,6 +1447,15 @@ bool QGeoPathPrivate::contains(const QGeoCoordinate &coordinate) const
     return lineContains(coordinate);
 }
 
+void QGeoPathPrivate::containsEach(QSpan<const QGeoCoordinate> coordinates,
+                                   QSpan<bool> results) const
+{
+    // the path is projected once for all coordinates
+    mercatorPath();
+    for (qsizetype i = 0; i < coordinates.size(); ++i)
+        results[i] = lineContainsMercator(coordinates[i]);
+}
+
 qreal QGeoPathPrivate::width() const
 {
     return m_width;
@@ -484,19 +1470,21 @@ void QGeoPathPrivate::setWidth(const qreal &width)
 
 double QGeoPathPrivate::length(qsizetype indexFrom, qsizetype indexTo) const
 {
-    if (path().isEmpty())
+    if (m_path.isEmpty())
         return 0.0;
 
     bool wrap = indexTo == -1;
-    if (indexTo < 0 || indexTo >= path().size())
-        indexTo = path().size() - 1;
+    if (indexTo < 0 || indexTo >= m_path.size())
+        indexTo = m_path.size() - 1;
     double len = 0.0;
     // TODO: consider calculating the length of the actual rhumb line segments
     // instead of the shortest path from A to B.
-    for (qsizetype i = indexFrom; i < indexTo; i++)
-        len += m_path[i].distanceTo(m_path[i+1]);
+    if (indexFrom < indexTo) {
+        const QList<double> &lengths = cumulativeLengths();
+        len = lengths.at(indexTo) - lengths.at(indexFrom);
+    }
     if (wrap)
-        len += m_path.last().distanceTo(m_path.first());
+        len += m_path.at(m_path.size() - 1).distanceTo(m_path.at(0));
     return len;
 }
 
@@ -521,19 +1509,16 @@ bool QGeoPathPrivate::containsCoordinate(const QGeoCoordinate &coordinate) const
 void QGeoPathPrivate::translate(double degreesLatitude, double degreesLongitude)
 {
     // Need min/maxLati, so update bbox
-    QList<double> m_deltaXs;
-    double m_minX, m_maxX, m_minLati, m_maxLati;
-    m_bboxDirty = false;
-    computeBBox(m_path, m_deltaXs, m_minX, m_maxX, m_minLati, m_maxLati, m_bbox);
+    if (m_bboxDirty)
+        computeBoundingBox();
 
     if (degreesLatitude > 0.0)
-        degreesLatitude = qMin(degreesLatitude, 90.0 - m_maxLati);
+        degreesLatitude = qMin(degreesLatitude, 90.0 - m_bounds.maxLatitude());
     else
-        degreesLatitude = qMax(degreesLatitude, -90.0 - m_minLati);
-    for (QGeoCoordinate &p: m_path) {
-        p.setLatitude(p.latitude() + degreesLatitude);
-        p.setLongitude(QLocationUtils::wrapLong(p.longitude() + degreesLongitude));
-    }
+        degreesLatitude = qMax(degreesLatitude, -90.0 - m_bounds.minLatitude());
+    QGeoCoordinateBufferPrivate::get(m_path)->translate(degreesLatitude, degreesLongitude);
+    markCoordinatesChanged();
+    m_bounds.translate(degreesLatitude, degreesLongitude);
     m_bbox.translate(degreesLatitude, degreesLongitude);
     m_leftBoundWrapped = QWebMercator::coordToMercator(m_bbox.topLeft()).x();
 }
@@ -547,7 +1532,7 @@ QGeoRectangle QGeoPathPrivate::boundingGeoRectangle() const
 
 size_t QGeoPathPrivate::hash(size_t seed) const
 {
-    const size_t res = qHashRange(m_path.cbegin(), m_path.cend(), seed);
+    const size_t res = qHash(m_path, seed);
     return qHashMulti(seed, res, m_width);
 }
 
@@ -556,13 +1541,30 @@ void QGeoPathPrivate::setPath(const QList<QGeoCoordinate> &path)
     for (const QGeoCoordinate &c: path)
         if (!c.isValid())
             return;
+    const QList<QGeoCoordinate> list = path; // path may be m_pathList itself
+    m_path = QGeoCoordinateBuffer(list);
+    markCoordinatesChanged();
+    m_pathList = list;
+    m_pathListDirty.storeRelaxed(0);
+    markDirty();
+}
+
+void QGeoPathPrivate::setPath(const QGeoCoordinateBuffer &path)
+{
+    const QSpan<const double> latitudes = path.latitudes();
+    const QSpan<const double> longitudes = path.longitudes();
+    for (qsizetype i = 0; i < path.size(); ++i)
+        if (!QLocationUtils::isValidLat(latitudes[i]) || !QLocationUtils::isValidLong(longitudes[i]))
+            return;
     m_path = path;
+    markCoordinatesChanged();
     markDirty();
 }
 
 void QGeoPathPrivate::clearPath()
 {
     m_path.clear();
+    markCoordinatesChanged();
     markDirty();
 }
 
@@ -571,7 +1573,8 @@ void QGeoPathPrivate::addCoordinate(const QGeoCoordinate &coordinate)
     if (!coordinate.isValid())
         return;
     m_path.append(coordinate);
-    markDirty();
+    markCoordinatesChanged(m_path.size() - 1, 0, 1);
+    updateBoundingBox();
 }
 
 void QGeoPathPrivate::insertCoordinate(qsizetype index, const QGeoCoordinate &coordinate)
@@ -579,6 +1582,7 @@ void QGeoPathPrivate::insertCoordinate(qsizetype index, const QGeoCoordinate &co
     if (index < 0 || index > m_path.size() || !coordinate.isValid())
         return;
     m_path.insert(index, coordinate);
+    markCoordinatesChanged(index, 0, 1);
     markDirty();
 }
 
@@ -586,7 +1590,8 @@ void QGeoPathPrivate::replaceCoordinate(qsizetype index, const QGeoCoordinate &c
 {
     if (index < 0 || index >= m_path.size() || !coordinate.isValid())
         return;
-    m_path[index] = coordinate;
+    m_path.replace(index, coordinate);
+    markCoordinatesChanged(index, 1, 1);
     markDirty();
 }
 
@@ -600,7 +1605,8 @@ void QGeoPathPrivate::removeCoordinate(qsizetype index)
 {
     if (index < 0 || index >= m_path.size())
         return;
-    m_path.removeAt(index);
+    m_path.remove(index);
+    markCoordinatesChanged(index, 1, 0);
     markDirty();
 }
 
@@ -609,25 +1615,101 @@ void QGeoPathPrivate::markDirty()
     m_bboxDirty = true;
 }
 
+// drops what is cached from the coordinates, other than the bounding box
+void QGeoPathPrivate::markCoordinatesChanged()
+{
+    m_pathList.clear();
+    m_pathListDirty.storeRelaxed(1);
+    m_mercatorPathDirty.storeRelaxed(1);
+    m_cumulativeLengthsDirty.storeRelaxed(1);
+    m_streamTolerance = qQNaN();
+}
+
+/*
+    Like markCoordinatesChanged(), after removed coordinates at index were
+    replaced by inserted ones, but keeps the list of coordinates and the
+    cumulative lengths if they are built. The list is edited the same way as
+    m_path. Only the segments next to the change are measured again, and the
+    lengths after them are shifted by the difference.
+*/
+void QGeoPathPrivate::markCoordinatesChanged(qsizetype index, qsizetype removed,
+                                             qsizetype inserted)
+{
+    const bool listDirty = m_pathListDirty.loadRelaxed();
+    const bool lengthsDirty = m_cumulativeLengthsDirty.loadRelaxed();
+    QList<QGeoCoordinate> list;
+    list.swap(m_pathList);
+    markCoordinatesChanged();
+
+    if (!listDirty) {
+        const qsizetype replaced = qMin(removed, inserted);
+        for (qsizetype i = index; i < index + replaced; ++i)
+            list[i] = m_path.at(i);
+        list.remove(index + replaced, removed - replaced);
+        for (qsizetype i = index + replaced; i < index + inserted; ++i)
+            list.insert(i, m_path.at(i));
+        Q_ASSERT(list.size() == m_path.size());
+        m_pathList.swap(list);
+        m_pathListDirty.storeRelaxed(0);
+    }
+
+    if (lengthsDirty)
+        return;
+
+    QList<double> &lengths = m_cumulativeLengths;
+    lengths.remove(index, removed);
+    lengths.insert(index, inserted, 0.0);
+    Q_ASSERT(lengths.size() == m_path.size());
+
+    const qsizetype next = index + inserted; // the first coordinate after the change
+    const qsizetype end = qMin(next + 1, lengths.size());
+    const double previousNext = next < lengths.size() ? lengths.at(next) : 0.0;
+    for (qsizetype i = index; i < end; ++i)
+        lengths[i] = i > 0 ? lengths.at(i - 1) + qgeopath_segmentLength(m_path, i - 1) : 0.0;
+    if (next < lengths.size()) {
+        const double delta = lengths.at(next) - previousNext;
+        for (qsizetype i = next + 1; i < lengths.size(); ++i)
+            lengths[i] += delta;
+    }
+    m_cumulativeLengthsDirty.storeRelaxed(0);
+}
+
 void QGeoPathPrivate::computeBoundingBox()
 {
-    QList<double> m_deltaXs;
-    double m_minX, m_maxX, m_minLati, m_maxLati;
     m_bboxDirty = false;
-    computeBBox(m_path, m_deltaXs, m_minX, m_maxX, m_minLati, m_maxLati, m_bbox);
+    m_bounds.clear();
+    m_bounds.addAll(m_path);
+    m_bbox = m_bounds.boundingBox();
+    m_leftBoundWrapped = QWebMercator::coordToMercator(m_bbox.topLeft()).x();
+}
+
+// Adds the last coordinate to the bounding box, unless it is to be computed anyway
+void QGeoPathPrivate::updateBoundingBox()
+{
+    if (m_bboxDirty || m_path.isEmpty())
+        return;
+    const qsizetype last = m_path.size() - 1;
+    m_bounds.add(m_path.latitudes()[last], m_path.longitudes()[last]);
+    m_bbox = m_bounds.boundingBox();
     m_leftBoundWrapped = QWebMercator::coordToMercator(m_bbox.topLeft()).x();
 }
 
 QGeoPathPrivateEager::QGeoPathPrivateEager()
 :   QGeoPathPrivate()
 {
-    m_bboxDirty = false; // never dirty on the eager version
+    computeBoundingBox(); // never dirty on the eager version
 }
 
 QGeoPathPrivateEager::QGeoPathPrivateEager(const QList<QGeoCoordinate> &path, const qreal width)
 :   QGeoPathPrivate(path, width)
 {
-    m_bboxDirty = false; // never dirty on the eager version
+    computeBoundingBox(); // never dirty on the eager version
+}
+
+QGeoPathPrivateEager::QGeoPathPrivateEager(const QGeoCoordinateBuffer &path, const qreal width)
+:   QGeoPathPrivate(path, width)
+{
+    computeBoundingBox(); // never dirty on the eager version
 }
 
 QGeoPathPrivateEager::~QGeoPathPrivateEager()
@@ -645,43 +1727,6 @@ void QGeoPathPrivateEager::markDirty()
     computeBoundingBox();
 }
 
-void QGeoPathPrivateEager::translate(double degreesLatitude, double degreesLongitude)
-{
-    if (degreesLatitude > 0.0)
-        degreesLatitude = qMin(degreesLatitude, 90.0 - m_maxLati);
-    else
-        degreesLatitude = qMax(degreesLatitude, -90.0 - m_minLati);
-    for (QGeoCoordinate &p: m_path) {
-        p.setLatitude(p.latitude() + degreesLatitude);
-        p.setLongitude(QLocationUtils::wrapLong(p.longitude() + degreesLongitude));
-    }
-    m_bbox.translate(degreesLatitude, degreesLongitude);
-    m_minLati += degreesLatitude;
-    m_maxLati += degreesLatitude;
-    m_leftBoundWrapped = QWebMercator::coordToMercator(m_bbox.topLeft()).x();
-}
-
-void QGeoPathPrivateEager::addCoordinate(const QGeoCoordinate &coordinate)
-{
-    if (!coordinate.isValid())
-        return;
-    m_path.append(coordinate);
-    //m_clipperDirty = true; // clipper not used in polylines
-    updateBoundingBox();
-}
-
-void QGeoPathPrivateEager::QGeoPathPrivateEager::computeBoundingBox()
-{
-    computeBBox(m_path, m_deltaXs, m_minX, m_maxX, m_minLati, m_maxLati, m_bbox);
-    m_leftBoundWrapped = QWebMercator::coordToMercator(m_bbox.topLeft()).x();
-}
-
-void QGeoPathPrivateEager::QGeoPathPrivateEager::updateBoundingBox()
-{
-    updateBBox(m_path, m_deltaXs, m_minX, m_maxX, m_minLati, m_maxLati, m_bbox);
-    m_leftBoundWrapped = QWebMercator::coordToMercator(m_bbox.topLeft()).x();
-}
-
 QGeoPathEager::QGeoPathEager() : QGeoPath()
 {
     d_ptr = new QGeoPathPrivateEager;
@@ -695,7 +1740,7 @@ QGeoPathEager::QGeoPathEager(const QList<QGeoCoordinate> &path, const qreal &wid
 QGeoPathEager::QGeoPathEager(const QGeoPath &other) : QGeoPath()
 {
     d_ptr = new QGeoPathPrivateEager;
-    setPath(other.path());
+    setPath(other.pathBuffer());
     setWidth(other.width());
 }
 
@@ -5,6 +5,7 @@
 #define QGEOPATH_H
 
 #include <QtPositioning/QGeoShape>
+#include <QtPositioning/qgeocoordinatebuffer.h>
 #include <QtCore/QVariantList>
 
 QT_BEGIN_NAMESPACE
@@ -21,6 +22,7 @@ class Q_POSITIONING_EXPORT QGeoPath : public QGeoShape
 public:
     QGeoPath();
     QGeoPath(const QList<QGeoCoordinate> &path, const qreal &width = 0.0);
+    explicit QGeoPath(const QGeoCoordinateBuffer &path, const qreal &width = 0.0);
     QGeoPath(const QGeoPath &other);
     QGeoPath(const QGeoShape &other);
 
@@ -30,6 +32,8 @@ public:
 
     void setPath(const QList<QGeoCoordinate> &path);
     const QList<QGeoCoordinate> &path() const;
+    void setPath(const QGeoCoordinateBuffer &path);
+    QGeoCoordinateBuffer pathBuffer() const;
     void clearPath();
     void setVariantPath(const QVariantList &path);
     QVariantList variantPath() const;
@@ -41,11 +45,17 @@ public:
     Q_INVOKABLE QGeoPath translated(double degreesLatitude, double degreesLongitude) const;
     Q_INVOKABLE double length(qsizetype indexFrom = 0, qsizetype indexTo = -1) const;
     Q_INVOKABLE qsizetype size() const;
+    Q_INVOKABLE QGeoCoordinate centroid() const;
     Q_INVOKABLE void addCoordinate(const QGeoCoordinate &coordinate);
+    Q_INVOKABLE void addCoordinateSimplified(const QGeoCoordinate &coordinate, double tolerance);
     Q_INVOKABLE void insertCoordinate(qsizetype index, const QGeoCoordinate &coordinate);
     Q_INVOKABLE void replaceCoordinate(qsizetype index, const QGeoCoordinate &coordinate);
     Q_INVOKABLE QGeoCoordinate coordinateAt(qsizetype index) const;
     Q_INVOKABLE bool containsCoordinate(const QGeoCoordinate &coordinate) const;
+    QGeoCoordinate nearestCoordinate(const QGeoCoordinate &coordinate,
+                                     qsizetype *segmentIndex = nullptr,
+                                     double *distanceAlongPath = nullptr) const;
+    Q_INVOKABLE QGeoPath simplified(double tolerance) const;
     Q_INVOKABLE void removeCoordinate(const QGeoCoordinate &coordinate);
     Q_INVOKABLE void removeCoordinate(qsizetype index);
 
@@ -18,126 +18,220 @@
 #include <QtPositioning/private/qpositioningglobal_p.h>
 #include "qgeoshape_p.h"
 #include "qgeocoordinate.h"
+#include "qgeocoordinatebuffer.h"
 #include "qlocationutils_p.h"
+#include "qdoublevector2d_p.h"
 #include <QtPositioning/qgeopath.h>
+#include <QtCore/QAtomicInt>
 #include <QtCore/QList>
+#include <QtCore/qmath.h>
+
+#include <vector>
 
 QT_BEGIN_NAMESPACE
 
-inline static void computeBBox(const QList<QGeoCoordinate> &m_path, QList<double> &m_deltaXs,
-                               double &m_minX, double &m_maxX, double &m_minLati, double &m_maxLati,
-                               QGeoRectangle &m_bbox)
+/*
+    Accumulates the bounding box of a path one coordinate at a time, in
+    constant memory. The longitudes are followed across the dateline as
+    deltas from the first one, of which only the last one and the extremes
+    are kept.
+
+    It also accumulates the sum of the coordinates as unit vectors, whose
+    direction is the centroid of the path on the sphere. The sums of the
+    products of their components are kept as well, so that a translation
+    rotates them in constant time, instead of adding all coordinates again.
+*/
+class QGeoPathBounds
 {
-    if (m_path.isEmpty()) {
-        m_deltaXs.clear();
-        m_minX = qInf();
-        m_maxX = -qInf();
-        m_minLati = qInf();
-        m_maxLati = -qInf();
-        m_bbox = QGeoRectangle();
-        return;
-    }
+public:
+    void clear() { *this = QGeoPathBounds(); }
+    inline void add(double latitude, double longitude);
+    inline void addAll(const QGeoCoordinateBuffer &path);
+    inline void translate(double degreesLatitude, double degreesLongitude);
 
-    m_minLati = m_maxLati = m_path.at(0).latitude();
-    qsizetype minId = 0;
-    qsizetype maxId = 0;
-    m_deltaXs.resize(m_path.size());
-    m_deltaXs[0] = m_minX = m_maxX = 0.0;
-
-    for (qsizetype i = 1; i < m_path.size(); i++) {
-        const QGeoCoordinate &geoFrom = m_path.at(i-1);
-        const QGeoCoordinate &geoTo   = m_path.at(i);
-        double longiFrom    = geoFrom.longitude();
-        double longiTo      = geoTo.longitude();
-        double deltaLongi = longiTo - longiFrom;
-        if (qAbs(deltaLongi) > 180.0) {
-            if (longiTo > 0.0)
-                longiTo -= 360.0;
-            else
-                longiTo += 360.0;
-            deltaLongi =  longiTo - longiFrom;
-        }
-        m_deltaXs[i] = m_deltaXs[i-1] + deltaLongi;
-        if (m_deltaXs[i] < m_minX) {
-            m_minX = m_deltaXs[i];
-            minId = i;
-        }
-        if (m_deltaXs[i] > m_maxX) {
-            m_maxX = m_deltaXs[i];
-            maxId = i;
-        }
-        if (geoTo.latitude() > m_maxLati)
-            m_maxLati = geoTo.latitude();
-        if (geoTo.latitude() < m_minLati)
-            m_minLati = geoTo.latitude();
-    }
+    bool isEmpty() const { return m_count == 0; }
+    double minLatitude() const { return m_minLatitude; }
+    double maxLatitude() const { return m_maxLatitude; }
+    inline QGeoRectangle boundingBox() const;
+    inline QGeoCoordinate centroid() const;
 
-    m_bbox = QGeoRectangle(QGeoCoordinate(m_maxLati, m_path.at(minId).longitude()),
-                           QGeoCoordinate(m_minLati, m_path.at(maxId).longitude()));
-}
+private:
+    qsizetype m_count = 0;
+    double m_lastLongitude = 0;
+    double m_deltaX = 0;       // longitude delta of the last coordinate from the first one
+    double m_minX = 0;         // minimum of the deltas
+    double m_maxX = 0;         // maximum of the deltas
+    double m_minLongitude = 0; // longitude where the minimum delta was first reached
+    double m_maxLongitude = 0; // longitude where the maximum delta was first reached
+    double m_minLatitude = qInf();
+    double m_maxLatitude = -qInf(); // paths do not wrap around through the poles
+    // sums over the coordinates, with cos and sin of latitude and longitude
+    double m_sumCosCos = 0; // x
+    double m_sumCosSin = 0; // y
+    double m_sumSin = 0;    // z
+    double m_sumSinCos = 0;
+    double m_sumSinSin = 0;
+    double m_sumCos = 0;
+};
 
-inline static void updateBBox(const QList<QGeoCoordinate> &m_path, QList<double> &m_deltaXs,
-                              double &m_minX, double &m_maxX, double &m_minLati, double &m_maxLati,
-                              QGeoRectangle &m_bbox)
+inline void QGeoPathBounds::add(double latitude, double longitude)
 {
-    if (m_path.isEmpty()) {
-        m_deltaXs.clear();
-        m_minX = qInf();
-        m_maxX = -qInf();
-        m_minLati = qInf();
-        m_maxLati = -qInf();
-        m_bbox = QGeoRectangle();
-        return;
-    } else if (m_path.size() == 1) { // was 0  now is 1
-        m_deltaXs.resize(1);
-        m_deltaXs[0] = m_minX = m_maxX = 0.0;
-        m_minLati = m_maxLati = m_path.at(0).latitude();
-        m_bbox = QGeoRectangle(QGeoCoordinate(m_maxLati, m_path.at(0).longitude()),
-                               QGeoCoordinate(m_minLati, m_path.at(0).longitude()));
-        return;
-    } else if ( m_path.size() != m_deltaXs.size() + 1 ) {  // this case should not happen
-        computeBBox(m_path, m_deltaXs, m_minX, m_maxX, m_minLati, m_maxLati, m_bbox); // something went wrong
+    const double latitudeRadians = qDegreesToRadians(latitude);
+    const double longitudeRadians = qDegreesToRadians(longitude);
+    const double cosLatitude = std::cos(latitudeRadians);
+    const double sinLatitude = std::sin(latitudeRadians);
+    const double cosLongitude = std::cos(longitudeRadians);
+    const double sinLongitude = std::sin(longitudeRadians);
+    m_sumCosCos += cosLatitude * cosLongitude;
+    m_sumCosSin += cosLatitude * sinLongitude;
+    m_sumSin += sinLatitude;
+    m_sumSinCos += sinLatitude * cosLongitude;
+    m_sumSinSin += sinLatitude * sinLongitude;
+    m_sumCos += cosLatitude;
+
+    if (m_count++ == 0) {
+        m_lastLongitude = m_minLongitude = m_maxLongitude = longitude;
+        m_minLatitude = m_maxLatitude = latitude;
         return;
     }
 
-    const QGeoCoordinate &geoFrom = m_path.at(m_path.size()-2);
-    const QGeoCoordinate &geoTo   = m_path.last();
-    double longiFrom    = geoFrom.longitude();
-    double longiTo      = geoTo.longitude();
-    double deltaLongi = longiTo - longiFrom;
+    double longiTo = longitude;
+    double deltaLongi = longiTo - m_lastLongitude;
     if (qAbs(deltaLongi) > 180.0) {
         if (longiTo > 0.0)
             longiTo -= 360.0;
         else
             longiTo += 360.0;
-        deltaLongi =  longiTo - longiFrom;
+        deltaLongi = longiTo - m_lastLongitude;
     }
+    m_lastLongitude = longitude;
 
-    m_deltaXs.push_back(m_deltaXs.last() + deltaLongi);
-    double currentMinLongi = m_bbox.topLeft().longitude();
-    double currentMaxLongi = m_bbox.bottomRight().longitude();
-    if (m_deltaXs.last() < m_minX) {
-        m_minX = m_deltaXs.last();
-        currentMinLongi = geoTo.longitude();
+    m_deltaX += deltaLongi;
+    if (m_deltaX < m_minX) {
+        m_minX = m_deltaX;
+        m_minLongitude = longitude;
     }
-    if (m_deltaXs.last() > m_maxX) {
-        m_maxX = m_deltaXs.last();
-        currentMaxLongi = geoTo.longitude();
+    if (m_deltaX > m_maxX) {
+        m_maxX = m_deltaX;
+        m_maxLongitude = longitude;
     }
-    if (geoTo.latitude() > m_maxLati)
-        m_maxLati = geoTo.latitude();
-    if (geoTo.latitude() < m_minLati)
-        m_minLati = geoTo.latitude();
-    m_bbox = QGeoRectangle(QGeoCoordinate(m_maxLati, currentMinLongi),
-                           QGeoCoordinate(m_minLati, currentMaxLongi));
+    if (latitude > m_maxLatitude)
+        m_maxLatitude = latitude;
+    if (latitude < m_minLatitude)
+        m_minLatitude = latitude;
+}
+
+inline void QGeoPathBounds::addAll(const QGeoCoordinateBuffer &path)
+{
+    const QSpan<const double> latitudes = path.latitudes();
+    const QSpan<const double> longitudes = path.longitudes();
+    for (qsizetype i = 0; i < path.size(); ++i)
+        add(latitudes[i], longitudes[i]);
+}
+
+// Follows QGeoCoordinateBufferPrivate::translate(), which keeps the deltas
+inline void QGeoPathBounds::translate(double degreesLatitude, double degreesLongitude)
+{
+    if (isEmpty())
+        return;
+    m_minLatitude += degreesLatitude;
+    m_maxLatitude += degreesLatitude;
+    m_lastLongitude = QLocationUtils::wrapLong(m_lastLongitude + degreesLongitude);
+    m_minLongitude = QLocationUtils::wrapLong(m_minLongitude + degreesLongitude);
+    m_maxLongitude = QLocationUtils::wrapLong(m_maxLongitude + degreesLongitude);
+
+    // Moving every coordinate by the same angle rotates the pairs of sums
+    // that differ in the cosine and sine of that angle.
+    const auto rotate = [](double *cosSum, double *sinSum, double cosAngle, double sinAngle) {
+        const double c = *cosSum;
+        const double s = *sinSum;
+        *cosSum = c * cosAngle - s * sinAngle;
+        *sinSum = s * cosAngle + c * sinAngle;
+    };
+    const double cosLatitude = std::cos(qDegreesToRadians(degreesLatitude));
+    const double sinLatitude = std::sin(qDegreesToRadians(degreesLatitude));
+    rotate(&m_sumCosCos, &m_sumSinCos, cosLatitude, sinLatitude);
+    rotate(&m_sumCosSin, &m_sumSinSin, cosLatitude, sinLatitude);
+    rotate(&m_sumCos, &m_sumSin, cosLatitude, sinLatitude);
+    const double cosLongitude = std::cos(qDegreesToRadians(degreesLongitude));
+    const double sinLongitude = std::sin(qDegreesToRadians(degreesLongitude));
+    rotate(&m_sumCosCos, &m_sumCosSin, cosLongitude, sinLongitude);
+    rotate(&m_sumSinCos, &m_sumSinSin, cosLongitude, sinLongitude);
+}
+
+inline QGeoRectangle QGeoPathBounds::boundingBox() const
+{
+    if (isEmpty())
+        return QGeoRectangle();
+    return QGeoRectangle(QGeoCoordinate(m_maxLatitude, m_minLongitude),
+                         QGeoCoordinate(m_minLatitude, m_maxLongitude));
+}
+
+// Invalid if the coordinates cancel out, as two antipodal ones do
+inline QGeoCoordinate QGeoPathBounds::centroid() const
+{
+    const double horizontal = std::hypot(m_sumCosCos, m_sumCosSin);
+    if (isEmpty() || std::hypot(horizontal, m_sumSin) < 1e-9 * m_count)
+        return QGeoCoordinate();
+    return QGeoCoordinate(qRadiansToDegrees(std::atan2(m_sumSin, horizontal)),
+                          qRadiansToDegrees(std::atan2(m_sumCosSin, m_sumCosCos)));
 }
 
+/*
+    A bounding volume hierarchy over the segments of a path projected into
+    mercator space the way QGeoPathPrivate::mercatorPath() projects it. The
+    boxes bound the mercator x values of the points lineContainsMercator()
+    converts back into coordinates, that is after wrapping x values greater
+    than 1; segments crossing that limit have an unbounded x range.
+*/
+class QGeoPathSegmentIndex
+{
+public:
+    struct Box
+    {
+        double minX = qInf();
+        double maxX = -qInf();
+        double minY = qInf();
+        double maxY = -qInf();
+    };
+
+    void build(const QList<QDoubleVector2D> &mercatorPath, double leftBoundWrapped);
+    bool isEmpty() const { return m_nodes.empty(); }
+
+    // Calls function(segment) for the segments from vertex segment to
+    // segment + 1 whose box overlaps window, with the x range of window taken
+    // modulo 1, until it returns true. Returns whether it did.
+    template <typename Function>
+    bool findSegment(const Box &window, Function function) const;
+
+    // Calls function(segment) for the segments whose box may hold a point
+    // closer than the distance it returned last, nearer boxes first.
+    // lowerBound(box) must not exceed the distance to any point in box.
+    template <typename LowerBound, typename Function>
+    void findNearest(LowerBound lowerBound, Function function) const;
+
+private:
+    struct Node
+    {
+        Box box;
+        quint32 start = 0; // a leaf's first entry in m_segments, or the right child
+        quint32 count = 0; // 0 for inner nodes, whose left child is the next node
+    };
+
+    quint32 buildNode(const std::vector<Box> &boxes, quint32 *first, quint32 *last);
+
+    std::vector<Node> m_nodes;
+    std::vector<quint32> m_segments;
+    std::vector<Box> m_segmentBoxes; // in the order of m_segments
+};
+
 // Lazy by default. Eager, within the module, used only in MapItems/MapObjectsQSG
 class Q_POSITIONING_EXPORT QGeoPathPrivate : public QGeoShapePrivate
 {
 public:
     QGeoPathPrivate();
     QGeoPathPrivate(const QList<QGeoCoordinate> &path, const qreal width = 0.0);
+    QGeoPathPrivate(const QGeoCoordinateBuffer &path, const qreal width = 0.0);
     ~QGeoPathPrivate();
 
 // QGeoShape API
@@ -147,12 +241,23 @@ public:
     virtual QGeoCoordinate center() const override;
     virtual bool operator==(const QGeoShapePrivate &other) const override;
     virtual bool contains(const QGeoCoordinate &coordinate) const override;
+    void containsEach(QSpan<const QGeoCoordinate> coordinates,
+                      QSpan<bool> results) const override;
     virtual QGeoRectangle boundingGeoRectangle() const override;
     size_t hash(size_t seed) const override;
 
 // QGeoPathPrivate API
     virtual const QList<QGeoCoordinate> &path() const;
+    const QGeoCoordinateBuffer &pathBuffer() const;
     virtual bool lineContains(const QGeoCoordinate &coordinate) const;
+    const QList<QDoubleVector2D> &mercatorPath() const;
+    bool lineContainsMercator(const QGeoCoordinate &coordinate) const;
+    QGeoCoordinate segmentCandidate(const QDoubleVector2D &point, qsizetype segment) const;
+    const QList<double> &cumulativeLengths() const;
+    QGeoCoordinate nearestCoordinate(const QGeoCoordinate &coordinate, qsizetype *segmentIndex,
+                                     double *distanceAlongPath) const;
+    QGeoCoordinate centroid() const;
+    QGeoCoordinateBuffer simplifiedPath(double tolerance) const;
     virtual qreal width() const;
     virtual double length(qsizetype indexFrom, qsizetype indexTo) const;
     virtual qsizetype size() const;
@@ -162,19 +267,42 @@ public:
     virtual void setWidth(const qreal &width);
     virtual void translate(double degreesLatitude, double degreesLongitude);
     virtual void setPath(const QList<QGeoCoordinate> &path);
+    virtual void setPath(const QGeoCoordinateBuffer &path);
     virtual void clearPath();
     virtual void addCoordinate(const QGeoCoordinate &coordinate);
+    void addCoordinateSimplified(const QGeoCoordinate &coordinate, double tolerance);
     virtual void insertCoordinate(qsizetype index, const QGeoCoordinate &coordinate);
     virtual void replaceCoordinate(qsizetype index, const QGeoCoordinate &coordinate);
     virtual void removeCoordinate(const QGeoCoordinate &coordinate);
     virtual void removeCoordinate(qsizetype index);
     virtual void computeBoundingBox();
+    void updateBoundingBox();
     virtual void markDirty();
+    void markCoordinatesChanged();
+    void markCoordinatesChanged(qsizetype index, qsizetype removed, qsizetype inserted);
 
 // data members
-    QList<QGeoCoordinate> m_path;
+    QGeoCoordinateBuffer m_path;
+    mutable QList<QGeoCoordinate> m_pathList; // cached, built by path(), then kept up to date
+    mutable QAtomicInt m_pathListDirty = 0; // path() may build the list on shared data
+    mutable QList<QDoubleVector2D> m_mercatorPath; // cached, only built by mercatorPath()
+    mutable QGeoPathSegmentIndex m_segmentIndex; // cached with m_mercatorPath, for long paths
+    mutable QAtomicInt m_mercatorPathDirty = 1; // built like m_pathList
+    mutable QList<double> m_cumulativeLengths; // cached, built by cumulativeLengths(), then kept up to date
+    mutable QAtomicInt m_cumulativeLengthsDirty = 1; // built like m_pathList
+    // The directions from the last but one coordinate that keep the coordinates
+    // dropped by addCoordinateSimplified() within tolerance, and the
+    // farthest of them. Reset by any other edit.
+    double m_streamTolerance = qQNaN();
+    double m_streamMinAngle = 0;
+    double m_streamMaxAngle = 0;
+    double m_streamMaxRadius = 0;
+    // m_bounds without the last coordinate, if the box was not dirty when it was added
+    QGeoPathBounds m_streamBounds;
+    bool m_streamBoundsValid = false;
     qreal m_width = 0;
     QGeoRectangle m_bbox; // cached
+    QGeoPathBounds m_bounds; // cached with m_bbox
     double m_leftBoundWrapped; // cached
     bool m_bboxDirty = false;
 };
@@ -184,26 +312,14 @@ class Q_POSITIONING_EXPORT QGeoPathPrivateEager : public QGeoPathPrivate
 public:
     QGeoPathPrivateEager();
     QGeoPathPrivateEager(const QList<QGeoCoordinate> &path, const qreal width = 0.0);
+    QGeoPathPrivateEager(const QGeoCoordinateBuffer &path, const qreal width = 0.0);
     ~QGeoPathPrivateEager();
 
 // QGeoShapePrivate API
     virtual QGeoShapePrivate *clone() const override;
-    virtual void translate(double degreesLatitude, double degreesLongitude) override;
 
 // QGeoShapePrivate API
     virtual void markDirty() override;
-    virtual void addCoordinate(const QGeoCoordinate &coordinate) override;
-    virtual void computeBoundingBox() override;
-
-// *Eager API
-    void updateBoundingBox();
-
-// data members
-    QList<double> m_deltaXs; // longitude deltas from m_path[0]
-    double m_minX = 0;              // minimum value inside deltaXs
-    double m_maxX = 0;              // maximum value inside deltaXs
-    double m_minLati = 0;           // minimum latitude. paths do not wrap around through the poles
-    double m_maxLati = 0;           // minimum latitude. paths do not wrap around through the poles
 };
 
 // This is a mean of creating a QGeoPathPrivateEager and injecting it into QGeoPaths via operator=
@@ -5,6 +5,7 @@
 #include "qgeopolygon_p.h"
 #include "qgeopath_p.h"
 #include "qgeocircle.h"
+#include "qgeocoordinatebuffer_p.h"
 
 #include "qgeocoordinate.h"
 #include "qnumeric.h"
@@ -88,6 +89,17 @@ QGeoPolygon::QGeoPolygon(const QList<QGeoCoordinate> &path)
 {
 }
 
+/*!
+    \since 6.9
+
+    Constructs a new geo polygon from the coordinates in \a path. The
+    coordinates are shared with \a path, not copied.
+*/
+QGeoPolygon::QGeoPolygon(const QGeoCoordinateBuffer &path)
+:   QGeoShape(new QGeoPolygonPrivate(path))
+{
+}
+
 /*!
     Constructs a new geo polygon from the contents of \a other.
 */
@@ -183,6 +195,12 @@ void QGeoPolygon::setPerimeter(const QList<QGeoCoordinate> &path)
 /*!
     Returns all the elements of the polygon's perimeter.
 
+    The list is created from the coordinates of the perimeter on the first
+    call after they were all set, translated or cleared, which takes time and
+    memory proportional to the size of the polygon. Adding, inserting,
+    replacing or removing single coordinates updates it instead.
+    perimeterBuffer() does not need the list.
+
     \since QtPositioning 5.12
 */
 const QList<QGeoCoordinate> &QGeoPolygon::perimeter() const
@@ -191,6 +209,34 @@ const QList<QGeoCoordinate> &QGeoPolygon::perimeter() const
     return d->path();
 }
 
+/*!
+    \since 6.9
+
+    Sets the perimeter of the polygon to the coordinates in \a path.
+
+    As with the list overload, the perimeter is left unchanged if any of the
+    coordinates is invalid.
+*/
+void QGeoPolygon::setPerimeter(const QGeoCoordinateBuffer &path)
+{
+    Q_D(QGeoPolygon);
+    return d->setPath(path);
+}
+
+/*!
+    \since 6.9
+
+    Returns all the elements of the polygon's perimeter.
+
+    Unlike perimeter(), this does not need to create a QGeoCoordinate per
+    element, and is therefore preferable for processing large polygons.
+*/
+QGeoCoordinateBuffer QGeoPolygon::perimeterBuffer() const
+{
+    Q_D(const QGeoPolygon);
+    return d->pathBuffer();
+}
+
 /*!
     Translates this geo polygon by \a degreesLatitude northwards and \a degreesLongitude eastwards.
 
@@ -427,6 +473,12 @@ QGeoPolygonPrivate::QGeoPolygonPrivate(const QList<QGeoCoordinate> &path)
     type = QGeoShape::PolygonType;
 }
 
+QGeoPolygonPrivate::QGeoPolygonPrivate(const QGeoCoordinateBuffer &path)
+:   QGeoPathPrivate(path)
+{
+    type = QGeoShape::PolygonType;
+}
+
 QGeoPolygonPrivate::~QGeoPolygonPrivate() {}
 
 QGeoShapePrivate *QGeoPolygonPrivate::clone() const
@@ -436,7 +488,7 @@ QGeoShapePrivate *QGeoPolygonPrivate::clone() const
 
 bool QGeoPolygonPrivate::isValid() const
 {
-    return path().size() > 2;
+    return m_path.size() > 2;
 }
 
 bool QGeoPolygonPrivate::contains(const QGeoCoordinate &coordinate) const
@@ -444,41 +496,41 @@ bool QGeoPolygonPrivate::contains(const QGeoCoordinate &coordinate) const
     return polygonContains(coordinate);
 }
 
-inline static void translatePoly(   QList<QGeoCoordinate> &m_path,
-                                    QList<QList<QGeoCoordinate>> &m_holesList,
+void QGeoPolygonPrivate::containsEach(QSpan<const QGeoCoordinate> coordinates,
+                                      QSpan<bool> results) const
+{
+    if (m_clipperDirty)
+        const_cast<QGeoPolygonPrivate *>(this)->updateClipperPath();
+
+    for (qsizetype i = 0; i < coordinates.size(); ++i)
+        results[i] = clipperPathContains(coordinates[i]);
+}
+
+inline static void translatePoly(   QGeoCoordinateBuffer &m_path,
+                                    QList<QGeoCoordinateBuffer> &m_holesList,
                                     QGeoRectangle &m_bbox,
+                                    QGeoPathBounds &m_bounds,
                                     double degreesLatitude,
-                                    double degreesLongitude,
-                                    double m_maxLati,
-                                    double m_minLati)
+                                    double degreesLongitude)
 {
     if (degreesLatitude > 0.0)
-        degreesLatitude = qMin(degreesLatitude, 90.0 - m_maxLati);
+        degreesLatitude = qMin(degreesLatitude, 90.0 - m_bounds.maxLatitude());
     else
-        degreesLatitude = qMax(degreesLatitude, -90.0 - m_minLati);
-    for (QGeoCoordinate &p: m_path) {
-        p.setLatitude(p.latitude() + degreesLatitude);
-        p.setLongitude(QLocationUtils::wrapLong(p.longitude() + degreesLongitude));
-    }
-    if (!m_holesList.isEmpty()){
-        for (QList<QGeoCoordinate> &hole: m_holesList){
-            for (QGeoCoordinate &holeVertex: hole){
-                holeVertex.setLatitude(holeVertex.latitude() + degreesLatitude);
-                holeVertex.setLongitude(QLocationUtils::wrapLong(holeVertex.longitude() + degreesLongitude));
-            }
-        }
-    }
+        degreesLatitude = qMax(degreesLatitude, -90.0 - m_bounds.minLatitude());
+    QGeoCoordinateBufferPrivate::get(m_path)->translate(degreesLatitude, degreesLongitude);
+    for (QGeoCoordinateBuffer &hole: m_holesList)
+        QGeoCoordinateBufferPrivate::get(hole)->translate(degreesLatitude, degreesLongitude);
+    m_bounds.translate(degreesLatitude, degreesLongitude);
     m_bbox.translate(degreesLatitude, degreesLongitude);
 }
 
 void QGeoPolygonPrivate::translate(double degreesLatitude, double degreesLongitude)
 {
     // Need min/maxLati, so update bbox
-    QList<double> m_deltaXs;
-    double m_minX, m_maxX, m_minLati, m_maxLati;
-    m_bboxDirty = false; // Updated in translatePoly
-    computeBBox(m_path, m_deltaXs, m_minX, m_maxX, m_minLati, m_maxLati, m_bbox);
-    translatePoly(m_path, m_holesList, m_bbox, degreesLatitude, degreesLongitude, m_maxLati, m_minLati);
+    if (m_bboxDirty)
+        computeBoundingBox();
+    translatePoly(m_path, m_holesList, m_bbox, m_bounds, degreesLatitude, degreesLongitude);
+    markCoordinatesChanged();
     m_leftBoundWrapped = QWebMercator::coordToMercator(m_bbox.topLeft()).x();
     m_clipperDirty = true;
 }
@@ -497,7 +549,7 @@ bool QGeoPolygonPrivate::operator==(const QGeoShapePrivate &other) const
 
 size_t QGeoPolygonPrivate::hash(size_t seed) const
 {
-    const size_t pointsHash = qHashRange(m_path.cbegin(), m_path.cend(), seed);
+    const size_t pointsHash = qHash(m_path, seed);
     const size_t holesHash = qHashRange(m_holesList.cbegin(), m_holesList.cend(), seed);
     return qHashMulti(seed, pointsHash, holesHash);
 }
@@ -508,13 +560,13 @@ void QGeoPolygonPrivate::addHole(const QList<QGeoCoordinate> &holePath)
         if (!holeVertex.isValid())
             return;
 
-    m_holesList << holePath;
-    // ToDo: mark clipper dirty when hole caching gets added
+    m_holesList << QGeoCoordinateBuffer(holePath);
+    m_clipperDirty = true;
 }
 
 const QList<QGeoCoordinate> QGeoPolygonPrivate::holePath(qsizetype index) const
 {
-    return m_holesList.at(index);
+    return m_holesList.at(index).toList();
 }
 
 void QGeoPolygonPrivate::removeHole(qsizetype index)
@@ -523,7 +575,7 @@ void QGeoPolygonPrivate::removeHole(qsizetype index)
         return;
 
     m_holesList.removeAt(index);
-    // ToDo: mark clipper dirty when hole caching gets added
+    m_clipperDirty = true;
 }
 
 qsizetype QGeoPolygonPrivate::holesCount() const
@@ -536,6 +588,12 @@ bool QGeoPolygonPrivate::polygonContains(const QGeoCoordinate &coordinate) const
     if (m_clipperDirty)
         const_cast<QGeoPolygonPrivate *>(this)->updateClipperPath(); // this one updates bbox too if needed
 
+    return clipperPathContains(coordinate);
+}
+
+// polygonContains() without the update of the clipper paths
+bool QGeoPolygonPrivate::clipperPathContains(const QGeoCoordinate &coordinate) const
+{
     QDoubleVector2D coord = QWebMercator::coordToMercator(coordinate);
 
     if (coord.x() < m_leftBoundWrapped)
@@ -545,11 +603,17 @@ bool QGeoPolygonPrivate::polygonContains(const QGeoCoordinate &coordinate) const
         return false;
 
     // else iterates the holes List checking whether the point is contained inside the holes
-    for (const QList<QGeoCoordinate> &holePath : std::as_const(m_holesList)) {
-        // ToDo: cache these
-        QGeoPolygon holePolygon;
-        holePolygon.setPerimeter(holePath);
-        if (holePolygon.contains(coordinate))
+    const QDoubleVector2D unwrapped = QWebMercator::coordToMercator(coordinate);
+    for (const HoleClipperPath &hole : m_holeClipperPaths) {
+        QDoubleVector2D holeCoord = unwrapped;
+        if (holeCoord.x() < hole.leftBoundWrapped)
+            holeCoord.setX(holeCoord.x() + 1.0);
+
+        if (holeCoord.x() < hole.minX || holeCoord.x() > hole.maxX
+                || holeCoord.y() < hole.minY || holeCoord.y() > hole.maxY) {
+            continue;
+        }
+        if (hole.clipper.pointInPolygon(holeCoord))
             return false;
     }
     return true;
@@ -560,30 +624,69 @@ void QGeoPolygonPrivate::markDirty()
     m_bboxDirty = m_clipperDirty = true;
 }
 
+void QGeoPolygonPrivate::addCoordinate(const QGeoCoordinate &coordinate)
+{
+    if (!coordinate.isValid())
+        return;
+    QGeoPathPrivate::addCoordinate(coordinate); // keeps the bounding box up to date
+    m_clipperDirty = true;
+}
+
 void QGeoPolygonPrivate::updateClipperPath()
 {
     if (m_bboxDirty)
         computeBoundingBox();
     m_clipperDirty = false;
 
+    const QSpan<const double> latitudes = m_path.latitudes();
+    const QSpan<const double> longitudes = m_path.longitudes();
     QList<QDoubleVector2D> preservedPath;
-    for (const QGeoCoordinate &c : m_path) {
-        QDoubleVector2D crd = QWebMercator::coordToMercator(c);
+    preservedPath.reserve(m_path.size());
+    for (qsizetype i = 0; i < m_path.size(); ++i) {
+        QDoubleVector2D crd = QWebMercator::coordToMercator(latitudes[i], longitudes[i]);
         if (crd.x() < m_leftBoundWrapped)
             crd.setX(crd.x() + 1.0);
         preservedPath << crd;
     }
     m_clipperWrapper.setPolygon(preservedPath);
+
+    m_holeClipperPaths.clear();
+    m_holeClipperPaths.reserve(m_holesList.size());
+    for (const QGeoCoordinateBuffer &holePath : std::as_const(m_holesList)) {
+        QGeoPathBounds holeBounds;
+        holeBounds.addAll(holePath);
+
+        HoleClipperPath &hole = m_holeClipperPaths.emplace_back();
+        hole.leftBoundWrapped =
+                QWebMercator::coordToMercator(holeBounds.boundingBox().topLeft()).x();
+
+        const QSpan<const double> holeLatitudes = holePath.latitudes();
+        const QSpan<const double> holeLongitudes = holePath.longitudes();
+        QList<QDoubleVector2D> holeMercatorPath;
+        holeMercatorPath.reserve(holePath.size());
+        for (qsizetype i = 0; i < holePath.size(); ++i) {
+            QDoubleVector2D crd = QWebMercator::coordToMercator(holeLatitudes[i],
+                                                                holeLongitudes[i]);
+            if (crd.x() < hole.leftBoundWrapped)
+                crd.setX(crd.x() + 1.0);
+            hole.minX = qMin(hole.minX, crd.x());
+            hole.maxX = qMax(hole.maxX, crd.x());
+            hole.minY = qMin(hole.minY, crd.y());
+            hole.maxY = qMax(hole.maxY, crd.y());
+            holeMercatorPath << crd;
+        }
+        hole.clipper.setPolygon(holeMercatorPath);
+    }
 }
 
 QGeoPolygonPrivateEager::QGeoPolygonPrivateEager() : QGeoPolygonPrivate()
 {
-    m_bboxDirty = false; // never dirty on the eager version
+    computeBoundingBox(); // never dirty on the eager version
 }
 
 QGeoPolygonPrivateEager::QGeoPolygonPrivateEager(const QList<QGeoCoordinate> &path) : QGeoPolygonPrivate(path)
 {
-    m_bboxDirty = false; // never dirty on the eager version
+    computeBoundingBox(); // never dirty on the eager version
 }
 
 QGeoPolygonPrivateEager::~QGeoPolygonPrivateEager()
@@ -596,39 +699,12 @@ QGeoShapePrivate *QGeoPolygonPrivateEager::clone() const
     return new QGeoPolygonPrivate(*this);
 }
 
-void QGeoPolygonPrivateEager::translate(double degreesLatitude, double degreesLongitude)
-{
-    translatePoly(m_path, m_holesList, m_bbox, degreesLatitude, degreesLongitude, m_maxLati, m_minLati);
-    m_leftBoundWrapped = QWebMercator::coordToMercator(m_bbox.topLeft()).x();
-    m_clipperDirty = true;
-}
-
 void QGeoPolygonPrivateEager::markDirty()
 {
     m_clipperDirty = true;
     computeBoundingBox();
 }
 
-void QGeoPolygonPrivateEager::addCoordinate(const QGeoCoordinate &coordinate)
-{
-    if (!coordinate.isValid())
-        return;
-    m_path.append(coordinate);
-    m_clipperDirty = true;
-    updateBoundingBox(); // do not markDirty as it uses computeBoundingBox instead
-}
-
-void QGeoPolygonPrivateEager::computeBoundingBox()
-{
-    computeBBox(m_path, m_deltaXs, m_minX, m_maxX, m_minLati, m_maxLati, m_bbox);
-    m_leftBoundWrapped = QWebMercator::coordToMercator(m_bbox.topLeft()).x();
-}
-
-void QGeoPolygonPrivateEager::updateBoundingBox()
-{
-    updateBBox(m_path, m_deltaXs, m_minX, m_maxX, m_minLati, m_maxLati, m_bbox);
-}
-
 QGeoPolygonEager::QGeoPolygonEager() : QGeoPolygon()
 {
     d_ptr = new QGeoPolygonPrivateEager;
@@ -643,7 +719,7 @@ QGeoPolygonEager::QGeoPolygonEager(const QGeoPolygon &other) : QGeoPolygon()
 {
     // without being able to dynamic_cast the d_ptr, only way to be sure is to reconstruct a new QGeoPolygonPrivateEager
     d_ptr = new QGeoPolygonPrivateEager;
-    setPerimeter(other.perimeter());
+    setPerimeter(other.perimeterBuffer());
     for (qsizetype i = 0; i < other.holesCount(); i++)
         addHole(other.holePath(i));
 }
@@ -5,6 +5,7 @@
 #define QGEOPOLYGON_H
 
 #include <QtPositioning/QGeoShape>
+#include <QtPositioning/qgeocoordinatebuffer.h>
 #include <QtCore/QVariantList>
 
 QT_BEGIN_NAMESPACE
@@ -20,6 +21,7 @@ class Q_POSITIONING_EXPORT QGeoPolygon : public QGeoShape
 public:
     QGeoPolygon();
     QGeoPolygon(const QList<QGeoCoordinate> &path);
+    explicit QGeoPolygon(const QGeoCoordinateBuffer &path);
     QGeoPolygon(const QGeoPolygon &other);
     QGeoPolygon(const QGeoShape &other);
 
@@ -29,6 +31,8 @@ public:
 
     void setPerimeter(const QList<QGeoCoordinate> &path);
     const QList<QGeoCoordinate> &perimeter() const;
+    void setPerimeter(const QGeoCoordinateBuffer &path);
+    QGeoCoordinateBuffer perimeterBuffer() const;
 
     Q_INVOKABLE void addHole(const QVariant &holePath);
                 void addHole(const QList<QGeoCoordinate> &holePath);
@@ -19,6 +19,8 @@
 #include <QtPositioning/qgeopolygon.h>
 #include <QtPositioning/private/qclipperutils_p.h>
 
+#include <vector>
+
 QT_BEGIN_NAMESPACE
 
 class Q_POSITIONING_EXPORT QGeoPolygonPrivate : public QGeoPathPrivate
@@ -26,22 +28,27 @@ class Q_POSITIONING_EXPORT QGeoPolygonPrivate : public QGeoPathPrivate
 public:
     QGeoPolygonPrivate();
     QGeoPolygonPrivate(const QList<QGeoCoordinate> &path);
+    QGeoPolygonPrivate(const QGeoCoordinateBuffer &path);
     ~QGeoPolygonPrivate();
 
 // QGeoShape API
     virtual QGeoShapePrivate *clone() const override;
     virtual bool isValid() const override;
     virtual bool contains(const QGeoCoordinate &coordinate) const override;
+    void containsEach(QSpan<const QGeoCoordinate> coordinates,
+                      QSpan<bool> results) const override;
     virtual void translate(double degreesLatitude, double degreesLongitude) override;
     virtual bool operator==(const QGeoShapePrivate &other) const override;
     size_t hash(size_t seed) const override;
 
 // QGeoPath API
     virtual void markDirty() override;
+    virtual void addCoordinate(const QGeoCoordinate &coordinate) override;
 
 // QGeoPolygonPrivate API
     qsizetype holesCount() const;
     bool polygonContains(const QGeoCoordinate &coordinate) const;
+    bool clipperPathContains(const QGeoCoordinate &coordinate) const;
     const QList<QGeoCoordinate> holePath(qsizetype index) const;
 
     virtual void addHole(const QList<QGeoCoordinate> &holePath);
@@ -49,9 +56,22 @@ public:
     virtual void updateClipperPath();
 
 // data members
-    bool m_clipperDirty = true;
-    QList<QList<QGeoCoordinate>> m_holesList;
+    // A hole projected the way QGeoPolygon(holePath).contains() projects it
+    struct HoleClipperPath
+    {
+        QClipperUtils clipper;
+        double leftBoundWrapped = 0;
+        // Mercator bounds of the projected path; nothing outside is in the hole
+        double minX = qInf();
+        double maxX = -qInf();
+        double minY = qInf();
+        double maxY = -qInf();
+    };
+
+    bool m_clipperDirty = true; // also for m_holeClipperPaths
+    QList<QGeoCoordinateBuffer> m_holesList;
     QClipperUtils m_clipperWrapper;
+    std::vector<HoleClipperPath> m_holeClipperPaths; // cached, only appended to and cleared
 };
 
 class Q_POSITIONING_EXPORT QGeoPolygonPrivateEager : public QGeoPolygonPrivate
@@ -63,24 +83,9 @@ public:
 
 // QGeoShape API
     virtual QGeoShapePrivate *clone() const override;
-    virtual void translate(double degreesLatitude, double degreesLongitude) override;
 
 // QGeoPath API
     virtual void markDirty() override;
-    virtual void addCoordinate(const QGeoCoordinate &coordinate) override;
-    virtual void computeBoundingBox() override;
-
-// QGeoPolygonPrivate API
-
-// *Eager API
-    void updateBoundingBox();
-
-// data members
-    QList<double> m_deltaXs; // longitude deltas from m_path[0]
-    double m_minX = 0;              // minimum value inside deltaXs
-    double m_maxX = 0;              // maximum value inside deltaXs
-    double m_minLati = 0;           // minimum latitude. paths do not wrap around through the poles
-    double m_maxLati = 0;           // minimum latitude. paths do not wrap around through the poles
 };
 
 // This is a mean of creating a QGeoPolygonPrivateEager and injecting it into QGeoPolygons via operator=
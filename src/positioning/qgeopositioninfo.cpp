@@ -2,13 +2,10 @@
 // SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
 #include "qgeopositioninfo.h"
 #include "private/qgeopositioninfo_p.h"
-#include <QHash>
 #include <QDebug>
 #include <QDataStream>
 #include <QtCore/QtNumeric>
 
-#include <algorithm>
-
 QT_BEGIN_NAMESPACE
 
 QT_IMPL_METATYPE_EXTERN(QGeoPositionInfo)
@@ -208,7 +205,7 @@ QGeoCoordinate QGeoPositionInfo::coordinate() const
 void QGeoPositionInfo::setAttribute(Attribute attribute, qreal value)
 {
     d.detach();
-    d->doubleAttribs[attribute] = value;
+    d->setAttribute(attribute, value);
 }
 
 /*!
@@ -223,7 +220,7 @@ void QGeoPositionInfo::setAttribute(Attribute attribute, qreal value)
 */
 qreal QGeoPositionInfo::attribute(Attribute attribute) const
 {
-    if (d->doubleAttribs.contains(attribute))
+    if (d->hasAttribute(attribute))
         return d->doubleAttribs[attribute];
     return qQNaN();
 }
@@ -234,7 +231,7 @@ qreal QGeoPositionInfo::attribute(Attribute attribute) const
 void QGeoPositionInfo::removeAttribute(Attribute attribute)
 {
     d.detach();
-    d->doubleAttribs.remove(attribute);
+    d->removeAttribute(attribute);
 }
 
 /*!
@@ -243,7 +240,7 @@ void QGeoPositionInfo::removeAttribute(Attribute attribute)
 */
 bool QGeoPositionInfo::hasAttribute(Attribute attribute) const
 {
-    return d->doubleAttribs.contains(attribute);
+    return d->hasAttribute(attribute);
 }
 
 /*!
@@ -270,11 +267,12 @@ QDebug QGeoPositionInfo::debugStreaming(QDebug dbg, const QGeoPositionInfo &info
     dbg.nospace() << ", "; // timestamp force dbg.space() -> reverting here
     dbg << info.d->coord;
 
-    QList<QGeoPositionInfo::Attribute> attribs = info.d->doubleAttribs.keys();
-    std::stable_sort(attribs.begin(), attribs.end()); // Output a sorted list from an unsorted hash.
-    for (int i = 0; i < attribs.size(); ++i) {
+    for (int i = 0; i < QGeoPositionInfoPrivate::AttributeCount; ++i) {
+        const auto attribute = static_cast<QGeoPositionInfo::Attribute>(i);
+        if (!info.d->hasAttribute(attribute))
+            continue;
         dbg << ", ";
-        switch (attribs[i]) {
+        switch (attribute) {
             case QGeoPositionInfo::Direction:
                 dbg << "Direction=";
                 break;
@@ -297,7 +295,7 @@ QDebug QGeoPositionInfo::debugStreaming(QDebug dbg, const QGeoPositionInfo &info
                 dbg << "DirectionAccuracy=";
                 break;
         }
-        dbg << info.d->doubleAttribs[attribs[i]];
+        dbg << info.d->doubleAttribs[attribute];
     }
     dbg << ')';
     return dbg;
@@ -345,7 +343,14 @@ QDataStream &QGeoPositionInfo::dataStreamOut(QDataStream &stream, const QGeoPosi
 {
     stream << info.d->timestamp;
     stream << info.d->coord;
-    stream << info.d->doubleAttribs;
+    // Same format as the QHash<Attribute, qreal> the attributes used to be
+    // stored in: the number of attributes, followed by key and value pairs.
+    stream << quint32(info.d->attributeCount());
+    for (int i = 0; i < QGeoPositionInfoPrivate::AttributeCount; ++i) {
+        const auto attribute = static_cast<QGeoPositionInfo::Attribute>(i);
+        if (info.d->hasAttribute(attribute))
+            stream << attribute << info.d->doubleAttribs[attribute];
+    }
     return stream;
 }
 
@@ -362,7 +367,20 @@ QDataStream &QGeoPositionInfo::dataStreamIn(QDataStream &stream, QGeoPositionInf
 {
     stream >> info.d->timestamp;
     stream >> info.d->coord;
-    stream >> info.d->doubleAttribs;
+
+    info.d->doubleAttribsMask = 0;
+    quint32 count;
+    stream >> count;
+    for (quint32 i = 0; i < count; ++i) {
+        QGeoPositionInfo::Attribute attribute;
+        qreal value;
+        stream >> attribute >> value;
+        if (stream.status() != QDataStream::Ok) {
+            info.d->doubleAttribsMask = 0;
+            break;
+        }
+        info.d->setAttribute(attribute, value);
+    }
     return stream;
 }
 #endif
@@ -375,7 +393,8 @@ QGeoPositionInfoPrivate::QGeoPositionInfoPrivate(const QGeoPositionInfoPrivate &
     : QSharedData(other),
       timestamp(other.timestamp),
       coord(other.coord),
-      doubleAttribs(other.doubleAttribs)
+      doubleAttribs(other.doubleAttribs),
+      doubleAttribsMask(other.doubleAttribsMask)
 {
 }
 
@@ -384,11 +403,22 @@ QGeoPositionInfoPrivate::~QGeoPositionInfoPrivate()
 
 }
 
+QGeoPositionInfoPrivate *QGeoPositionInfoPrivate::clone() const
+{
+    return new QGeoPositionInfoPrivate(*this);
+}
+
 bool QGeoPositionInfoPrivate::operator==(const QGeoPositionInfoPrivate &other) const
 {
-    return timestamp == other.timestamp
-           && coord == other.coord
-            && doubleAttribs == other.doubleAttribs;
+    if (timestamp != other.timestamp || coord != other.coord
+            || doubleAttribsMask != other.doubleAttribsMask) {
+        return false;
+    }
+    for (int i = 0; i < AttributeCount; ++i) {
+        if ((doubleAttribsMask & (1u << i)) && doubleAttribs[i] != other.doubleAttribs[i])
+            return false;
+    }
+    return true;
 }
 
 QGeoPositionInfoPrivate *QGeoPositionInfoPrivate::get(const QGeoPositionInfo &info)
@@ -16,10 +16,12 @@
 
 #include <QtPositioning/private/qpositioningglobal_p.h>
 #include "qgeopositioninfo.h"
-#include <QHash>
 #include <QDateTime>
+#include <QtCore/qalgorithms.h>
 #include <QtPositioning/qgeocoordinate.h>
 
+#include <array>
+
 QT_BEGIN_NAMESPACE
 
 class QGeoPositionInfoPrivate : public QSharedData
@@ -28,15 +30,51 @@ public:
     QGeoPositionInfoPrivate();
     QGeoPositionInfoPrivate(const QGeoPositionInfoPrivate &other);
     virtual ~QGeoPositionInfoPrivate();
+    virtual QGeoPositionInfoPrivate *clone() const;
     bool operator==(const QGeoPositionInfoPrivate &other) const;
 
+    static constexpr int AttributeCount = QGeoPositionInfo::DirectionAccuracy + 1;
+
+    static bool isValidAttribute(QGeoPositionInfo::Attribute attribute)
+    {
+        return uint(attribute) < uint(AttributeCount);
+    }
+    bool hasAttribute(QGeoPositionInfo::Attribute attribute) const
+    {
+        return isValidAttribute(attribute) && (doubleAttribsMask & (1u << attribute));
+    }
+    void setAttribute(QGeoPositionInfo::Attribute attribute, qreal value)
+    {
+        if (!isValidAttribute(attribute))
+            return;
+        doubleAttribs[attribute] = value;
+        doubleAttribsMask |= 1u << attribute;
+    }
+    void removeAttribute(QGeoPositionInfo::Attribute attribute)
+    {
+        if (isValidAttribute(attribute))
+            doubleAttribsMask &= ~(1u << attribute);
+    }
+    int attributeCount() const { return qPopulationCount(doubleAttribsMask); }
+
     QDateTime timestamp;
     QGeoCoordinate coord;
-    QHash<QGeoPositionInfo::Attribute, qreal> doubleAttribs;
+    // Only the values whose bit is set in doubleAttribsMask are meaningful
+    std::array<qreal, AttributeCount> doubleAttribs = {};
+    quint8 doubleAttribsMask = 0;
+    bool hasNmeaSentences = false; // set by QGeoPositionInfoPrivateNmea, not copied
 
     static QGeoPositionInfoPrivate *get(const QGeoPositionInfo &info);
 };
 
+// don't use the copy constructor when detaching from a QExplicitlySharedDataPointer,
+// use virtual clone() call instead, so that the NMEA sources' private data keeps its type.
+template <>
+Q_INLINE_TEMPLATE QGeoPositionInfoPrivate *QExplicitlySharedDataPointer<QGeoPositionInfoPrivate>::clone()
+{
+    return d->clone();
+}
+
 QT_END_NAMESPACE
 
 #endif // QGEOPOSITIONINFO_P_H
@@ -10,6 +10,9 @@
 #include "qnumeric.h"
 #include "qlocationutils_p.h"
 #include <QList>
+
+#include <algorithm>
+
 QT_BEGIN_NAMESPACE
 
 QT_IMPL_METATYPE_EXTERN(QGeoRectangle)
@@ -531,19 +534,9 @@ double QGeoRectangle::height() const
     return d->topLeft.latitude() - d->bottomRight.latitude();
 }
 
-bool QGeoRectanglePrivate::contains(const QGeoCoordinate &coordinate) const
+static bool qgeorectangle_contains(double top, double bottom, double left, double right,
+                                   double lat, double lon)
 {
-    if (!isValid() || !coordinate.isValid())
-        return false;
-
-    double left = topLeft.longitude();
-    double right = bottomRight.longitude();
-    double top = topLeft.latitude();
-    double bottom = bottomRight.latitude();
-
-    double lon = coordinate.longitude();
-    double lat = coordinate.latitude();
-
     if (lat > top)
         return false;
     if (lat < bottom)
@@ -566,6 +559,36 @@ bool QGeoRectanglePrivate::contains(const QGeoCoordinate &coordinate) const
     return true;
 }
 
+bool QGeoRectanglePrivate::contains(const QGeoCoordinate &coordinate) const
+{
+    if (!isValid() || !coordinate.isValid())
+        return false;
+
+    return qgeorectangle_contains(topLeft.latitude(), bottomRight.latitude(),
+                                  topLeft.longitude(), bottomRight.longitude(),
+                                  coordinate.latitude(), coordinate.longitude());
+}
+
+void QGeoRectanglePrivate::containsEach(QSpan<const QGeoCoordinate> coordinates,
+                                        QSpan<bool> results) const
+{
+    if (!isValid()) {
+        std::fill(results.begin(), results.end(), false);
+        return;
+    }
+
+    const double top = topLeft.latitude();
+    const double bottom = bottomRight.latitude();
+    const double left = topLeft.longitude();
+    const double right = bottomRight.longitude();
+    for (qsizetype i = 0; i < coordinates.size(); ++i) {
+        const QGeoCoordinate &coordinate = coordinates[i];
+        results[i] = coordinate.isValid()
+                && qgeorectangle_contains(top, bottom, left, right,
+                                          coordinate.latitude(), coordinate.longitude());
+    }
+}
+
 QGeoCoordinate QGeoRectanglePrivate::center() const
 {
     if (!isValid())
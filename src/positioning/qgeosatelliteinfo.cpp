@@ -58,9 +58,6 @@ QT_IMPL_METATYPE_EXTERN(QGeoSatelliteInfo)
 QGeoSatelliteInfo::QGeoSatelliteInfo()
         : d(new QGeoSatelliteInfoPrivate)
 {
-    d->signal = -1;
-    d->satId = -1;
-    d->system = QGeoSatelliteInfo::Undefined;
 }
 
 /*!
@@ -229,7 +226,7 @@ int QGeoSatelliteInfo::signalStrength() const
 void QGeoSatelliteInfo::setAttribute(Attribute attribute, qreal value)
 {
     d.detach();
-    d->doubleAttribs[int(attribute)] = value;
+    d->setAttribute(attribute, value);
 }
 
 /*!
@@ -241,8 +238,8 @@ void QGeoSatelliteInfo::setAttribute(Attribute attribute, qreal value)
 */
 qreal QGeoSatelliteInfo::attribute(Attribute attribute) const
 {
-    if (d->doubleAttribs.contains(int(attribute)))
-        return d->doubleAttribs[int(attribute)];
+    if (d->hasAttribute(attribute))
+        return d->doubleAttribs[attribute];
     return -1;
 }
 
@@ -252,7 +249,7 @@ qreal QGeoSatelliteInfo::attribute(Attribute attribute) const
 void QGeoSatelliteInfo::removeAttribute(Attribute attribute)
 {
     d.detach();
-    d->doubleAttribs.remove(int(attribute));
+    d->removeAttribute(attribute);
 }
 
 /*!
@@ -260,7 +257,7 @@ void QGeoSatelliteInfo::removeAttribute(Attribute attribute)
 */
 bool QGeoSatelliteInfo::hasAttribute(Attribute attribute) const
 {
-    return d->doubleAttribs.contains(int(attribute));
+    return d->hasAttribute(attribute);
 }
 
 /*!
@@ -288,10 +285,12 @@ QDebug QGeoSatelliteInfo::debugStreaming(QDebug dbg, const QGeoSatelliteInfo &in
     dbg << ", signal-strength=" << info.d->signal;
 
 
-    QList<int> attribs = info.d->doubleAttribs.keys();
-    for (int i = 0; i < attribs.size(); ++i) {
+    for (int i = 0; i < QGeoSatelliteInfoPrivate::AttributeCount; ++i) {
+        const auto attribute = static_cast<QGeoSatelliteInfo::Attribute>(i);
+        if (!info.d->hasAttribute(attribute))
+            continue;
         dbg << ", ";
-        switch (attribs[i]) {
+        switch (attribute) {
             case QGeoSatelliteInfo::Elevation:
                 dbg << "Elevation=";
                 break;
@@ -299,7 +298,7 @@ QDebug QGeoSatelliteInfo::debugStreaming(QDebug dbg, const QGeoSatelliteInfo &in
                 dbg << "Azimuth=";
                 break;
         }
-        dbg << info.d->doubleAttribs[attribs[i]];
+        dbg << info.d->doubleAttribs[attribute];
     }
     dbg << ')';
     return dbg;
@@ -319,7 +318,14 @@ QDebug QGeoSatelliteInfo::debugStreaming(QDebug dbg, const QGeoSatelliteInfo &in
 QDataStream &QGeoSatelliteInfo::dataStreamOut(QDataStream &stream, const QGeoSatelliteInfo &info)
 {
     stream << info.d->signal;
-    stream << info.d->doubleAttribs;
+    // Same format as the QHash<int, qreal> the attributes used to be stored
+    // in: the number of attributes, followed by key and value pairs.
+    stream << quint32(info.d->attributeCount());
+    for (int i = 0; i < QGeoSatelliteInfoPrivate::AttributeCount; ++i) {
+        const auto attribute = static_cast<QGeoSatelliteInfo::Attribute>(i);
+        if (info.d->hasAttribute(attribute))
+            stream << i << info.d->doubleAttribs[attribute];
+    }
     stream << info.d->satId;
     stream << int(info.d->system);
     return stream;
@@ -340,7 +346,21 @@ QDataStream &QGeoSatelliteInfo::dataStreamIn(QDataStream &stream, QGeoSatelliteI
 {
     int system;
     stream >> info.d->signal;
-    stream >> info.d->doubleAttribs;
+
+    info.d->doubleAttribsMask = 0;
+    quint32 count;
+    stream >> count;
+    for (quint32 i = 0; i < count; ++i) {
+        int attribute;
+        qreal value;
+        stream >> attribute >> value;
+        if (stream.status() != QDataStream::Ok) {
+            info.d->doubleAttribsMask = 0;
+            break;
+        }
+        info.d->setAttribute(static_cast<QGeoSatelliteInfo::Attribute>(attribute), value);
+    }
+
     stream >> info.d->satId;
     stream >> system;
     info.d->system = (QGeoSatelliteInfo::SatelliteSystem)system;
@@ -360,16 +380,22 @@ QGeoSatelliteInfoPrivate::QGeoSatelliteInfoPrivate(const QGeoSatelliteInfoPrivat
     satId = other.satId;
     system = other.system;
     doubleAttribs = other.doubleAttribs;
+    doubleAttribsMask = other.doubleAttribsMask;
 }
 
 QGeoSatelliteInfoPrivate::~QGeoSatelliteInfoPrivate() {}
 
 bool QGeoSatelliteInfoPrivate::operator==(const QGeoSatelliteInfoPrivate &other) const
 {
-    return signal == other.signal
-           && satId == other.satId
-           && system == other.system
-           && doubleAttribs == other.doubleAttribs;
+    if (signal != other.signal || satId != other.satId || system != other.system
+            || doubleAttribsMask != other.doubleAttribsMask) {
+        return false;
+    }
+    for (int i = 0; i < AttributeCount; ++i) {
+        if ((doubleAttribsMask & (1u << i)) && doubleAttribs[i] != other.doubleAttribs[i])
+            return false;
+    }
+    return true;
 }
 
 QGeoSatelliteInfoPrivate *QGeoSatelliteInfoPrivate::get(const QGeoSatelliteInfo &info)
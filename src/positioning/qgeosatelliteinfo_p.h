@@ -17,7 +17,9 @@
 
 #include <QtPositioning/private/qpositioningglobal_p.h>
 #include <QtPositioning/qgeosatelliteinfo.h>
-#include <QHash>
+#include <QtCore/qalgorithms.h>
+
+#include <array>
 
 QT_BEGIN_NAMESPACE
 
@@ -30,10 +32,36 @@ public:
     bool operator==(const QGeoSatelliteInfoPrivate &other) const;
     static QGeoSatelliteInfoPrivate *get(const QGeoSatelliteInfo &info);
 
-    int signal;
-    int satId;
-    QGeoSatelliteInfo::SatelliteSystem system;
-    QHash<int, qreal> doubleAttribs;
+    static constexpr int AttributeCount = QGeoSatelliteInfo::Azimuth + 1;
+
+    static bool isValidAttribute(QGeoSatelliteInfo::Attribute attribute)
+    {
+        return uint(attribute) < uint(AttributeCount);
+    }
+    bool hasAttribute(QGeoSatelliteInfo::Attribute attribute) const
+    {
+        return isValidAttribute(attribute) && (doubleAttribsMask & (1u << attribute));
+    }
+    void setAttribute(QGeoSatelliteInfo::Attribute attribute, qreal value)
+    {
+        if (!isValidAttribute(attribute))
+            return;
+        doubleAttribs[attribute] = value;
+        doubleAttribsMask |= 1u << attribute;
+    }
+    void removeAttribute(QGeoSatelliteInfo::Attribute attribute)
+    {
+        if (isValidAttribute(attribute))
+            doubleAttribsMask &= ~(1u << attribute);
+    }
+    int attributeCount() const { return qPopulationCount(doubleAttribsMask); }
+
+    int signal = -1;
+    int satId = -1;
+    QGeoSatelliteInfo::SatelliteSystem system = QGeoSatelliteInfo::Undefined;
+    // Only the values whose bit is set in doubleAttribsMask are meaningful
+    std::array<qreal, AttributeCount> doubleAttribs = {};
+    quint8 doubleAttribsMask = 0;
 };
 
 QT_END_NAMESPACE
@@ -17,6 +17,8 @@
 #include <QtCore/QDataStream>
 #endif
 
+#include <algorithm>
+
 QT_BEGIN_NAMESPACE
 
 QT_IMPL_METATYPE_EXTERN(QGeoShape)
@@ -30,6 +32,13 @@ QGeoShapePrivate::~QGeoShapePrivate()
 {
 }
 
+void QGeoShapePrivate::containsEach(QSpan<const QGeoCoordinate> coordinates,
+                                    QSpan<bool> results) const
+{
+    for (qsizetype i = 0; i < coordinates.size(); ++i)
+        results[i] = contains(coordinates[i]);
+}
+
 bool QGeoShapePrivate::operator==(const QGeoShapePrivate &other) const
 {
     return type == other.type;
@@ -208,6 +217,30 @@ bool QGeoShape::contains(const QGeoCoordinate &coordinate) const
         return false;
 }
 
+/*!
+    \since 6.9
+
+    Checks for each of the \a coordinates whether it is contained within this
+    geo shape, and stores the result in the element of \a results with the
+    same index. \a results must have at least as many elements as
+    \a coordinates.
+
+    The results are the same as from calling contains() for every coordinate,
+    but the work that does not depend on the coordinate, like projecting the
+    vertices of a path, is only done once.
+*/
+void QGeoShape::contains(QSpan<const QGeoCoordinate> coordinates, QSpan<bool> results) const
+{
+    Q_D(const QGeoShape);
+
+    Q_ASSERT(results.size() >= coordinates.size());
+    results = results.first(coordinates.size());
+    if (d)
+        d->containsEach(coordinates, results);
+    else
+        std::fill(results.begin(), results.end(), false);
+}
+
 /*!
     Returns a QGeoRectangle representing the geographical bounding rectangle of the
     geo shape, that defines the latitudinal/longitudinal bounds of the geo shape.
@@ -5,6 +5,7 @@
 #define QGEOSHAPE_H
 
 #include <QtCore/QSharedDataPointer>
+#include <QtCore/qspan.h>
 #include <QtPositioning/QGeoCoordinate>
 
 QT_BEGIN_NAMESPACE
@@ -40,6 +41,7 @@ public:
     bool isValid() const;
     bool isEmpty() const;
     Q_INVOKABLE bool contains(const QGeoCoordinate &coordinate) const;
+    void contains(QSpan<const QGeoCoordinate> coordinates, QSpan<bool> results) const;
     Q_INVOKABLE QGeoRectangle boundingGeoRectangle() const;
     QGeoCoordinate center() const;
 
@@ -31,6 +31,7 @@ public:
     virtual bool isValid() const = 0;
     virtual bool isEmpty() const = 0;
     virtual bool contains(const QGeoCoordinate &coordinate) const = 0;
+    virtual void containsEach(QSpan<const QGeoCoordinate> coordinates, QSpan<bool> results) const;
 
     virtual QGeoCoordinate center() const = 0;
 
@@ -2,8 +2,10 @@
 // Copyright (C) 2016 The Qt Company Ltd.
 // SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
 #include "qlocationutils_p.h"
+#include "qnmeasentencescanner_p.h"
 #include "qgeopositioninfo.h"
 #include "qgeosatelliteinfo.h"
+#include "qgeosatelliteinfo_p.h"
 
 #include <QTime>
 #include <QList>
@@ -11,11 +13,57 @@
 #include <QDateTime>
 #include <QDebug>
 #include <QTimeZone>
+#include <QtCore/private/qtools_p.h>
 
+#include <array>
 #include <math.h>
 
 QT_BEGIN_NAMESPACE
 
+/*
+    Splits an NMEA sentence into its comma separated fields without allocating.
+
+    The fields are views into the sentence, so the sentence must outlive this
+    object. Only the first MaxFields fields are recorded, which is more than
+    any of the supported sentence types carry.
+*/
+class QNmeaFields
+{
+public:
+    static constexpr qsizetype MaxFields = 32;
+
+    explicit QNmeaFields(QByteArrayView sentence)
+        : m_sentence(sentence)
+    {
+        // m_bounds[i] is the offset of the first character of field i, and
+        // m_bounds[i + 1] - 1 the offset of the comma terminating it.
+        m_bounds[0] = 0;
+        while (m_count < MaxFields) {
+            const qsizetype comma = sentence.indexOf(',', m_bounds[m_count]);
+            ++m_count;
+            if (comma < 0) {
+                m_bounds[m_count] = sentence.size() + 1;
+                break;
+            }
+            m_bounds[m_count] = comma + 1;
+        }
+    }
+
+    qsizetype size() const { return m_count; }
+
+    QByteArrayView at(qsizetype i) const
+    {
+        Q_ASSERT(i >= 0 && i < m_count);
+        return m_sentence.sliced(m_bounds[i], m_bounds[i + 1] - m_bounds[i] - 1);
+    }
+    QByteArrayView operator[](qsizetype i) const { return at(i); }
+
+private:
+    QByteArrayView m_sentence;
+    std::array<qsizetype, MaxFields + 1> m_bounds;
+    qsizetype m_count = 0;
+};
+
 // converts e.g. 15306.0235 from NMEA sentence to 153.100392
 static double qlocationutils_nmeaDegreesToDecimal(double nmeaDegrees)
 {
@@ -24,10 +72,69 @@ static double qlocationutils_nmeaDegreesToDecimal(double nmeaDegrees)
     return deg + (min / 60.0);
 }
 
+/*
+    Parses plain decimal numbers such as "4807.038" or "-1.5" without going
+    through the generic conversion. As long as all digits fit into the
+    mantissa and the divisor is an exactly representable power of ten, the
+    single division below is correctly rounded and therefore gives exactly the
+    same result as QByteArrayView::toDouble(). Everything else (exponents,
+    whitespace, very long fields, ...) is left to toDouble().
+*/
+static double qlocationutils_toDouble(QByteArrayView bv, bool *ok)
+{
+    static constexpr double powersOf10[] = {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+    };
+    constexpr int maxDigits = 15; // 10^15 < 2^53
+    constexpr int maxFractionDigits = int(std::size(powersOf10)) - 1;
+
+    const char *it = bv.begin();
+    const char *end = bv.end();
+    const bool negative = it != end && *it == '-';
+    if (negative)
+        ++it;
+
+    quint64 mantissa = 0;
+    int digits = 0;
+    int fractionDigits = -1;
+    for (; it != end; ++it) {
+        if (QtMiscUtils::isAsciiDigit(*it)) {
+            mantissa = mantissa * 10 + (*it - '0');
+            ++digits;
+            if (fractionDigits >= 0)
+                ++fractionDigits;
+        } else if (*it == '.' && fractionDigits < 0) {
+            fractionDigits = 0;
+        } else {
+            break;
+        }
+    }
+
+    if (it != end || digits == 0 || digits > maxDigits || fractionDigits > maxFractionDigits)
+        return bv.toDouble(ok);
+
+    double value = double(mantissa);
+    if (fractionDigits > 0)
+        value /= powersOf10[fractionDigits];
+    *ok = true;
+    return negative ? -value : value;
+}
+
+// returns the value of the two decimal digits at pos, or -1
+static inline int qlocationutils_twoDigits(QByteArrayView bv, qsizetype pos)
+{
+    const char hi = bv[pos];
+    const char lo = bv[pos + 1];
+    if (!QtMiscUtils::isAsciiDigit(hi) || !QtMiscUtils::isAsciiDigit(lo))
+        return -1;
+    return (hi - '0') * 10 + (lo - '0');
+}
+
 static void qlocationutils_readGga(QByteArrayView bv, QGeoPositionInfo *info, double uere,
                                    bool *hasFix)
 {
-    const QList<QByteArray> parts = QByteArray::fromRawData(bv.data(), bv.size()).split(',');
+    const QNmeaFields parts(bv);
     QGeoCoordinate coord;
 
     if (hasFix && parts.size() > 6 && !parts[6].isEmpty())
@@ -50,14 +157,14 @@ static void qlocationutils_readGga(QByteArrayView bv, QGeoPositionInfo *info, do
 
     if (parts.size() > 8 && !parts[8].isEmpty()) {
         bool hasHdop = false;
-        double hdop = parts[8].toDouble(&hasHdop);
+        double hdop = qlocationutils_toDouble(parts[8], &hasHdop);
         if (hasHdop)
             info->setAttribute(QGeoPositionInfo::HorizontalAccuracy, 2 * hdop * uere);
     }
 
     if (parts.size() > 9 && !parts[9].isEmpty()) {
         bool hasAlt = false;
-        double alt = parts[9].toDouble(&hasAlt);
+        double alt = qlocationutils_toDouble(parts[9], &hasAlt);
         if (hasAlt)
             coord.setAltitude(alt);
     }
@@ -69,21 +176,21 @@ static void qlocationutils_readGga(QByteArrayView bv, QGeoPositionInfo *info, do
 static void qlocationutils_readGsa(QByteArrayView bv, QGeoPositionInfo *info, double uere,
                                    bool *hasFix)
 {
-    const QList<QByteArray> parts = QByteArray::fromRawData(bv.data(), bv.size()).split(',');
+    const QNmeaFields parts(bv);
 
     if (hasFix && parts.size() > 2 && !parts[2].isEmpty())
         *hasFix = parts[2].toInt() > 0;
 
     if (parts.size() > 16 && !parts[16].isEmpty()) {
         bool hasHdop = false;
-        double hdop = parts[16].toDouble(&hasHdop);
+        double hdop = qlocationutils_toDouble(parts[16], &hasHdop);
         if (hasHdop)
             info->setAttribute(QGeoPositionInfo::HorizontalAccuracy, 2 * hdop * uere);
     }
 
     if (parts.size() > 17 && !parts[17].isEmpty()) {
         bool hasVdop = false;
-        double vdop = parts[17].toDouble(&hasVdop);
+        double vdop = qlocationutils_toDouble(parts[17], &hasVdop);
         if (hasVdop)
             info->setAttribute(QGeoPositionInfo::VerticalAccuracy, 2 * vdop * uere);
     }
@@ -91,13 +198,13 @@ static void qlocationutils_readGsa(QByteArrayView bv, QGeoPositionInfo *info, do
 
 static void qlocationutils_readGsa(QByteArrayView bv, QList<int> &pnrsInUse)
 {
-    const QList<QByteArray> parts = QByteArray::fromRawData(bv.data(), bv.size()).split(',');
+    const QNmeaFields parts(bv);
     pnrsInUse.clear();
     if (parts.size() <= 2)
         return;
     bool ok;
-    for (qsizetype i = 3; i < qMin(15, parts.size()); ++i) {
-        const QByteArray &pnrString = parts.at(i);
+    for (qsizetype i = 3; i < qMin(qsizetype(15), parts.size()); ++i) {
+        const QByteArrayView pnrString = parts.at(i);
         if (pnrString.isEmpty())
             continue;
         int pnr = pnrString.toInt(&ok);
@@ -108,7 +215,7 @@ static void qlocationutils_readGsa(QByteArrayView bv, QList<int> &pnrsInUse)
 
 static void qlocationutils_readGll(QByteArrayView bv, QGeoPositionInfo *info, bool *hasFix)
 {
-    const QList<QByteArray> parts = QByteArray::fromRawData(bv.data(), bv.size()).split(',');
+    const QNmeaFields parts(bv);
     QGeoCoordinate coord;
 
     if (hasFix && parts.size() > 6 && !parts[6].isEmpty())
@@ -135,7 +242,7 @@ static void qlocationutils_readGll(QByteArrayView bv, QGeoPositionInfo *info, bo
 
 static void qlocationutils_readRmc(QByteArrayView bv, QGeoPositionInfo *info, bool *hasFix)
 {
-    const QList<QByteArray> parts = QByteArray::fromRawData(bv.data(), bv.size()).split(',');
+    const QNmeaFields parts(bv);
     QGeoCoordinate coord;
     QDate date;
     QTime time;
@@ -143,11 +250,8 @@ static void qlocationutils_readRmc(QByteArrayView bv, QGeoPositionInfo *info, bo
     if (hasFix && parts.size() > 2 && !parts[2].isEmpty())
         *hasFix = (parts[2][0] == 'A');
 
-    if (parts.size() > 9 && parts[9].size() == 6) {
-        date = QDate::fromString(QString::fromLatin1(parts[9]), QStringLiteral("ddMMyy"));
-        if (date.isValid())
-            date = date.addYears(100);     // otherwise starts from 1900
-    }
+    if (parts.size() > 9)
+        QLocationUtils::getNmeaDate(parts[9], &date);
 
     if (parts.size() > 1 && !parts[1].isEmpty())
         QLocationUtils::getNmeaTime(parts[1], &time);
@@ -164,18 +268,18 @@ static void qlocationutils_readRmc(QByteArrayView bv, QGeoPositionInfo *info, bo
     bool parsed = false;
     double value = 0.0;
     if (parts.size() > 7 && !parts[7].isEmpty()) {
-        value = parts[7].toDouble(&parsed);
+        value = qlocationutils_toDouble(parts[7], &parsed);
         if (parsed)
             info->setAttribute(QGeoPositionInfo::GroundSpeed, qreal(value * 1.852 / 3.6));    // knots -> m/s
     }
     if (parts.size() > 8 && !parts[8].isEmpty()) {
-        value = parts[8].toDouble(&parsed);
+        value = qlocationutils_toDouble(parts[8], &parsed);
         if (parsed)
             info->setAttribute(QGeoPositionInfo::Direction, qreal(value));
     }
     if (parts.size() > 11 && parts[11].size() == 1
             && (parts[11][0] == 'E' || parts[11][0] == 'W')) {
-        value = parts[10].toDouble(&parsed);
+        value = qlocationutils_toDouble(parts[10], &parsed);
         if (parsed) {
             if (parts[11][0] == 'W')
                 value *= -1;
@@ -194,17 +298,17 @@ static void qlocationutils_readVtg(QByteArrayView bv, QGeoPositionInfo *info, bo
     if (hasFix)
         *hasFix = false;
 
-    const QList<QByteArray> parts = QByteArray::fromRawData(bv.data(), bv.size()).split(',');
+    const QNmeaFields parts(bv);
 
     bool parsed = false;
     double value = 0.0;
     if (parts.size() > 1 && !parts[1].isEmpty()) {
-        value = parts[1].toDouble(&parsed);
+        value = qlocationutils_toDouble(parts[1], &parsed);
         if (parsed)
             info->setAttribute(QGeoPositionInfo::Direction, qreal(value));
     }
     if (parts.size() > 7 && !parts[7].isEmpty()) {
-        value = parts[7].toDouble(&parsed);
+        value = qlocationutils_toDouble(parts[7], &parsed);
         if (parsed)
             info->setAttribute(QGeoPositionInfo::GroundSpeed, qreal(value / 3.6));    // km/h -> m/s
     }
@@ -215,7 +319,7 @@ static void qlocationutils_readZda(QByteArrayView bv, QGeoPositionInfo *info, bo
     if (hasFix)
         *hasFix = false;
 
-    const QList<QByteArray> parts = QByteArray::fromRawData(bv.data(), bv.size()).split(',');
+    const QNmeaFields parts(bv);
     QDate date;
     QTime time;
 
@@ -236,7 +340,15 @@ static void qlocationutils_readZda(QByteArrayView bv, QGeoPositionInfo *info, bo
 
 QLocationUtils::NmeaSentence QLocationUtils::getNmeaSentenceType(QByteArrayView bv)
 {
-    if (bv.size() < 6 || bv[0] != '$' || !hasValidNmeaChecksum(bv))
+    const NmeaSentence type = getNmeaSentenceTypeUnchecked(bv);
+    if (type == NmeaSentenceInvalid || !hasValidNmeaChecksum(bv))
+        return NmeaSentenceInvalid;
+    return type;
+}
+
+QLocationUtils::NmeaSentence QLocationUtils::getNmeaSentenceTypeUnchecked(QByteArrayView bv)
+{
+    if (bv.size() < 6 || bv[0] != '$')
         return NmeaSentenceInvalid;
 
     QByteArrayView key = bv.sliced(3);
@@ -378,8 +490,7 @@ QLocationUtils::getSatInfoFromNmea(QByteArrayView bv, QList<QGeoSatelliteInfo> &
     // following code.
     qsizetype idx = bv.indexOf('*');
 
-    const QList<QByteArray> parts = QByteArray::fromRawData(bv.data(),
-                                                            idx < 0 ? bv.size() : idx).split(',');
+    const QNmeaFields parts(idx < 0 ? bv : bv.first(idx));
 
     if (parts.size() <= 3) {
         infos.clear();
@@ -404,8 +515,11 @@ QLocationUtils::getSatInfoFromNmea(QByteArrayView bv, QList<QGeoSatelliteInfo> &
         return QNmeaSatelliteInfoSource::FullyParsed; // Malformed sentence.
     }
 
-    if (sentence == 1)
+    if (sentence == 1) {
         infos.clear();
+        // room for the whole epoch; the satellite count of GSV has two digits
+        infos.reserve(qBound(0, totalSats, 99));
+    }
 
     const int numSatInSentence = qMin(sentence * 4, totalSats) - (sentence - 1) * 4;
     if (parts.size() < (4 + numSatInSentence * 4)) {
@@ -415,8 +529,9 @@ QLocationUtils::getSatInfoFromNmea(QByteArrayView bv, QList<QGeoSatelliteInfo> &
 
     int field = 4;
     for (int i = 0; i < numSatInSentence; ++i) {
-        QGeoSatelliteInfo info;
-        info.setSatelliteSystem(system);
+        // Fill in the private directly, instead of detaching on each setter
+        QGeoSatelliteInfoPrivate *d = new QGeoSatelliteInfoPrivate;
+        d->system = system;
         int prn = parts.at(field++).toInt(&ok);
         // Quote from: https://gpsd.gitlab.io/gpsd/NMEA.html#_satellite_ids
         // GLONASS satellite numbers come in two flavors. If a sentence has a GL
@@ -431,14 +546,14 @@ QLocationUtils::getSatInfoFromNmea(QByteArrayView bv, QList<QGeoSatelliteInfo> &
             if (prn <= 64)
                 prn += 64;
         }
-        info.setSatelliteIdentifier((ok) ? prn : 0);
+        d->satId = (ok) ? prn : 0;
         const int elevation = parts.at(field++).toInt(&ok);
-        info.setAttribute(QGeoSatelliteInfo::Elevation, (ok) ? elevation : 0);
+        d->setAttribute(QGeoSatelliteInfo::Elevation, (ok) ? elevation : 0);
         const int azimuth = parts.at(field++).toInt(&ok);
-        info.setAttribute(QGeoSatelliteInfo::Azimuth, (ok) ? azimuth : 0);
+        d->setAttribute(QGeoSatelliteInfo::Azimuth, (ok) ? azimuth : 0);
         const int snr = parts.at(field++).toInt(&ok);
-        info.setSignalStrength((ok) ? snr : -1);
-        infos.append(info);
+        d->signal = (ok) ? snr : -1;
+        infos.emplace_back(*d);
     }
 
     if (sentence == totalSentences)
@@ -501,43 +616,63 @@ QGeoSatelliteInfo::SatelliteSystem QLocationUtils::getSatInUseFromNmea(QByteArra
 
 bool QLocationUtils::hasValidNmeaChecksum(QByteArrayView bv)
 {
-    qsizetype asteriskIndex = bv.indexOf('*');
+    return QNmeaSentenceScanner::hasValidChecksum(bv);
+}
 
-    constexpr qsizetype CSUM_LEN = 2;
-    if (asteriskIndex < 0 || asteriskIndex >= bv.size() - CSUM_LEN)
+bool QLocationUtils::getNmeaTime(QByteArrayView bytes, QTime *time)
+{
+    if (bytes.size() < 6)
         return false;
 
-    // XOR byte value of all characters between '$' and '*'
-    int result = 0;
-    for (qsizetype i = 1; i < asteriskIndex; ++i)
-        result ^= bv[i];
-    /*
-        char calc[CSUM_LEN + 1];
-        ::snprintf(calc, CSUM_LEN + 1, "%02x", result);
-        return ::strncmp(calc, &data[asteriskIndex+1], 2) == 0;
-        */
-
-    QByteArrayView checkSumBytes = bv.sliced(asteriskIndex + 1, 2);
-    bool ok = false;
-    int checksum = checkSumBytes.toInt(&ok,16);
-    return ok && checksum == result;
+    const int hour = qlocationutils_twoDigits(bytes, 0);
+    const int minute = qlocationutils_twoDigits(bytes, 2);
+    const int second = qlocationutils_twoDigits(bytes, 4);
+    if (hour < 0 || minute < 0 || second < 0)
+        return false;
+
+    // Up to three fractional digits, read as a fraction of the second, so
+    // "5" is 500 ms.
+    int msec = 0;
+    if (bytes.size() > 6) {
+        const QByteArrayView fraction = bytes.sliced(7);
+        if (bytes[6] != '.' || fraction.isEmpty() || fraction.size() > 3)
+            return false;
+        int scale = 100;
+        for (const char c : fraction) {
+            if (!QtMiscUtils::isAsciiDigit(c))
+                return false;
+            msec += (c - '0') * scale;
+            scale /= 10;
+        }
+    }
+
+    if (!QTime::isValid(hour, minute, second, msec))
+        return false;
+
+    *time = QTime(hour, minute, second, msec);
+    return true;
 }
 
-bool QLocationUtils::getNmeaTime(const QByteArray &bytes, QTime *time)
+bool QLocationUtils::getNmeaDate(QByteArrayView bytes, QDate *date)
 {
-    QTime tempTime = QTime::fromString(QString::fromLatin1(bytes),
-                        QStringView(bytes.size() > 6 && bytes[6] == '.'
-                                                       ? u"hhmmss.z"
-                                                       : u"hhmmss"));
+    if (bytes.size() != 6)
+        return false;
 
-    if (tempTime.isValid()) {
-        *time = tempTime;
-        return true;
-    }
-    return false;
+    const int day = qlocationutils_twoDigits(bytes, 0);
+    const int month = qlocationutils_twoDigits(bytes, 2);
+    const int year = qlocationutils_twoDigits(bytes, 4);
+    if (day < 0 || month < 0 || year < 0)
+        return false;
+
+    const QDate tempDate(2000 + year, month, day);
+    if (!tempDate.isValid())
+        return false;
+
+    *date = tempDate;
+    return true;
 }
 
-bool QLocationUtils::getNmeaLatLong(const QByteArray &latString, char latDirection, const QByteArray &lngString, char lngDirection, double *lat, double *lng)
+bool QLocationUtils::getNmeaLatLong(QByteArrayView latString, char latDirection, QByteArrayView lngString, char lngDirection, double *lat, double *lng)
 {
     if ((latDirection != 'N' && latDirection != 'S')
             || (lngDirection != 'E' && lngDirection != 'W')) {
@@ -546,8 +681,8 @@ bool QLocationUtils::getNmeaLatLong(const QByteArray &latString, char latDirecti
 
     bool hasLat = false;
     bool hasLong = false;
-    double tempLat = latString.toDouble(&hasLat);
-    double tempLng = lngString.toDouble(&hasLong);
+    double tempLat = qlocationutils_toDouble(latString, &hasLat);
+    double tempLng = qlocationutils_toDouble(lngString, &hasLong);
     if (hasLat && hasLong) {
         tempLat = qlocationutils_nmeaDegreesToDecimal(tempLat);
         if (latDirection == 'S')
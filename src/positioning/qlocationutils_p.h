@@ -27,6 +27,7 @@ static const double rightOffset = 180.0 - offsetEpsilon;
 
 QT_BEGIN_NAMESPACE
 class QTime;
+class QDate;
 class QByteArray;
 
 class QGeoPositionInfo;
@@ -241,6 +242,11 @@ public:
     */
     static NmeaSentence getNmeaSentenceType(QByteArrayView bv);
 
+    /*
+        returns the NMEA sentence type, without checking the checksum.
+    */
+    static NmeaSentence getNmeaSentenceTypeUnchecked(QByteArrayView bv);
+
     /*
         Returns the satellite system type based on the message type.
         See https://gpsd.gitlab.io/gpsd/NMEA.html#_talker_ids for reference
@@ -294,15 +300,21 @@ public:
     /*
         Returns time from a string in hhmmss or hhmmss.z+ format.
     */
-    static bool getNmeaTime(const QByteArray &bytes, QTime *time);
+    static bool getNmeaTime(QByteArrayView bytes, QTime *time);
+
+    /*
+        Returns date from a string in ddmmyy format. The two-digit year is
+        assumed to be after the year 2000.
+    */
+    static bool getNmeaDate(QByteArrayView bytes, QDate *date);
 
     /*
         Accepts for example ("2734.7964", 'S', "15306.0124", 'E') and returns the
         lat-long values. Fails if lat or long fail isValidLat() or isValidLong().
     */
-    static bool getNmeaLatLong(const QByteArray &latString,
+    static bool getNmeaLatLong(QByteArrayView latString,
                                char latDirection,
-                               const QByteArray &lngString,
+                               QByteArrayView lngString,
                                char lngDirection,
                                double *lat,
                                double *lon);
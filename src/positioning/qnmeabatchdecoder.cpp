@@ -0,0 +1,233 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+#include "qnmeabatchdecoder_p.h"
+#include "qlocationutils_p.h"
+#include "qnmeasentencescanner_p.h"
+
+#include <QtCore/QFileDevice>
+#include <QtCore/QThread>
+#include <QtCore/QThreadPool>
+#include <QtCore/QVarLengthArray>
+
+#include <limits>
+#include <utility>
+
+QT_BEGIN_NAMESPACE
+
+QNmeaBatchDecoder::QNmeaBatchDecoder(double userEquivalentRangeError)
+    : m_userEquivalentRangeError(userEquivalentRangeError)
+{
+}
+
+/*
+    Decodes the complete NMEA data in \a data and returns the resulting
+    position updates.
+*/
+QList<QGeoPositionInfo> QNmeaBatchDecoder::decode(QByteArrayView data)
+{
+    addData(data);
+    finish();
+    return takePositions();
+}
+
+/*
+    Decodes the NMEA data from the current position of \a file to its end.
+    The file is memory-mapped if possible, and read in chunks otherwise.
+*/
+QList<QGeoPositionInfo> QNmeaBatchDecoder::decode(QFileDevice *file)
+{
+    if (!file->isOpen() && !file->open(QIODevice::ReadOnly))
+        return {};
+
+    const qint64 offset = file->pos();
+    const qint64 size = file->size() - offset;
+    if (size > 0 && size <= std::numeric_limits<qsizetype>::max()) {
+        if (uchar *data = file->map(offset, size)) {
+            addData(QByteArrayView(data, qsizetype(size)));
+            file->unmap(data);
+            finish();
+            return takePositions();
+        }
+    }
+
+    constexpr qint64 chunkSize = 1024 * 1024;
+    while (!file->atEnd()) {
+        const QByteArray chunk = file->read(chunkSize);
+        if (chunk.isEmpty())
+            break;
+        addData(chunk);
+    }
+    finish();
+    return takePositions();
+}
+
+/*
+    Sets the number of threads used to parse large amounts of data to
+    \a threadCount. A value smaller than one means QThread::idealThreadCount().
+*/
+void QNmeaBatchDecoder::setThreadCount(int threadCount)
+{
+    m_threadCount = threadCount > 0 ? threadCount : QThread::idealThreadCount();
+}
+
+/*
+    Decodes all complete sentences in \a data. An incomplete sentence at the
+    end is kept and completed by the next call.
+*/
+void QNmeaBatchDecoder::addData(QByteArrayView data)
+{
+    qsizetype from = 0;
+    if (!m_partialLine.isEmpty()) {
+        const qsizetype end = data.indexOf('\n');
+        if (end < 0) {
+            m_partialLine.append(data);
+            return;
+        }
+        m_partialLine.append(data.first(end + 1));
+        addLines(m_partialLine);
+        m_partialLine.clear();
+        from = end + 1;
+    }
+
+    const qsizetype end = data.lastIndexOf('\n');
+    if (end >= from) {
+        addLines(data.sliced(from, end + 1 - from));
+        from = end + 1;
+    }
+
+    if (from < data.size())
+        m_partialLine.append(data.sliced(from));
+}
+
+/*
+    Decodes a trailing sentence without line break, if any, and pushes the
+    last epoch.
+*/
+void QNmeaBatchDecoder::finish()
+{
+    if (!m_partialLine.isEmpty()) {
+        addLines(m_partialLine);
+        m_partialLine.clear();
+    }
+    m_merger.flush([this](QGeoPositionInfo *update, bool hasFix) {
+        pushUpdate(update, hasFix);
+    });
+}
+
+QList<QGeoPositionInfo> QNmeaBatchDecoder::takePositions()
+{
+    return std::exchange(m_positions, {});
+}
+
+template <typename Function>
+static void qnmeabatchdecoder_forEachLine(QByteArrayView lines, Function function)
+{
+    const qsizetype consumed = QNmeaSentenceScanner::scanSentences(lines, function);
+    if (consumed < lines.size())
+        function(lines.sliced(consumed));
+}
+
+// returns the first lines of \a lines, with a total size of at least \a size
+static QByteArrayView qnmeabatchdecoder_firstLines(QByteArrayView lines, qsizetype size)
+{
+    if (size >= lines.size())
+        return lines;
+    const qsizetype end = lines.indexOf('\n', qMax(size - 1, qsizetype(0)));
+    return end < 0 ? lines : lines.first(end + 1);
+}
+
+bool QNmeaBatchDecoder::parseSentence(QByteArrayView sentence, ParsedSentence *parsed) const
+{
+    parsed->info = QGeoPositionInfo();
+    parsed->sentence = sentence;
+    return QLocationUtils::getPosInfoFromNmea(sentence, &parsed->info,
+                                              m_userEquivalentRangeError, &parsed->hasFix);
+}
+
+QList<QNmeaBatchDecoder::ParsedSentence> QNmeaBatchDecoder::parseLines(QByteArrayView lines) const
+{
+    QList<ParsedSentence> result;
+    result.reserve(lines.size() / 64);
+    qnmeabatchdecoder_forEachLine(lines, [&](QByteArrayView line) {
+        ParsedSentence parsed;
+        if (parseSentence(line, &parsed))
+            result.append(std::move(parsed));
+    });
+    return result;
+}
+
+void QNmeaBatchDecoder::addLines(QByteArrayView lines)
+{
+    // below this, starting the threads costs more than it saves
+    constexpr qsizetype minParallelSize = 256 * 1024;
+    if (m_threadCount > 1 && lines.size() >= minParallelSize) {
+        addLinesInParallel(lines);
+        return;
+    }
+
+    qnmeabatchdecoder_forEachLine(lines, [this](QByteArrayView line) {
+        ParsedSentence parsed;
+        if (parseSentence(line, &parsed))
+            addParsedSentence(parsed);
+    });
+}
+
+void QNmeaBatchDecoder::addLinesInParallel(QByteArrayView lines)
+{
+    // The data is handled in rounds, so that the number of parsed but not yet
+    // merged sentences stays bounded for huge inputs.
+    constexpr qsizetype chunkSize = 1024 * 1024;
+
+    QThreadPool pool;
+    pool.setMaxThreadCount(m_threadCount);
+
+    while (!lines.isEmpty()) {
+        const QByteArrayView round = qnmeabatchdecoder_firstLines(lines, chunkSize * m_threadCount);
+        const qsizetype roundChunkSize = (round.size() + m_threadCount - 1) / m_threadCount;
+
+        QVarLengthArray<QByteArrayView, 16> chunks;
+        for (QByteArrayView rest = round; !rest.isEmpty(); ) {
+            const QByteArrayView chunk = qnmeabatchdecoder_firstLines(rest, roundChunkSize);
+            chunks.append(chunk);
+            rest = rest.sliced(chunk.size());
+        }
+
+        QList<QList<ParsedSentence>> results(chunks.size());
+        QList<ParsedSentence> *resultData = results.data();
+        for (qsizetype i = 0; i < chunks.size(); ++i) {
+            const QByteArrayView chunk = chunks.at(i);
+            pool.start([this, chunk, result = resultData + i] {
+                *result = parseLines(chunk);
+            });
+        }
+        pool.waitForDone();
+
+        // Fusing the epochs depends on the order of the sentences, so it is
+        // done sequentially, chunk by chunk.
+        for (QList<ParsedSentence> &result : results) {
+            for (ParsedSentence &parsed : result)
+                addParsedSentence(parsed);
+        }
+
+        lines = lines.sliced(round.size());
+    }
+}
+
+void QNmeaBatchDecoder::addParsedSentence(ParsedSentence &parsed)
+{
+    ++m_sentenceCount;
+    m_merger.addPosition(std::move(parsed.info), parsed.hasFix, parsed.sentence,
+                         [this](QGeoPositionInfo *update, bool hasFix) {
+        pushUpdate(update, hasFix);
+    });
+}
+
+void QNmeaBatchDecoder::pushUpdate(QGeoPositionInfo *update, bool hasFix)
+{
+    // Same filtering as QNmeaPositionInfoSourcePrivate::notifyNewUpdate()
+    m_completer.complete(update);
+    if (hasFix && update->isValid())
+        m_positions.append(*update);
+}
+
+QT_END_NAMESPACE
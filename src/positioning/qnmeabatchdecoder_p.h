@@ -0,0 +1,86 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+#ifndef QNMEABATCHDECODER_P_H
+#define QNMEABATCHDECODER_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtPositioning/private/qpositioningglobal_p.h>
+#include <QtPositioning/private/qnmeaepochmerger_p.h>
+#include <QtPositioning/qgeopositioninfo.h>
+
+#include <QtCore/QByteArray>
+#include <QtCore/QByteArrayView>
+#include <QtCore/QList>
+#include <QtCore/qnumeric.h>
+
+QT_BEGIN_NAMESPACE
+
+class QFileDevice;
+
+/*
+    Synchronously decodes recorded NMEA data into the position updates a
+    QNmeaPositionInfoSource in RealTimeMode would emit for it, without any
+    event loop, timer or signal involved.
+
+    Data can be passed in one go with decode(), or in arbitrary pieces with
+    addData(), followed by finish() once the end of the data is reached.
+
+    With a thread count larger than one, large amounts of data are split at
+    sentence boundaries and the sentences are parsed on several threads. The
+    parsed sentences are then fused into epochs in their original order, so the
+    result is exactly the same as with sequential decoding.
+*/
+class Q_POSITIONING_EXPORT QNmeaBatchDecoder
+{
+public:
+    explicit QNmeaBatchDecoder(double userEquivalentRangeError = qQNaN());
+
+    QList<QGeoPositionInfo> decode(QByteArrayView data);
+    QList<QGeoPositionInfo> decode(QFileDevice *file);
+
+    void addData(QByteArrayView data);
+    void finish();
+    QList<QGeoPositionInfo> takePositions();
+
+    qsizetype sentenceCount() const { return m_sentenceCount; }
+
+    void setThreadCount(int threadCount);
+    int threadCount() const { return m_threadCount; }
+
+private:
+    struct ParsedSentence
+    {
+        QGeoPositionInfo info;
+        QByteArrayView sentence;
+        bool hasFix = false;
+    };
+
+    bool parseSentence(QByteArrayView sentence, ParsedSentence *parsed) const;
+    QList<ParsedSentence> parseLines(QByteArrayView lines) const;
+    void addLines(QByteArrayView lines);
+    void addLinesInParallel(QByteArrayView lines);
+    void addParsedSentence(ParsedSentence &parsed);
+    void pushUpdate(QGeoPositionInfo *update, bool hasFix);
+
+    double m_userEquivalentRangeError;
+    int m_threadCount = 1;
+    QNmeaEpochMerger m_merger;
+    QNmeaUpdateCompleter m_completer;
+    QList<QGeoPositionInfo> m_positions;
+    QByteArray m_partialLine;
+    qsizetype m_sentenceCount = 0;
+};
+
+QT_END_NAMESPACE
+
+#endif // QNMEABATCHDECODER_P_H
@@ -0,0 +1,296 @@
+// Copyright (C) 2016 Jolla Ltd.
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+#include "qnmeaepochmerger_p.h"
+
+#include <QtCore/QTimeZone>
+#include <QtCore/QtNumeric>
+
+#include <array>
+
+QT_BEGIN_NAMESPACE
+
+QGeoPositionInfoPrivateNmea::QGeoPositionInfoPrivateNmea()
+{
+    hasNmeaSentences = true;
+}
+
+QGeoPositionInfoPrivateNmea::QGeoPositionInfoPrivateNmea(const QGeoPositionInfoPrivate &other)
+    : QGeoPositionInfoPrivate(other)
+{
+    hasNmeaSentences = true;
+}
+
+QGeoPositionInfoPrivateNmea::QGeoPositionInfoPrivateNmea(const QGeoPositionInfoPrivateNmea &other)
+    : QGeoPositionInfoPrivate(other),
+      nmeaData(other.nmeaData),
+      nmeaSentenceEnds(other.nmeaSentenceEnds)
+{
+    hasNmeaSentences = true;
+}
+
+QGeoPositionInfoPrivateNmea::~QGeoPositionInfoPrivateNmea()
+{
+
+}
+
+QGeoPositionInfoPrivate *QGeoPositionInfoPrivateNmea::clone() const
+{
+    return new QGeoPositionInfoPrivateNmea(*this);
+}
+
+QGeoPositionInfoPrivateNmea *QGeoPositionInfoPrivateNmea::get(const QGeoPositionInfo &info)
+{
+    QGeoPositionInfoPrivate *d = QGeoPositionInfoPrivate::get(info);
+    return d && d->hasNmeaSentences ? static_cast<QGeoPositionInfoPrivateNmea *>(d) : nullptr;
+}
+
+void QGeoPositionInfoPrivateNmea::appendNmeaSentence(QByteArrayView sentence)
+{
+    // Room for all sentences of a typical epoch, so that only the first one
+    // allocates.
+    constexpr qsizetype TypicalEpochSize = 1024;
+    if (nmeaData.capacity() == 0)
+        nmeaData.reserve(qMax(TypicalEpochSize, sentence.size()));
+    nmeaData.append(sentence);
+    nmeaSentenceEnds.append(nmeaData.size());
+}
+
+QByteArrayView QGeoPositionInfoPrivateNmea::nmeaSentence(qsizetype i) const
+{
+    const qsizetype begin = i > 0 ? nmeaSentenceEnds.at(i - 1) : 0;
+    return QByteArrayView(nmeaData).sliced(begin, nmeaSentenceEnds.at(i) - begin);
+}
+
+bool QNmeaEpochMerger::propagateCoordinate(QGeoPositionInfo &dst, const QGeoPositionInfo &src,
+                                           bool force)
+{
+    bool updated = false;
+    QGeoCoordinate c = dst.coordinate();
+    const QGeoCoordinate & srcCoordinate = src.coordinate();
+    if (qIsFinite(src.coordinate().latitude())
+            && (!qIsFinite(dst.coordinate().latitude()) || force)) {
+        updated |= (c.latitude() != srcCoordinate.latitude());
+        c.setLatitude(src.coordinate().latitude());
+    }
+    if (qIsFinite(src.coordinate().longitude())
+            && (!qIsFinite(dst.coordinate().longitude()) || force)) {
+        updated |= (c.longitude() != srcCoordinate.longitude());
+        c.setLongitude(src.coordinate().longitude());
+    }
+    if (qIsFinite(src.coordinate().altitude())
+            && (!qIsFinite(dst.coordinate().altitude()) || force)) {
+        updated |= (c.altitude() != srcCoordinate.altitude());
+        c.setAltitude(src.coordinate().altitude());
+    }
+    dst.setCoordinate(c);
+    return updated;
+}
+
+bool QNmeaEpochMerger::propagateDate(QGeoPositionInfo &dst, const QGeoPositionInfo &src)
+{
+    if (!dst.timestamp().date().isValid() && src.timestamp().isValid()) { // time was supposed to be set/the same already. Date can be overwritten.
+        dst.setTimestamp(src.timestamp());
+        return true;
+    }
+    return false;
+}
+
+bool QNmeaEpochMerger::propagateAttributes(QGeoPositionInfo &dst, const QGeoPositionInfo &src,
+                                           bool force)
+{
+    bool updated = false;
+    static Q_DECL_CONSTEXPR std::array<QGeoPositionInfo::Attribute, 6> attrs {
+                                                { QGeoPositionInfo::GroundSpeed
+                                                 ,QGeoPositionInfo::HorizontalAccuracy
+                                                 ,QGeoPositionInfo::VerticalAccuracy
+                                                 ,QGeoPositionInfo::Direction
+                                                 ,QGeoPositionInfo::VerticalSpeed
+                                                 ,QGeoPositionInfo::MagneticVariation} };
+    for (const auto a: attrs) {
+        if (src.hasAttribute(a) && (!dst.hasAttribute(a) || force)) {
+            updated |= (dst.attribute(a) != src.attribute(a));
+            dst.setAttribute(a, src.attribute(a));
+        }
+    }
+
+    return updated;
+}
+
+// returns false if src does not contain any additional or different data than dst,
+// true otherwise.
+bool QNmeaEpochMerger::mergePositions(QGeoPositionInfo &dst, const QGeoPositionInfo &src,
+                                      QByteArrayView nmeaSentence)
+{
+    bool updated = false;
+
+    updated |= propagateCoordinate(dst, src);
+    updated |= propagateDate(dst, src);
+    updated |= propagateAttributes(dst, src);
+
+    if (QGeoPositionInfoPrivateNmea::get(dst))
+        keepSentence(dst, nmeaSentence);
+    return updated;
+}
+
+void QNmeaEpochMerger::keepSentence(QGeoPositionInfo &update, QByteArrayView sentence)
+{
+    update.detach(); // copies handed out before keep their sentences
+    QGeoPositionInfoPrivateNmea *d = QGeoPositionInfoPrivateNmea::get(update);
+    if (!d) {
+        d = new QGeoPositionInfoPrivateNmea(*QGeoPositionInfoPrivate::get(update));
+        update = QGeoPositionInfo(*d);
+    }
+    d->appendNmeaSentence(sentence);
+}
+
+QList<QByteArrayView> QNmeaEpochMerger::keptSentences(const QGeoPositionInfo &update)
+{
+    QList<QByteArrayView> sentences;
+    if (const QGeoPositionInfoPrivateNmea *d = QGeoPositionInfoPrivateNmea::get(update)) {
+        sentences.reserve(d->nmeaSentenceCount());
+        for (qsizetype i = 0; i < d->nmeaSentenceCount(); ++i)
+            sentences.append(d->nmeaSentence(i));
+    }
+    return sentences;
+}
+
+QNmeaEpochMerger::QNmeaEpochMerger()
+{
+}
+
+bool QNmeaEpochMerger::addPosition(QGeoPositionInfo pos, bool hasFix, QByteArrayView sentence,
+                                   UpdateCallback pushUpdate)
+{
+    const QTime infoTime = m_update.timestamp().time(); // if update has been set, time must be valid.
+    const QDate infoDate = m_update.timestamp().date(); // this one might not be valid, as some sentences do not contain it
+
+    const bool oldFix = m_hasFix;
+    m_hasFix |= hasFix;
+
+    // Date may or may not be valid, as some packets do not have date.
+    // If date isn't valid, match is performed on time only.
+    // Hence, make sure that packet blocks are generated with
+    // the sentences containing the full timestamp (e.g., GPRMC) *first* !
+    if (infoTime.isValid()) {
+        if (pos.timestamp().time().isValid()) {
+            const bool newerTime = infoTime < pos.timestamp().time();
+            const bool newerDate = (infoDate.isValid() // if time is valid but one date or both are not,
+                                    && pos.timestamp().date().isValid()
+                                    && infoDate < pos.timestamp().date());
+            if (newerTime || newerDate) {
+                // Effectively read data for different update, that is also newer,
+                // so flush retained update, and copy the new pos into m_update
+                const QDate updateDate = m_update.timestamp().date();
+                const QDate lastPushedDate = m_lastPushedTS.date();
+                const bool newerTimestampSinceLastPushed = m_update.timestamp() > m_lastPushedTS;
+                const bool invalidDate = !(updateDate.isValid() && lastPushedDate.isValid());
+                const bool newerTimeSinceLastPushed = m_update.timestamp().time() > m_lastPushedTS.time();
+                if (newerTimestampSinceLastPushed || (invalidDate && newerTimeSinceLastPushed)) {
+                    pushUpdate(&m_update, oldFix);
+                    m_lastPushedTS = m_update.timestamp();
+                }
+                // next update data
+                if (m_keepSentences)
+                    keepSentence(pos, sentence);
+                if (m_changedSincePush)
+                    propagateCoordinate(pos, m_update, false);
+                propagateAttributes(pos, m_update, false);
+                m_update = std::move(pos);
+                m_hasFix = hasFix;
+                m_pushed = false;
+                m_changedSincePush = false;
+                return true;
+            } else if (infoTime == pos.timestamp().time()) {
+                // timestamps match -- merge into m_update
+                if (mergePositions(m_update, pos, sentence) || m_hasFix != oldFix)
+                    m_changedSincePush = m_pushed;
+            }
+            // else discard out of order outdated info.
+        } else {
+            // no timestamp available in parsed update-- merge into m_update
+            if (mergePositions(m_update, pos, sentence) || m_hasFix != oldFix)
+                m_changedSincePush = m_pushed;
+        }
+    } else {
+        // there was no info with valid TS. Overwrite with whatever is parsed.
+        if (m_keepSentences)
+            keepSentence(pos, sentence);
+        const bool hasTime = pos.timestamp().time().isValid();
+        propagateAttributes(pos, m_update);
+        m_update = std::move(pos);
+        m_pushed = false;
+        m_changedSincePush = false;
+        return hasTime;
+    }
+    return false;
+}
+
+void QNmeaEpochMerger::flush(UpdateCallback pushUpdate)
+{
+    const bool newerTime = m_update.timestamp().time() > m_lastPushedTS.time();
+    const bool newerDate = (m_update.timestamp().date().isValid()
+                            && m_lastPushedTS.date().isValid()
+                            && m_update.timestamp().date() > m_lastPushedTS.date());
+    if (newerTime || newerDate) {
+        pushUpdate(&m_update, m_hasFix);
+        m_lastPushedTS = m_update.timestamp();
+        m_pushed = true;
+        m_changedSincePush = false;
+    }
+}
+
+static quint32 qnmeaepochmerger_sentenceType(QByteArrayView sentence)
+{
+    // "$GPGGA," -> "GGA"
+    if (sentence.size() < 6)
+        return 0;
+    return quint32(quint8(sentence.at(3))) << 16 | quint32(quint8(sentence.at(4))) << 8
+            | quint32(quint8(sentence.at(5)));
+}
+
+bool QNmeaEpochPattern::addSentence(QByteArrayView sentence, bool newEpoch)
+{
+    if (newEpoch) {
+        m_learned = !m_current.isEmpty() && m_current == m_previous;
+        m_previous = m_current;
+        m_current.clear();
+    }
+    m_current.append(qnmeaepochmerger_sentenceType(sentence));
+    if (!m_learned)
+        return false;
+
+    const qsizetype i = m_current.size() - 1;
+    if (i >= m_previous.size() || m_current.at(i) != m_previous.at(i)) {
+        m_learned = false;
+        return false;
+    }
+    return i == m_previous.size() - 1;
+}
+
+void QNmeaUpdateCompleter::complete(QGeoPositionInfo *update)
+{
+    QDate date = update->timestamp().date();
+    if (date.isValid()) {
+        m_currentDate = date;
+    } else {
+        // some sentence have time but no date
+        QTime time = update->timestamp().time();
+        if (time.isValid() && m_currentDate.isValid())
+            update->setTimestamp(QDateTime(m_currentDate, time, QTimeZone::UTC));
+    }
+
+    // Some attributes are sent in separate NMEA sentences. Save and restore the accuracy
+    // measurements.
+    if (update->hasAttribute(QGeoPositionInfo::HorizontalAccuracy))
+        m_horizontalAccuracy = update->attribute(QGeoPositionInfo::HorizontalAccuracy);
+    else if (!qIsNaN(m_horizontalAccuracy))
+        update->setAttribute(QGeoPositionInfo::HorizontalAccuracy, m_horizontalAccuracy);
+
+    if (update->hasAttribute(QGeoPositionInfo::VerticalAccuracy))
+        m_verticalAccuracy = update->attribute(QGeoPositionInfo::VerticalAccuracy);
+    else if (!qIsNaN(m_verticalAccuracy))
+        update->setAttribute(QGeoPositionInfo::VerticalAccuracy, m_verticalAccuracy);
+}
+
+QT_END_NAMESPACE
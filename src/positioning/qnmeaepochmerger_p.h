@@ -0,0 +1,163 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+#ifndef QNMEAEPOCHMERGER_P_H
+#define QNMEAEPOCHMERGER_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtPositioning/private/qpositioningglobal_p.h>
+#include <QtPositioning/private/qgeopositioninfo_p.h>
+#include <QtPositioning/qgeopositioninfo.h>
+
+#include <QtCore/QByteArray>
+#include <QtCore/QByteArrayView>
+#include <QtCore/QDate>
+#include <QtCore/QDateTime>
+#include <QtCore/QList>
+#include <QtCore/QVarLengthArray>
+#include <QtCore/qnumeric.h>
+#include <QtCore/qxpfunctional.h>
+
+QT_BEGIN_NAMESPACE
+
+// The default of QNmeaEpochMerger::setKeepSentences(), and of the
+// QNmeaPositionInfoSource::KeepSentences backend property. Builds can define it
+// to 1 to keep the raw sentences of all the updates of the NMEA sources.
+#ifndef QT_NMEA_EPOCH_MERGER_KEEP_SENTENCES
+#  define QT_NMEA_EPOCH_MERGER_KEEP_SENTENCES 0
+#endif
+
+/*
+    Keeps the raw sentences an update was fused from. They are stored back to
+    back in one buffer per epoch, and handed out as slices of it, so that
+    adding a sentence does not allocate unless the buffer is full. Copies of
+    the update share the buffer.
+*/
+class QGeoPositionInfoPrivateNmea : public QGeoPositionInfoPrivate
+{
+public:
+    QGeoPositionInfoPrivateNmea();
+    explicit QGeoPositionInfoPrivateNmea(const QGeoPositionInfoPrivate &other);
+    QGeoPositionInfoPrivateNmea(const QGeoPositionInfoPrivateNmea &other);
+    ~QGeoPositionInfoPrivateNmea() override;
+    QGeoPositionInfoPrivate *clone() const override;
+
+    // Returns the private data of info if it keeps sentences, or nullptr
+    static QGeoPositionInfoPrivateNmea *get(const QGeoPositionInfo &info);
+
+    void appendNmeaSentence(QByteArrayView sentence);
+    qsizetype nmeaSentenceCount() const { return nmeaSentenceEnds.size(); }
+    QByteArrayView nmeaSentence(qsizetype i) const;
+
+    QByteArray nmeaData;
+    QVarLengthArray<qsizetype, 8> nmeaSentenceEnds;
+};
+
+/*
+    Fuses the positions parsed from consecutive NMEA sentences into one update
+    per epoch, the way QNmeaPositionInfoSource does it in RealTimeMode.
+
+    Sentences with the same timestamp, or without any timestamp, are merged
+    into the pending update. Once a sentence with a newer timestamp arrives
+    the pending update is handed to the callback, unless it is not newer than
+    the last update handed out.
+
+    flush() hands out the pending update before the next epoch starts. Every
+    epoch is handed out only once: sentences with the same timestamp that
+    arrive after that are folded into the next epoch instead, which takes the
+    parts of the coordinate it lacks from them, as it takes its missing
+    attributes from the previous epoch.
+
+    addPosition() returns true if the position started a new epoch.
+
+    With setKeepSentences(true), the updates also carry the raw sentences
+    they were fused from, see keptSentences().
+*/
+class Q_POSITIONING_EXPORT QNmeaEpochMerger
+{
+public:
+    using UpdateCallback = qxp::function_ref<void(QGeoPositionInfo *update, bool hasFix)>;
+
+    QNmeaEpochMerger();
+
+    bool addPosition(QGeoPositionInfo pos, bool hasFix, QByteArrayView sentence,
+                     UpdateCallback pushUpdate);
+    void flush(UpdateCallback pushUpdate);
+
+    const QGeoPositionInfo &pendingUpdate() const { return m_update; }
+    bool pendingHasFix() const { return m_hasFix; }
+
+    void setKeepSentences(bool keep) { m_keepSentences = keep; }
+    bool keepsSentences() const { return m_keepSentences; }
+    // Adds sentence to the raw sentences of update, which keeps them from now on
+    static void keepSentence(QGeoPositionInfo &update, QByteArrayView sentence);
+    // The views are valid as long as update is not changed or destroyed
+    static QList<QByteArrayView> keptSentences(const QGeoPositionInfo &update);
+
+    static bool propagateCoordinate(QGeoPositionInfo &dst, const QGeoPositionInfo &src,
+                                    bool force = true);
+    static bool propagateDate(QGeoPositionInfo &dst, const QGeoPositionInfo &src);
+    static bool propagateAttributes(QGeoPositionInfo &dst, const QGeoPositionInfo &src,
+                                    bool force = true);
+    static bool mergePositions(QGeoPositionInfo &dst, const QGeoPositionInfo &src,
+                               QByteArrayView nmeaSentence);
+
+private:
+    QGeoPositionInfo m_update;
+    QDateTime m_lastPushedTS;
+    bool m_hasFix = false;
+    bool m_pushed = false; // m_update was handed out by flush()
+    bool m_changedSincePush = false; // folded into the next epoch
+    bool m_keepSentences = QT_NMEA_EPOCH_MERGER_KEEP_SENTENCES;
+};
+
+/*
+    Learns the order of the sentence types a receiver sends in every epoch,
+    so that the end of an epoch can be recognized from its last sentence,
+    instead of from the first sentence of the next one. The talker is
+    ignored, so $GPGGA and $GNGGA count as the same type.
+
+    The order counts as learned once two consecutive epochs followed it.
+    A sentence that does not fit the learned order forgets it again.
+*/
+class Q_POSITIONING_EXPORT QNmeaEpochPattern
+{
+public:
+    // Returns true if sentence is the last one of the learned epoch
+    bool addSentence(QByteArrayView sentence, bool newEpoch);
+    bool isLearned() const { return m_learned; }
+
+private:
+    using Sequence = QVarLengthArray<quint32, 8>;
+    Sequence m_current;
+    Sequence m_previous;
+    bool m_learned = false;
+};
+
+/*
+    Completes fused updates with the data that NMEA receivers only report in
+    some of the epochs: the date, and the horizontal and vertical accuracy.
+*/
+class Q_POSITIONING_EXPORT QNmeaUpdateCompleter
+{
+public:
+    void complete(QGeoPositionInfo *update);
+
+private:
+    QDate m_currentDate;
+    qreal m_horizontalAccuracy = qQNaN();
+    qreal m_verticalAccuracy = qQNaN();
+};
+
+QT_END_NAMESPACE
+
+#endif // QNMEAEPOCHMERGER_P_H
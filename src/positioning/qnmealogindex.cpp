@@ -0,0 +1,261 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+#include "qnmealogindex_p.h"
+#include "qlocationutils_p.h"
+#include "qnmeasentencescanner_p.h"
+
+#include <QtCore/QDataStream>
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <QtCore/QSaveFile>
+#include <QtCore/QTimeZone>
+#include <QtPositioning/QGeoPositionInfo>
+
+#include <algorithm>
+#include <functional>
+
+QT_BEGIN_NAMESPACE
+
+using namespace Qt::StringLiterals;
+
+static constexpr quint32 qnmealogindex_magic = 0x514e4d49; // "QNMI"
+static constexpr quint32 qnmealogindex_version = 1;
+
+/*
+    Returns the time of \a sentence in milliseconds since the epoch, or -1 if
+    it has none. Sentences with only a time take the date from \a date, which
+    is updated by the sentences that have one.
+*/
+static qint64 qnmealogindex_timestamp(QByteArrayView sentence, QDate *date)
+{
+    // the checksum is checked by getPosInfoFromNmea()
+    switch (QLocationUtils::getNmeaSentenceTypeUnchecked(sentence)) {
+    case QLocationUtils::NmeaSentenceGGA:
+    case QLocationUtils::NmeaSentenceGLL:
+    case QLocationUtils::NmeaSentenceRMC:
+    case QLocationUtils::NmeaSentenceZDA:
+        break;
+    default:
+        return -1;
+    }
+
+    QGeoPositionInfo info;
+    bool hasFix = false;
+    if (!QLocationUtils::getPosInfoFromNmea(sentence, &info, qQNaN(), &hasFix))
+        return -1;
+
+    const QDateTime timestamp = info.timestamp();
+    if (timestamp.date().isValid())
+        *date = timestamp.date();
+    if (!date->isValid() || !timestamp.time().isValid())
+        return -1;
+    return QDateTime(*date, timestamp.time(), QTimeZone::UTC).toMSecsSinceEpoch();
+}
+
+/*
+    Returns where \a sentence starts relative to \a data, the chunk in which
+    the scanner found it. A sentence completed by the beginning of the chunk
+    started in an earlier one, at a negative offset.
+*/
+static qint64 qnmealogindex_offsetInChunk(QByteArrayView data, QByteArrayView sentence)
+{
+    const std::less<const char *> less;
+    if (!less(sentence.data(), data.data()) && less(sentence.data(), data.data() + data.size()))
+        return sentence.data() - data.data();
+    return data.indexOf('\n') + 1 - sentence.size();
+}
+
+void QNmeaLogIndex::clear()
+{
+    m_entries.clear();
+    m_logSize = -1;
+    m_logFileName.clear();
+    m_logModified = 0;
+}
+
+/*
+    Makes the index match the log in \a device, reusing the index it already
+    has or the sidecar of a QFile when the log has the same name, size and
+    modification time. The sidecar is only written with \a saveSidecar, when
+    the index had to be built.
+*/
+bool QNmeaLogIndex::open(QIODevice *device, bool saveSidecar)
+{
+    if (!device || device->isSequential())
+        return false;
+
+    const auto *file = qobject_cast<QFile *>(device);
+    const QString fileName = file ? file->fileName() : QString();
+    const qint64 modified = fileName.isEmpty()
+            ? 0 : QFileInfo(fileName).lastModified().toMSecsSinceEpoch();
+    if (m_logSize >= 0 && m_logSize == device->size() && m_logFileName == fileName
+        && m_logModified == modified) {
+        return true;
+    }
+
+    if (!fileName.isEmpty() && load(fileName) && m_logSize == device->size())
+        return true;
+
+    if (!build(device))
+        return false;
+    m_logFileName = fileName;
+    m_logModified = modified;
+    if (saveSidecar && !fileName.isEmpty() && !save(fileName))
+        qWarning("QNmeaLogIndex: cannot save the index of %s", qPrintable(fileName));
+    return true;
+}
+
+bool QNmeaLogIndex::build(QIODevice *device)
+{
+    clear();
+    if (!device || device->isSequential() || !device->isReadable())
+        return false;
+
+    const qint64 position = device->pos();
+    if (!device->seek(0))
+        return false;
+
+    constexpr qsizetype ChunkSize = 64 * 1024;
+    QByteArray chunk(ChunkSize, Qt::Uninitialized);
+    QNmeaSentenceScanner scanner;
+    QDate date;
+    qint64 chunkOffset = 0;
+    for (;;) {
+        const qint64 size = device->read(chunk.data(), chunk.size());
+        if (size <= 0)
+            break;
+
+        const QByteArrayView data(chunk.constData(), size);
+        scanner.addData(data, [&](QByteArrayView sentence) {
+            const qint64 msecs = qnmealogindex_timestamp(sentence, &date);
+            if (msecs < 0)
+                return;
+            if (!m_entries.isEmpty()
+                && msecs < m_entries.constLast().msecsSinceEpoch + Granularity) {
+                return;
+            }
+            m_entries.append({ msecs, chunkOffset + qnmealogindex_offsetInChunk(data, sentence) });
+        });
+        chunkOffset += size;
+    }
+
+    m_logSize = chunkOffset;
+    device->seek(position);
+    return true;
+}
+
+/*
+    Returns the offset of the first sentence with a time not before
+    \a timestamp, or -1 if there is none. The position of \a device is
+    restored.
+*/
+qint64 QNmeaLogIndex::find(QIODevice *device, const QDateTime &timestamp) const
+{
+    if (!device || m_entries.isEmpty() || !timestamp.isValid())
+        return -1;
+
+    // start from the last entry that is not after the timestamp
+    const qint64 msecs = timestamp.toMSecsSinceEpoch();
+    auto entry = std::upper_bound(m_entries.cbegin(), m_entries.cend(), msecs,
+                                  [](qint64 time, const Entry &other) {
+                                      return time < other.msecsSinceEpoch;
+                                  });
+    if (entry != m_entries.cbegin())
+        --entry;
+
+    const qint64 position = device->pos();
+    if (!device->seek(entry->offset))
+        return -1;
+
+    QDate date = QDateTime::fromMSecsSinceEpoch(entry->msecsSinceEpoch, QTimeZone::UTC).date();
+    qint64 offset = entry->offset;
+    qint64 result = -1;
+    char buf[1024];
+    for (;;) {
+        const qint64 size = device->readLine(buf, sizeof(buf));
+        if (size <= 0)
+            break;
+        if (qnmealogindex_timestamp(QByteArrayView{buf, static_cast<qsizetype>(size)}, &date)
+            >= msecs) {
+            result = offset;
+            break;
+        }
+        offset += size;
+    }
+
+    device->seek(position);
+    return result;
+}
+
+bool QNmeaLogIndex::load(const QString &logFileName)
+{
+    clear();
+
+    const QFileInfo log(logFileName);
+    QFile file(sidecarFileName(logFileName));
+    if (!log.exists() || !file.open(QIODevice::ReadOnly))
+        return false;
+
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_6_0);
+    quint32 magic = 0;
+    quint32 version = 0;
+    qint64 logSize = -1;
+    qint64 logModified = 0;
+    qint64 count = -1;
+    stream >> magic >> version >> logSize >> logModified >> count;
+    if (stream.status() != QDataStream::Ok || magic != qnmealogindex_magic
+        || version != qnmealogindex_version || logSize != log.size()
+        || logModified != log.lastModified().toMSecsSinceEpoch()
+        || count < 0 || count > file.size() / qint64(2 * sizeof(qint64))) {
+        return false;
+    }
+
+    QList<Entry> entries;
+    entries.reserve(count);
+    for (qint64 i = 0; i < count; ++i) {
+        Entry entry;
+        stream >> entry.msecsSinceEpoch >> entry.offset;
+        if (entry.offset < 0 || entry.offset >= logSize
+            || (!entries.isEmpty()
+                && entry.msecsSinceEpoch < entries.constLast().msecsSinceEpoch)) {
+            return false;
+        }
+        entries.append(entry);
+    }
+    if (stream.status() != QDataStream::Ok)
+        return false;
+
+    m_entries = std::move(entries);
+    m_logSize = logSize;
+    m_logFileName = logFileName;
+    m_logModified = logModified;
+    return true;
+}
+
+bool QNmeaLogIndex::save(const QString &logFileName) const
+{
+    const QFileInfo log(logFileName);
+    if (m_logSize < 0 || m_logSize != log.size())
+        return false;
+
+    QSaveFile file(sidecarFileName(logFileName));
+    if (!file.open(QIODevice::WriteOnly))
+        return false;
+
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_6_0);
+    stream << qnmealogindex_magic << qnmealogindex_version << m_logSize
+           << qint64(log.lastModified().toMSecsSinceEpoch()) << qint64(m_entries.size());
+    for (const Entry &entry : m_entries)
+        stream << entry.msecsSinceEpoch << entry.offset;
+
+    return stream.status() == QDataStream::Ok && file.commit();
+}
+
+QString QNmeaLogIndex::sidecarFileName(const QString &logFileName)
+{
+    return logFileName + ".qnmeaidx"_L1;
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,78 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+#ifndef QNMEALOGINDEX_P_H
+#define QNMEALOGINDEX_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtPositioning/private/qpositioningglobal_p.h>
+
+#include <QtCore/QDateTime>
+#include <QtCore/QList>
+#include <QtCore/QString>
+
+QT_BEGIN_NAMESPACE
+
+class QIODevice;
+
+/*
+    Maps the timestamps of a recorded NMEA log to the byte offsets of the
+    sentences carrying them, so that a simulated source can start replaying
+    the log at any point in time without parsing everything before it.
+
+    The index is sparse: it has an entry for the first timestamped sentence
+    at least Granularity milliseconds after the previous entry. find() reads
+    forward from the entry preceding the requested time to the exact
+    sentence, which never takes more than Granularity worth of data.
+
+    For a QFile the index can be saved in a sidecar file next to the log, so
+    that only the first seek into a log has to scan it. The sidecar records
+    the size and the modification time of the log, and is not used when
+    either has changed. Writing next to the log is up to the caller, the
+    NMEA sources only do it when asked to by a backend property.
+*/
+class Q_POSITIONING_EXPORT QNmeaLogIndex
+{
+public:
+    struct Entry
+    {
+        qint64 msecsSinceEpoch;
+        qint64 offset;
+    };
+
+    static constexpr qint64 Granularity = 1000;
+
+    bool isEmpty() const { return m_entries.isEmpty(); }
+    const QList<Entry> &entries() const { return m_entries; }
+    void clear();
+
+    // Keeps the index if it is up to date, loads the sidecar of a QFile, or builds it
+    bool open(QIODevice *device, bool saveSidecar = false);
+    bool build(QIODevice *device);
+    qint64 find(QIODevice *device, const QDateTime &timestamp) const;
+
+    bool load(const QString &logFileName);
+    bool save(const QString &logFileName) const;
+    static QString sidecarFileName(const QString &logFileName);
+
+private:
+    QList<Entry> m_entries;
+    qint64 m_logSize = -1;
+    QString m_logFileName; // empty for other devices than QFile
+    qint64 m_logModified = 0; // msecs since the epoch
+};
+
+Q_DECLARE_TYPEINFO(QNmeaLogIndex::Entry, Q_PRIMITIVE_TYPE);
+
+QT_END_NAMESPACE
+
+#endif // QNMEALOGINDEX_P_H
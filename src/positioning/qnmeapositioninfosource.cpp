@@ -9,108 +9,15 @@
 #include <QBasicTimer>
 #include <QTimerEvent>
 #include <QTimer>
-#include <array>
 #include <QDebug>
 #include <QtCore/QtNumeric>
 #include <QtCore/QDateTime>
-#include <QtCore/QTimeZone>
 
 #include <algorithm>
+#include <limits>
 
 QT_BEGIN_NAMESPACE
 
-#define USE_POSITION_NMEA_PIMPL 0
-
-#if USE_POSITION_NMEA_PIMPL
-class QGeoPositionInfoPrivateNmea : public QGeoPositionInfoPrivate
-{
-public:
-    virtual ~QGeoPositionInfoPrivateNmea();
-
-    QList<QByteArray> nmeaSentences;
-};
-
-
-QGeoPositionInfoPrivateNmea::~QGeoPositionInfoPrivateNmea()
-{
-
-}
-#else
-typedef QGeoPositionInfoPrivate QGeoPositionInfoPrivateNmea;
-#endif
-
-static bool propagateCoordinate(QGeoPositionInfo &dst, const QGeoPositionInfo &src, bool force = true)
-{
-    bool updated = false;
-    QGeoCoordinate c = dst.coordinate();
-    const QGeoCoordinate & srcCoordinate = src.coordinate();
-    if (qIsFinite(src.coordinate().latitude())
-            && (!qIsFinite(dst.coordinate().latitude()) || force)) {
-        updated |= (c.latitude() != srcCoordinate.latitude());
-        c.setLatitude(src.coordinate().latitude());
-    }
-    if (qIsFinite(src.coordinate().longitude())
-            && (!qIsFinite(dst.coordinate().longitude()) || force)) {
-        updated |= (c.longitude() != srcCoordinate.longitude());
-        c.setLongitude(src.coordinate().longitude());
-    }
-    if (qIsFinite(src.coordinate().altitude())
-            && (!qIsFinite(dst.coordinate().altitude()) || force)) {
-        updated |= (c.altitude() != srcCoordinate.altitude());
-        c.setAltitude(src.coordinate().altitude());
-    }
-    dst.setCoordinate(c);
-    return updated;
-}
-
-static bool propagateDate(QGeoPositionInfo &dst, const QGeoPositionInfo &src)
-{
-    if (!dst.timestamp().date().isValid() && src.timestamp().isValid()) { // time was supposed to be set/the same already. Date can be overwritten.
-        dst.setTimestamp(src.timestamp());
-        return true;
-    }
-    return false;
-}
-
-static bool propagateAttributes(QGeoPositionInfo &dst, const QGeoPositionInfo &src, bool force = true)
-{
-    bool updated = false;
-    static Q_DECL_CONSTEXPR std::array<QGeoPositionInfo::Attribute, 6> attrs {
-                                                { QGeoPositionInfo::GroundSpeed
-                                                 ,QGeoPositionInfo::HorizontalAccuracy
-                                                 ,QGeoPositionInfo::VerticalAccuracy
-                                                 ,QGeoPositionInfo::Direction
-                                                 ,QGeoPositionInfo::VerticalSpeed
-                                                 ,QGeoPositionInfo::MagneticVariation} };
-    for (const auto a: attrs) {
-        if (src.hasAttribute(a) && (!dst.hasAttribute(a) || force)) {
-            updated |= (dst.attribute(a) != src.attribute(a));
-            dst.setAttribute(a, src.attribute(a));
-        }
-    }
-
-    return updated;
-}
-
-// returns false if src does not contain any additional or different data than dst,
-// true otherwise.
-static bool mergePositions(QGeoPositionInfo &dst, const QGeoPositionInfo &src, QByteArray nmeaSentence)
-{
-    bool updated = false;
-
-    updated |= propagateCoordinate(dst, src);
-    updated |= propagateDate(dst, src);
-    updated |= propagateAttributes(dst, src);
-
-#if USE_POSITION_NMEA_PIMPL
-    QGeoPositionInfoPrivateNmea *dstPimpl = static_cast<QGeoPositionInfoPrivateNmea *>(QGeoPositionInfoPrivate::get(dst));
-    dstPimpl->nmeaSentences.append(nmeaSentence);
-#else
-    Q_UNUSED(nmeaSentence);
-#endif
-    return updated;
-}
-
 static qint64 msecsTo(const QDateTime &from, const QDateTime &to)
 {
     if (!from.time().isValid() || !to.time().isValid())
@@ -126,13 +33,16 @@ QNmeaReader::~QNmeaReader()
     = default;
 
 QNmeaRealTimeReader::QNmeaRealTimeReader(QNmeaPositionInfoSourcePrivate *sourcePrivate)
-        : QNmeaReader(sourcePrivate), m_update(*new QGeoPositionInfoPrivateNmea)
+        : QNmeaReader(sourcePrivate)
 {
     // An env var controlling the number of milliseconds to use to withold
     // an update and wait for additional data to combine.
     // The update will be pushed earlier than this if a newer update will be received.
     // The update will be withold longer than this amount of time if additional
     // valid data will keep arriving within this time frame.
+    // Once the order of the sentences in an epoch is known, the update is
+    // pushed as soon as the last sentence of the epoch has been read, and
+    // the timer only matters for epochs that do not follow that order.
     bool ok = false;
     int pushDelay = qEnvironmentVariableIntValue("QT_NMEA_PUSH_DELAY", &ok);
     if (ok)
@@ -155,86 +65,46 @@ QNmeaRealTimeReader::~QNmeaRealTimeReader()
 
 void QNmeaRealTimeReader::readAvailableData()
 {
-    while (m_proxy->m_device->canReadLine()) {
-        const QTime infoTime = m_update.timestamp().time(); // if update has been set, time must be valid.
-        const QDate infoDate = m_update.timestamp().date(); // this one might not be valid, as some sentences do not contain it
-
-        QGeoPositionInfoPrivateNmea *pimpl = new QGeoPositionInfoPrivateNmea;
-        QGeoPositionInfo pos(*pimpl);
-
-        char buf[1024];
-        qint64 size = m_proxy->m_device->readLine(buf, sizeof(buf));
-        if (size <= 0)
-            continue;
-
-        const bool oldFix = m_hasFix;
-        bool hasFix;
-        const bool parsed = m_proxy->parsePosInfoFromNmeaData(
-            QByteArrayView{buf, static_cast<qsizetype>(size)}, &pos, &hasFix);
+    // Read everything available at once and split it into sentences
+    // ourselves, instead of one readLine() call per sentence.
+    char buf[4096];
+    qint64 size;
+    while ((size = m_proxy->m_device->read(buf, sizeof(buf))) > 0) {
+        m_scanner.addData(QByteArrayView{buf, static_cast<qsizetype>(size)},
+                          [this](QByteArrayView sentence) { processSentence(sentence); });
+    }
+    scheduleUpdate();
+}
 
-        if (!parsed) {
-            // got garbage, don't stop the timer
-            continue;
-        }
+void QNmeaRealTimeReader::processSentence(QByteArrayView sentence)
+{
+    QGeoPositionInfo pos;
+    bool hasFix;
+    const bool parsed = m_proxy->parsePosInfoFromNmeaData(sentence, &pos, &hasFix);
 
-        m_hasFix |= hasFix;
-        m_updateParsed = true;
-
-        // Date may or may not be valid, as some packets do not have date.
-        // If date isn't valid, match is performed on time only.
-        // Hence, make sure that packet blocks are generated with
-        // the sentences containing the full timestamp (e.g., GPRMC) *first* !
-        if (infoTime.isValid()) {
-            if (pos.timestamp().time().isValid()) {
-                const bool newerTime = infoTime < pos.timestamp().time();
-                const bool newerDate = (infoDate.isValid() // if time is valid but one date or both are not,
-                                        && pos.timestamp().date().isValid()
-                                        && infoDate < pos.timestamp().date());
-                if (newerTime || newerDate) {
-                    // Effectively read data for different update, that is also newer,
-                    // so flush retained update, and copy the new pos into m_update
-                    const QDate updateDate = m_update.timestamp().date();
-                    const QDate lastPushedDate = m_lastPushedTS.date();
-                    const bool newerTimestampSinceLastPushed = m_update.timestamp() > m_lastPushedTS;
-                    const bool invalidDate = !(updateDate.isValid() && lastPushedDate.isValid());
-                    const bool newerTimeSinceLastPushed = m_update.timestamp().time() > m_lastPushedTS.time();
-                    if ( newerTimestampSinceLastPushed || (invalidDate && newerTimeSinceLastPushed)) {
-                        m_proxy->notifyNewUpdate(&m_update, oldFix);
-                        m_lastPushedTS = m_update.timestamp();
-                    }
-                    m_timer.stop();
-                    // next update data
-                    propagateAttributes(pos, m_update, false);
-                    m_update = pos;
-                    m_hasFix = hasFix;
-                } else {
-                    if (infoTime == pos.timestamp().time())
-                        // timestamps match -- merge into m_update
-                        if (mergePositions(m_update, pos, QByteArray(buf, size))) {
-                            // Reset the timer only if new info has been received.
-                            // Else the source might be keep repeating outdated info until
-                            // new info become available.
-                            m_timer.stop();
-                        }
-                    // else discard out of order outdated info.
-                }
-            } else {
-                // no timestamp available in parsed update-- merge into m_update
-                if (mergePositions(m_update, pos, QByteArray(buf, size)))
-                    m_timer.stop();
-            }
-        } else {
-            // there was no info with valid TS. Overwrite with whatever is parsed.
-#if USE_POSITION_NMEA_PIMPL
-            pimpl->nmeaSentences.append(QByteArray(buf, size));
-#endif
-            propagateAttributes(pos, m_update);
-            m_update = pos;
-            m_timer.stop();
-        }
+    if (!parsed) {
+        // got garbage, don't stop the timer
+        return;
     }
 
-    if (m_updateParsed) {
+    m_updateParsed = true;
+    // the backend property may change between sentences
+    m_merger.setKeepSentences(m_proxy->m_keepSentences);
+    const bool newEpoch = m_merger.addPosition(std::move(pos), hasFix, sentence,
+                                               [this](QGeoPositionInfo *update, bool fix) {
+        m_proxy->notifyNewUpdate(update, fix);
+    });
+    // Once the last sentence of the learned epoch pattern has been parsed,
+    // the update is pushed without waiting for the timer.
+    m_epochComplete = m_pattern.addSentence(sentence, newEpoch);
+    if (m_epochComplete)
+        notifyNewUpdate();
+}
+
+// Called when all the data available has been processed
+void QNmeaRealTimeReader::scheduleUpdate()
+{
+    if (m_updateParsed && !m_epochComplete) {
         if (m_pushDelay < 0)
             notifyNewUpdate();
         else
@@ -244,14 +114,9 @@ void QNmeaRealTimeReader::readAvailableData()
 
 void QNmeaRealTimeReader::notifyNewUpdate()
 {
-    const bool newerTime = m_update.timestamp().time() > m_lastPushedTS.time();
-    const bool newerDate = (m_update.timestamp().date().isValid()
-                            && m_lastPushedTS.date().isValid()
-                            && m_update.timestamp().date() > m_lastPushedTS.date());
-    if (newerTime || newerDate) {
-        m_proxy->notifyNewUpdate(&m_update, m_hasFix);
-        m_lastPushedTS = m_update.timestamp();
-    }
+    m_merger.flush([this](QGeoPositionInfo *update, bool hasFix) {
+        m_proxy->notifyNewUpdate(update, hasFix);
+    });
     m_timer.stop();
 }
 
@@ -294,6 +159,18 @@ void QNmeaSimulatedReader::readAvailableData()
     }
 }
 
+void QNmeaSimulatedReader::restart()
+{
+    // forget the updates read before the device was seeked
+    if (m_currTimerId > 0) {
+        killTimer(m_currTimerId);
+        m_currTimerId = -1;
+    }
+    m_pendingUpdates.clear();
+    m_nextLine.clear();
+    m_hasValidDateTime = false;
+}
+
 static int processSentence(QGeoPositionInfo &info,
                            QByteArray &m_nextLine,
                            QNmeaPositionInfoSourcePrivate *m_proxy,
@@ -345,8 +222,7 @@ static int processSentence(QGeoPositionInfo &info,
              from any prior sentence that had timestamp info, if any is available.
          */
 
-        QGeoPositionInfoPrivateNmea *pimpl = new QGeoPositionInfoPrivateNmea;
-        QGeoPositionInfo pos(*pimpl);
+        QGeoPositionInfo pos;
         if (m_proxy->parsePosInfoFromNmeaData(
                 QByteArrayView{buf, static_cast<qsizetype>(size)}, &pos, &hasFix)) {
             // Date may or may not be valid, as some packets do not have date.
@@ -366,25 +242,24 @@ static int processSentence(QGeoPositionInfo &info,
                     } else {
                         if (infoTime == pos.timestamp().time())
                             // timestamps match -- merge into info
-                            mergePositions(info, pos, QByteArray(buf, size));
+                            QNmeaEpochMerger::mergePositions(info, pos, QByteArrayView{buf, static_cast<qsizetype>(size)});
                         // else discard out of order outdated info.
                     }
                 } else {
                     // no timestamp available -- merge into info
-                    mergePositions(info, pos, QByteArray(buf, size));
+                    QNmeaEpochMerger::mergePositions(info, pos, QByteArrayView{buf, static_cast<qsizetype>(size)});
                 }
             } else {
                 // there was no info with valid TS. Overwrite with whatever is parsed.
-#if USE_POSITION_NMEA_PIMPL
-                pimpl->nmeaSentences.append(QByteArray(buf, size));
-#endif
+                if (m_proxy->m_keepSentences)
+                    QNmeaEpochMerger::keepSentence(pos, QByteArrayView{buf, static_cast<qsizetype>(size)});
                 info = pos;
             }
 
             if (prevTs.time().isValid()) {
                 timeToNextUpdate = msecsTo(prevTs, info.timestamp());
                 if (timeToNextUpdate < 0) // Somehow parsing expired packets, reset info
-                    info = QGeoPositionInfo(*new QGeoPositionInfoPrivateNmea);
+                    info = QGeoPositionInfo();
             }
         }
     }
@@ -395,7 +270,7 @@ static int processSentence(QGeoPositionInfo &info,
 bool QNmeaSimulatedReader::setFirstDateTime()
 {
     // find the first update with valid date and time
-    QGeoPositionInfo info(*new QGeoPositionInfoPrivateNmea);
+    QGeoPositionInfo info;
     bool hasFix = false;
     processSentence(info, m_nextLine, m_proxy, m_pendingUpdates, hasFix);
 
@@ -429,7 +304,7 @@ void QNmeaSimulatedReader::timerEvent(QTimerEvent *event)
 
 void QNmeaSimulatedReader::processNextSentence()
 {
-    QGeoPositionInfo info(*new QGeoPositionInfoPrivateNmea);
+    QGeoPositionInfo info;
     bool hasFix = false;
 
     int timeToNextUpdate = processSentence(info, m_nextLine, m_proxy, m_pendingUpdates, hasFix);
@@ -442,7 +317,14 @@ void QNmeaSimulatedReader::processNextSentence()
     pending.info = info;
     pending.hasFix = hasFix;
     m_pendingUpdates.enqueue(pending);
-    m_currTimerId = startTimer(timeToNextUpdate);
+
+    // An unthrottled replay still goes through the event loop, so that the
+    // updates stay in order and the application gets a chance to handle them.
+    // A tiny speed waits for the longest interval a timer can have instead
+    // of overflowing it.
+    const double speed = m_proxy->m_simulationSpeed;
+    const double interval = speed > 0 ? timeToNextUpdate / speed : 0.0;
+    m_currTimerId = startTimer(qRound(qMin(interval, double(std::numeric_limits<int>::max()))));
 }
 
 
@@ -460,8 +342,6 @@ QNmeaPositionInfoSourcePrivate::QNmeaPositionInfoSourcePrivate(QNmeaPositionInfo
         m_nmeaReader(0),
         m_updateTimer(0),
         m_requestTimer(0),
-        m_horizontalAccuracy(qQNaN()),
-        m_verticalAccuracy(qQNaN()),
         m_noUpdateLastInterval(false),
         m_updateTimeoutSent(false),
         m_connectedReadyRead(false)
@@ -495,16 +375,29 @@ bool QNmeaPositionInfoSourcePrivate::openSourceDevice()
 
 void QNmeaPositionInfoSourcePrivate::sourceDataClosed()
 {
-    if (m_nmeaReader && m_device && m_device->bytesAvailable())
+    if (m_nmeaReader && !m_dispatcher && m_device && m_device->bytesAvailable())
         m_nmeaReader->readAvailableData();
 }
 
 void QNmeaPositionInfoSourcePrivate::readyRead()
 {
-    if (m_nmeaReader)
+    if (m_nmeaReader && !m_dispatcher)
         m_nmeaReader->readAvailableData();
 }
 
+void QNmeaPositionInfoSourcePrivate::addDispatchedSentence(QByteArrayView sentence)
+{
+    // the dispatcher only takes sources in RealTimeMode
+    if (m_nmeaReader)
+        static_cast<QNmeaRealTimeReader *>(m_nmeaReader)->processSentence(sentence);
+}
+
+void QNmeaPositionInfoSourcePrivate::dispatchFinished()
+{
+    if (m_nmeaReader)
+        static_cast<QNmeaRealTimeReader *>(m_nmeaReader)->scheduleUpdate();
+}
+
 bool QNmeaPositionInfoSourcePrivate::initialize()
 {
     if (m_nmeaReader)
@@ -558,9 +451,10 @@ void QNmeaPositionInfoSourcePrivate::startUpdates()
         return;
     }
 
-    if (m_updateMode == QNmeaPositionInfoSource::RealTimeMode) {
+    if (m_updateMode == QNmeaPositionInfoSource::RealTimeMode && !m_dispatcher) {
         // skip over any buffered data - we only want the newest data.
         // Don't do this in requestUpdate. In that case bufferedData is good to have/use.
+        // With a dispatcher the data is read as soon as it arrives.
         if (m_device->bytesAvailable()) {
             if (m_device->isSequential())
                 m_device->readAll();
@@ -618,6 +512,31 @@ void QNmeaPositionInfoSourcePrivate::requestUpdate(int msec)
     prepareSourceDevice();
 }
 
+bool QNmeaPositionInfoSourcePrivate::seek(const QDateTime &timestamp)
+{
+    if (m_updateMode != QNmeaPositionInfoSource::SimulationMode || !m_device)
+        return false;
+
+    if (!m_device->isOpen() && !m_device->open(QIODevice::ReadOnly)) {
+        qWarning("QNmeaPositionInfoSource: cannot open QIODevice data source");
+        return false;
+    }
+
+    if (!m_logIndex.open(m_device, m_saveLogIndex))
+        return false;
+    const qint64 offset = m_logIndex.find(m_device, timestamp);
+    if (offset < 0 || !m_device->seek(offset))
+        return false;
+
+    m_pendingUpdate = QGeoPositionInfo();
+    if (m_nmeaReader) {
+        static_cast<QNmeaSimulatedReader *>(m_nmeaReader)->restart();
+        if (m_device->bytesAvailable())
+            m_nmeaReader->readAvailableData();
+    }
+    return true;
+}
+
 void QNmeaPositionInfoSourcePrivate::updateRequestTimeout()
 {
     m_requestTimer->stop();
@@ -629,27 +548,7 @@ void QNmeaPositionInfoSourcePrivate::notifyNewUpdate(QGeoPositionInfo *update, b
     // include <QDebug> before uncommenting
     //qDebug() << "QNmeaPositionInfoSourcePrivate::notifyNewUpdate()" << update->timestamp() << hasFix << m_invokedStart << (m_requestTimer && m_requestTimer->isActive());
 
-    QDate date = update->timestamp().date();
-    if (date.isValid()) {
-        m_currentDate = date;
-    } else {
-        // some sentence have time but no date
-        QTime time = update->timestamp().time();
-        if (time.isValid() && m_currentDate.isValid())
-            update->setTimestamp(QDateTime(m_currentDate, time, QTimeZone::UTC));
-    }
-
-    // Some attributes are sent in separate NMEA sentences. Save and restore the accuracy
-    // measurements.
-    if (update->hasAttribute(QGeoPositionInfo::HorizontalAccuracy))
-        m_horizontalAccuracy = update->attribute(QGeoPositionInfo::HorizontalAccuracy);
-    else if (!qIsNaN(m_horizontalAccuracy))
-        update->setAttribute(QGeoPositionInfo::HorizontalAccuracy, m_horizontalAccuracy);
-
-    if (update->hasAttribute(QGeoPositionInfo::VerticalAccuracy))
-        m_verticalAccuracy = update->attribute(QGeoPositionInfo::VerticalAccuracy);
-    else if (!qIsNaN(m_verticalAccuracy))
-        update->setAttribute(QGeoPositionInfo::VerticalAccuracy, m_verticalAccuracy);
+    m_completer.complete(update);
 
     if (hasFix && update->isValid()) {
         if (m_requestTimer && m_requestTimer->isActive()) { // User called requestUpdate()
@@ -743,9 +642,74 @@ void QNmeaPositionInfoSourcePrivate::emitUpdated(const QGeoPositionInfo &update)
     Defines the available update modes.
 
     \value RealTimeMode Positional data is read and distributed from the data source as it becomes available. Use this mode if you are using a live source of positional data (for example, a GPS hardware device).
-    \value SimulationMode The data and time information in the NMEA source data is used to provide positional updates at the rate at which the data was originally recorded. Use this mode if the data source contains previously recorded NMEA data and you want to replay the data for simulation purposes.
+    \value SimulationMode The data and time information in the NMEA source data is used to provide positional updates at the rate at which the data was originally recorded. Use this mode if the data source contains previously recorded NMEA data and you want to replay the data for simulation purposes. The replay can be accelerated with the \l {QNmeaPositionInfoSource::}{SimulationSpeed} parameter.
 */
 
+/*!
+    \variable QNmeaPositionInfoSource::SimulationSpeed
+    \since 6.9
+    \brief The backend property name for the replay speed in the
+    \l SimulationMode.
+
+    The value for this property is a floating point factor by which the
+    intervals between the recorded updates are divided. The default value
+    \c 1 replays the data at the rate at which it was recorded, \c 10 replays
+    it ten times faster. The value \c 0 replays the data as fast as possible:
+    the updates are emitted back to back, still in order and from the event
+    loop. Negative values are rejected.
+
+    Use this parameter in the \l {QNmeaPositionInfoSource::}
+    {setBackendProperty()} and \l {QNmeaPositionInfoSource::}{backendProperty()}
+    methods. It can be changed while the replay is running, and takes effect
+    from the next update on.
+
+    \note The interval set via \l {setUpdateInterval()} still limits how
+    often the updates are delivered to the user.
+*/
+QString QNmeaPositionInfoSource::SimulationSpeed = QStringLiteral("nmea.simulation.speed");
+
+/*!
+    \variable QNmeaPositionInfoSource::KeepSentences
+    \since 6.9
+    \brief The backend property name for keeping the raw NMEA sentences of
+    the updates.
+
+    The value for this property is a boolean. If it is \c true, every
+    update keeps the raw sentences it was fused from, in both update modes.
+    The sentences of an update are stored back to back in one buffer, so that
+    keeping them does not allocate per sentence. The default value is
+    \c false.
+
+    Use this parameter in the \l {QNmeaPositionInfoSource::}
+    {setBackendProperty()} and \l {QNmeaPositionInfoSource::}{backendProperty()}
+    methods. It takes effect from the next sentence on.
+
+    \note The kept sentences are only accessible through the private API of
+    Qt Positioning.
+*/
+QString QNmeaPositionInfoSource::KeepSentences = QStringLiteral("nmea.keep_sentences");
+
+/*!
+    \variable QNmeaPositionInfoSource::SimulationIndex
+    \since 6.9
+    \brief The backend property name for saving the index of the timestamps
+    of a log in the \l SimulationMode.
+
+    The value for this property is a boolean. If it is \c true, the index
+    that the first call to seek() builds for a QFile is written to a sidecar
+    file, with the name of the log followed by \c .qnmeaidx. Later sources
+    replaying the same log read it instead of scanning the log, as long as
+    the log has not changed. The directory of the log must be writable for
+    this. The default value is \c false.
+
+    Use this parameter in the \l {QNmeaPositionInfoSource::}
+    {setBackendProperty()} and \l {QNmeaPositionInfoSource::}{backendProperty()}
+    methods, before the first call to seek().
+
+    \sa QNmeaSatelliteInfoSource::SimulationIndex
+*/
+QString QNmeaPositionInfoSource::SimulationIndex = QStringLiteral("nmea.simulation.index");
+
 
 /*!
     Constructs a QNmeaPositionInfoSource instance with the given \a parent
@@ -879,6 +843,31 @@ QIODevice *QNmeaPositionInfoSource::device() const
     return d->m_device;
 }
 
+/*!
+    \since 6.9
+
+    Continues the replay of the NMEA log from the first update with a time
+    not before \a timestamp. Returns \c true on success; otherwise returns
+    \c false, and the replay continues where it was.
+
+    Seeking is only possible in the \l SimulationMode and with a device that
+    is not sequential, such as a QFile. The first call scans the whole log to
+    build an index of its timestamps, unless it can read the index from a
+    sidecar file next to a QFile, see \l SimulationIndex. Later calls only
+    read the data around the requested time.
+
+    If the replay has already started, it continues from \a timestamp right
+    away, at the rate set by the \l SimulationSpeed parameter. Otherwise it
+    starts from \a timestamp at the first call to startUpdates() or
+    requestUpdate().
+
+    \sa QNmeaSatelliteInfoSource::seek()
+*/
+bool QNmeaPositionInfoSource::seek(const QDateTime &timestamp)
+{
+    return d->seek(timestamp);
+}
+
 /*!
     \reimp
 */
@@ -951,6 +940,45 @@ QGeoPositionInfoSource::Error QNmeaPositionInfoSource::error() const
     return d->m_positionError;
 }
 
+/*!
+    \reimp
+*/
+bool QNmeaPositionInfoSource::setBackendProperty(const QString &name, const QVariant &value)
+{
+    if (name == SimulationSpeed && d->m_updateMode == SimulationMode) {
+        bool ok = false;
+        const double speed = value.toDouble(&ok);
+        if (ok && speed >= 0) { // also rejects NaN
+            d->m_simulationSpeed = speed;
+            return true;
+        }
+    }
+    if (name == KeepSentences && value.canConvert<bool>()) {
+        d->m_keepSentences = value.toBool();
+        return true;
+    }
+    if (name == SimulationIndex && d->m_updateMode == SimulationMode
+        && value.canConvert<bool>()) {
+        d->m_saveLogIndex = value.toBool();
+        return true;
+    }
+    return false;
+}
+
+/*!
+    \reimp
+*/
+QVariant QNmeaPositionInfoSource::backendProperty(const QString &name) const
+{
+    if (name == SimulationSpeed && d->m_updateMode == SimulationMode)
+        return d->m_simulationSpeed;
+    if (name == KeepSentences)
+        return d->m_keepSentences;
+    if (name == SimulationIndex && d->m_updateMode == SimulationMode)
+        return d->m_saveLogIndex;
+    return QVariant();
+}
+
 void QNmeaPositionInfoSource::setError(QGeoPositionInfoSource::Error positionError)
 {
     d->m_positionError = positionError;
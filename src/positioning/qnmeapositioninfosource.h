@@ -7,6 +7,7 @@
 
 QT_BEGIN_NAMESPACE
 
+class QDateTime;
 class QIODevice;
 
 class QNmeaPositionInfoSourcePrivate;
@@ -19,6 +20,10 @@ public:
         SimulationMode
     };
 
+    static QString SimulationSpeed;
+    static QString KeepSentences;
+    static QString SimulationIndex;
+
     explicit QNmeaPositionInfoSource(UpdateMode updateMode, QObject *parent = nullptr);
     ~QNmeaPositionInfoSource();
 
@@ -30,6 +35,8 @@ public:
     void setDevice(QIODevice *source);
     QIODevice *device() const;
 
+    bool seek(const QDateTime &timestamp);
+
     void setUpdateInterval(int msec) override;
 
     QGeoPositionInfo lastKnownPosition(bool fromSatellitePositioningMethodsOnly = false) const override;
@@ -37,6 +44,8 @@ public:
     int minimumUpdateInterval() const override;
     Error error() const override;
 
+    bool setBackendProperty(const QString &name, const QVariant &value) override;
+    QVariant backendProperty(const QString &name) const override;
 
 public Q_SLOTS:
     void startUpdates() override;
@@ -16,6 +16,10 @@
 
 #include "qnmeapositioninfosource.h"
 #include "qgeopositioninfo.h"
+#include "qnmeaepochmerger_p.h"
+#include "qnmealogindex_p.h"
+#include "qnmeasentencedispatcher_p.h"
+#include "qnmeasentencescanner_p.h"
 
 #include <QObject>
 #include <QQueue>
@@ -47,6 +51,7 @@ public:
     void startUpdates();
     void stopUpdates();
     void requestUpdate(int msec);
+    bool seek(const QDateTime &timestamp);
 
     bool parsePosInfoFromNmeaData(QByteArrayView data,
                                   QGeoPositionInfo *posInfo,
@@ -54,12 +59,24 @@ public:
 
     void notifyNewUpdate(QGeoPositionInfo *update, bool fixStatus);
 
+    static QNmeaPositionInfoSourcePrivate *get(QNmeaPositionInfoSource *source)
+    {
+        return source->d;
+    }
+
+    // Used instead of reading m_device when a dispatcher reads it
+    void addDispatchedSentence(QByteArrayView sentence);
+    void dispatchFinished();
+
     QNmeaPositionInfoSource::UpdateMode m_updateMode;
     QPointer<QIODevice> m_device;
+    QPointer<QNmeaSentenceDispatcher> m_dispatcher;
     QGeoPositionInfo m_lastUpdate;
     bool m_invokedStart;
     QGeoPositionInfoSource::Error m_positionError;
     double m_userEquivalentRangeError;
+    double m_simulationSpeed = 1.0; // 0 replays without waiting
+    bool m_keepSentences = QT_NMEA_EPOCH_MERGER_KEEP_SENTENCES; // read by both readers
 
 public Q_SLOTS:
     void readyRead();
@@ -81,11 +98,11 @@ private:
     QNmeaPositionInfoSource *m_source;
     QNmeaReader *m_nmeaReader;
     QGeoPositionInfo m_pendingUpdate;
-    QDate m_currentDate;
+    QNmeaUpdateCompleter m_completer;
+    QNmeaLogIndex m_logIndex; // built by the first seek()
+    bool m_saveLogIndex = false;
     QBasicTimer *m_updateTimer; // the timer used in startUpdates()
     QTimer *m_requestTimer; // the timer used in requestUpdate()
-    qreal m_horizontalAccuracy;
-    qreal m_verticalAccuracy;
     bool m_noUpdateLastInterval;
     bool m_updateTimeoutSent;
     bool m_connectedReadyRead;
@@ -113,13 +130,16 @@ public:
     ~QNmeaRealTimeReader() override;
 
     void readAvailableData() override;
+    void processSentence(QByteArrayView sentence);
+    void scheduleUpdate();
     void notifyNewUpdate();
 
     // Data members
-    QGeoPositionInfo m_update;
-    QDateTime m_lastPushedTS;
+    QNmeaSentenceScanner m_scanner;
+    QNmeaEpochMerger m_merger;
+    QNmeaEpochPattern m_pattern;
     bool m_updateParsed = false;
-    bool m_hasFix = false;
+    bool m_epochComplete = false; // the last parsed sentence completed the epoch
     QTimer m_timer;
     int m_pushDelay = -1;
 };
@@ -132,6 +152,7 @@ public:
     explicit QNmeaSimulatedReader(QNmeaPositionInfoSourcePrivate *sourcePrivate);
     ~QNmeaSimulatedReader();
     void readAvailableData() override;
+    void restart();
 
 protected:
     void timerEvent(QTimerEvent *event) override;
@@ -78,14 +78,19 @@ void QNmeaSatelliteInfoSourcePrivate::processNmeaData(QNmeaSatelliteInfoUpdate &
     if (size <= 0)
         return;
 
+    processNmeaSentence(QByteArrayView{buf, static_cast<qsizetype>(size)}, updateInfo);
+}
+
+void QNmeaSatelliteInfoSourcePrivate::processNmeaSentence(QByteArrayView sentence,
+                                                          QNmeaSatelliteInfoUpdate &updateInfo)
+{
     QList<int> satInUse;
-    const auto satSystemType = m_source->parseSatellitesInUseFromNmea(QByteArrayView{buf,static_cast<qsizetype>(size)},
-                                                                      satInUse);
+    const auto satSystemType = m_source->parseSatellitesInUseFromNmea(sentence, satInUse);
     if (satSystemType != QGeoSatelliteInfo::Undefined) {
         const bool res = updateInfo.setSatellitesInUse(satSystemType, satInUse);
 #if USE_SATELLITE_NMEA_PIMPL
         if (res) {
-            updateInfo.gsa = QByteArray(buf, size);
+            updateInfo.gsa = sentence.toByteArray();
             auto &info = updateInfo.m_satellites[satSystemType];
             if (!info.satellitesInUse.isEmpty()) {
                 for (auto &s : info.satellitesInUse) {
@@ -106,15 +111,15 @@ void QNmeaSatelliteInfoSourcePrivate::processNmeaData(QNmeaSatelliteInfoUpdate &
         // come one after another. At least this is how it should be.
         auto systemType = QGeoSatelliteInfo::Undefined;
         const auto parserStatus = m_source->parseSatelliteInfoFromNmea(
-                QByteArrayView{buf,static_cast<qsizetype>(size)}, updateInfo.m_satellitesInViewParsed, systemType);
+                sentence, updateInfo.m_satellitesInViewParsed, systemType);
         if (parserStatus == QNmeaSatelliteInfoSource::PartiallyParsed) {
             updateInfo.m_satellites[systemType].updatingGSV = true;
 #if USE_SATELLITE_NMEA_PIMPL
-            updateInfo.gsv.append(QByteArray(buf, size));
+            updateInfo.gsv.append(sentence.toByteArray());
 #endif
         } else if (parserStatus == QNmeaSatelliteInfoSource::FullyParsed) {
 #if USE_SATELLITE_NMEA_PIMPL
-            updateInfo.gsv.append(QByteArray(buf, size));
+            updateInfo.gsv.append(sentence.toByteArray());
             for (int i = 0; i < updateInfo.m_satellitesInViewParsed.size(); i++) {
                 const QGeoSatelliteInfo &s = updateInfo.m_satellitesInViewParsed.at(i);
                 QGeoSatelliteInfoPrivateNmea *pimpl =
@@ -150,9 +155,10 @@ void QNmeaSatelliteInfoSourcePrivate::startUpdates()
     if (!initialized)
         return;
 
-    if (m_updateMode == QNmeaSatelliteInfoSource::UpdateMode::RealTimeMode) {
+    if (m_updateMode == QNmeaSatelliteInfoSource::UpdateMode::RealTimeMode && !m_dispatcher) {
         // skip over any buffered data - we only want the newest data.
         // Don't do this in requestUpdate. In that case bufferedData is good to have/use.
+        // With a dispatcher the data is read as soon as it arrives.
         if (m_device->bytesAvailable()) {
             if (m_device->isSequential())
                 m_device->readAll();
@@ -210,12 +216,47 @@ void QNmeaSatelliteInfoSourcePrivate::requestUpdate(int msec)
     prepareSourceDevice();
 }
 
+bool QNmeaSatelliteInfoSourcePrivate::seek(const QDateTime &timestamp)
+{
+    if (m_updateMode != QNmeaSatelliteInfoSource::UpdateMode::SimulationMode || !m_device)
+        return false;
+
+    if (!m_device->isOpen() && !m_device->open(QIODevice::ReadOnly)) {
+        qWarning("QNmeaSatelliteInfoSource: cannot open QIODevice data source");
+        return false;
+    }
+
+    if (!m_logIndex.open(m_device, m_saveLogIndex))
+        return false;
+    const qint64 offset = m_logIndex.find(m_device, timestamp);
+    if (offset < 0 || !m_device->seek(offset))
+        return false;
+
+    // The simulation reader reads on from the new position at its next
+    // interval; the satellites seen before the seek must not be merged
+    // into the next update.
+    m_pendingUpdate.clear();
+    return true;
+}
+
 void QNmeaSatelliteInfoSourcePrivate::readyRead()
 {
-    if (m_nmeaReader)
+    if (m_nmeaReader && !m_dispatcher)
         m_nmeaReader->readAvailableData();
 }
 
+void QNmeaSatelliteInfoSourcePrivate::addDispatchedSentence(QByteArrayView sentence)
+{
+    if (m_nmeaReader)
+        processNmeaSentence(sentence, m_pendingUpdate);
+}
+
+void QNmeaSatelliteInfoSourcePrivate::dispatchFinished()
+{
+    if (m_nmeaReader)
+        notifyNewUpdate();
+}
+
 void QNmeaSatelliteInfoSourcePrivate::emitPendingUpdate()
 {
     if (m_pendingUpdate.isValid() && m_pendingUpdate.isFresh()) {
@@ -235,7 +276,7 @@ void QNmeaSatelliteInfoSourcePrivate::emitPendingUpdate()
 
 void QNmeaSatelliteInfoSourcePrivate::sourceDataClosed()
 {
-    if (m_nmeaReader && m_device && m_device->bytesAvailable())
+    if (m_nmeaReader && !m_dispatcher && m_device && m_device->bytesAvailable())
         m_nmeaReader->readAvailableData();
 }
 
@@ -403,6 +444,18 @@ void QNmeaSatelliteInfoSourcePrivate::timerEvent(QTimerEvent * /*event*/)
 QString QNmeaSatelliteInfoSource::SimulationUpdateInterval =
         QStringLiteral("nmea.satellite_info_simulation_interval");
 
+/*!
+    \variable QNmeaSatelliteInfoSource::SimulationIndex
+    \since 6.9
+    \brief The backend property name for saving the index of the timestamps
+    of a log in the \l SimulationMode.
+
+    The value for this property is a boolean, \c false by default. It has
+    the same meaning and name as \l QNmeaPositionInfoSource::SimulationIndex,
+    and must also be set before the first call to seek().
+*/
+QString QNmeaSatelliteInfoSource::SimulationIndex = QStringLiteral("nmea.simulation.index");
+
 /*!
     Constructs a \l QNmeaSatelliteInfoSource instance with the given \a parent
     and \a mode.
@@ -459,6 +512,28 @@ QIODevice *QNmeaSatelliteInfoSource::device() const
     return d->m_device;
 }
 
+/*!
+    \since 6.9
+
+    Continues the replay of the NMEA log from the first epoch with a time
+    not before \a timestamp. Returns \c true on success; otherwise returns
+    \c false, and the replay continues where it was.
+
+    The satellite sentences have no timestamps of their own, so the time
+    is taken from the position sentences of the same log, such as RMC or
+    GGA. Seeking is only possible in the \l {UpdateMode::}{SimulationMode}
+    and with a device that is not sequential, such as a QFile. As with
+    QNmeaPositionInfoSource::seek(), the first call builds an index of the
+    timestamps of the log, which for a QFile can be kept in a sidecar file,
+    see \l SimulationIndex.
+
+    \sa QNmeaPositionInfoSource::seek()
+*/
+bool QNmeaSatelliteInfoSource::seek(const QDateTime &timestamp)
+{
+    return d->seek(timestamp);
+}
+
 /*!
     \reimp
 */
@@ -509,6 +584,11 @@ bool QNmeaSatelliteInfoSource::setBackendProperty(const QString &name, const QVa
             return true;
         }
     }
+    if (name == SimulationIndex && d->m_updateMode == UpdateMode::SimulationMode
+        && value.canConvert<bool>()) {
+        d->m_saveLogIndex = value.toBool();
+        return true;
+    }
     return false;
 }
 
@@ -524,6 +604,8 @@ QVariant QNmeaSatelliteInfoSource::backendProperty(const QString &name) const
         else
             return d->m_simulationUpdateInterval;
     }
+    if (name == SimulationIndex && d->m_updateMode == UpdateMode::SimulationMode)
+        return d->m_saveLogIndex;
     return QVariant();
 }
 
@@ -841,8 +923,16 @@ QNmeaSatelliteRealTimeReader::QNmeaSatelliteRealTimeReader(QNmeaSatelliteInfoSou
 
 void QNmeaSatelliteRealTimeReader::readAvailableData()
 {
-    while (m_proxy->m_device->canReadLine())
-        m_proxy->processNmeaData(m_proxy->m_pendingUpdate);
+    // Read everything available at once and split it into sentences
+    // ourselves, instead of one readLine() call per sentence.
+    char buf[4096];
+    qint64 size;
+    while ((size = m_proxy->m_device->read(buf, sizeof(buf))) > 0) {
+        m_scanner.addData(QByteArrayView{buf, static_cast<qsizetype>(size)},
+                          [this](QByteArrayView sentence) {
+            m_proxy->processNmeaSentence(sentence, m_proxy->m_pendingUpdate);
+        });
+    }
     m_proxy->notifyNewUpdate();
 }
 
@@ -7,6 +7,7 @@
 
 QT_BEGIN_NAMESPACE
 
+class QDateTime;
 class QIODevice;
 
 class QNmeaSatelliteInfoSourcePrivate;
@@ -20,6 +21,7 @@ public:
     };
 
     static QString SimulationUpdateInterval;
+    static QString SimulationIndex;
 
     explicit QNmeaSatelliteInfoSource(UpdateMode mode, QObject *parent = nullptr);
     ~QNmeaSatelliteInfoSource() override;
@@ -29,6 +31,8 @@ public:
     void setDevice(QIODevice *source);
     QIODevice *device() const;
 
+    bool seek(const QDateTime &timestamp);
+
     void setUpdateInterval(int msec) override;
     int minimumUpdateInterval() const override;
     Error error() const override;
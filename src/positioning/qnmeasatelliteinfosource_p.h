@@ -17,6 +17,9 @@
 
 #include "qnmeasatelliteinfosource.h"
 #include <QtPositioning/qgeosatelliteinfo.h>
+#include <QtPositioning/private/qnmealogindex_p.h>
+#include <QtPositioning/private/qnmeasentencedispatcher_p.h>
+#include <QtPositioning/private/qnmeasentencescanner_p.h>
 
 #include <QObject>
 #include <QQueue>
@@ -76,8 +79,19 @@ public:
     void startUpdates();
     void stopUpdates();
     void requestUpdate(int msec);
+    bool seek(const QDateTime &timestamp);
     void notifyNewUpdate();
     void processNmeaData(QNmeaSatelliteInfoUpdate &updateInfo);
+    void processNmeaSentence(QByteArrayView sentence, QNmeaSatelliteInfoUpdate &updateInfo);
+
+    static QNmeaSatelliteInfoSourcePrivate *get(QNmeaSatelliteInfoSource *source)
+    {
+        return source->d;
+    }
+
+    // Used instead of reading m_device when a dispatcher reads it
+    void addDispatchedSentence(QByteArrayView sentence);
+    void dispatchFinished();
 
 public slots:
     void readyRead();
@@ -89,6 +103,7 @@ public:
     QNmeaSatelliteInfoSource *m_source = nullptr;
     QGeoSatelliteInfoSource::Error m_satelliteError = QGeoSatelliteInfoSource::NoError;
     QPointer<QIODevice> m_device;
+    QPointer<QNmeaSentenceDispatcher> m_dispatcher;
     QNmeaSatelliteInfoUpdate m_pendingUpdate;
     QNmeaSatelliteInfoUpdate m_lastUpdate;
     bool m_invokedStart = false;
@@ -100,6 +115,8 @@ public:
     QScopedPointer<QNmeaSatelliteReader> m_nmeaReader;
     QNmeaSatelliteInfoSource::UpdateMode m_updateMode;
     int m_simulationUpdateInterval = 100;
+    QNmeaLogIndex m_logIndex; // built by the first seek()
+    bool m_saveLogIndex = false;
 
 protected:
     bool openSourceDevice();
@@ -126,6 +143,9 @@ class QNmeaSatelliteRealTimeReader : public QNmeaSatelliteReader
 public:
     QNmeaSatelliteRealTimeReader(QNmeaSatelliteInfoSourcePrivate *sourcePrivate);
     void readAvailableData() override;
+
+private:
+    QNmeaSentenceScanner m_scanner;
 };
 
 class QNmeaSatelliteSimulationReader : public QNmeaSatelliteReader
@@ -0,0 +1,107 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+#include "qnmeasentencedispatcher_p.h"
+#include "qnmeapositioninfosource_p.h"
+#include "qnmeasatelliteinfosource_p.h"
+#include "qlocationutils_p.h"
+
+QT_BEGIN_NAMESPACE
+
+QNmeaSentenceDispatcher::QNmeaSentenceDispatcher(QIODevice *device, QObject *parent)
+    : QObject(parent), m_device(device)
+{
+    connect(device, &QIODevice::readyRead, this, &QNmeaSentenceDispatcher::readAvailableData);
+}
+
+QNmeaSentenceDispatcher::~QNmeaSentenceDispatcher()
+    = default;
+
+bool QNmeaSentenceDispatcher::addSource(QNmeaPositionInfoSource *source)
+{
+    if (source->updateMode() != QNmeaPositionInfoSource::RealTimeMode) {
+        qWarning("QNmeaSentenceDispatcher: only sources in RealTimeMode can be added");
+        return false;
+    }
+    source->setDevice(m_device);
+    QNmeaPositionInfoSourcePrivate::get(source)->m_dispatcher = this;
+    m_positionSources.removeIf([](const auto &s) { return s == nullptr; });
+    m_positionSources.append(source);
+    return true;
+}
+
+bool QNmeaSentenceDispatcher::addSource(QNmeaSatelliteInfoSource *source)
+{
+    if (source->updateMode() != QNmeaSatelliteInfoSource::UpdateMode::RealTimeMode) {
+        qWarning("QNmeaSentenceDispatcher: only sources in RealTimeMode can be added");
+        return false;
+    }
+    source->setDevice(m_device);
+    QNmeaSatelliteInfoSourcePrivate::get(source)->m_dispatcher = this;
+    m_satelliteSources.removeIf([](const auto &s) { return s == nullptr; });
+    m_satelliteSources.append(source);
+    return true;
+}
+
+void QNmeaSentenceDispatcher::readAvailableData()
+{
+    if (!m_device)
+        return;
+
+    char buf[4096];
+    qint64 size;
+    while ((size = m_device->read(buf, sizeof(buf))) > 0) {
+        m_scanner.addData(QByteArrayView{buf, static_cast<qsizetype>(size)},
+                          [this](QByteArrayView sentence) { dispatchSentence(sentence); });
+    }
+
+    // Sources may be added or deleted by the slots connected to their
+    // updates, so the lists are not iterated with iterators.
+    for (qsizetype i = 0; i < m_positionSources.size(); ++i) {
+        if (QNmeaPositionInfoSource *source = m_positionSources.at(i))
+            QNmeaPositionInfoSourcePrivate::get(source)->dispatchFinished();
+    }
+    for (qsizetype i = 0; i < m_satelliteSources.size(); ++i) {
+        if (QNmeaSatelliteInfoSource *source = m_satelliteSources.at(i))
+            QNmeaSatelliteInfoSourcePrivate::get(source)->dispatchFinished();
+    }
+}
+
+void QNmeaSentenceDispatcher::dispatchSentence(QByteArrayView sentence)
+{
+    bool position = false;
+    bool satellites = false;
+    switch (QLocationUtils::getNmeaSentenceTypeUnchecked(sentence)) {
+    case QLocationUtils::NmeaSentenceGGA:
+    case QLocationUtils::NmeaSentenceGLL:
+    case QLocationUtils::NmeaSentenceRMC:
+    case QLocationUtils::NmeaSentenceVTG:
+    case QLocationUtils::NmeaSentenceZDA:
+        position = true;
+        break;
+    case QLocationUtils::NmeaSentenceGSV:
+        satellites = true;
+        break;
+    case QLocationUtils::NmeaSentenceGSA:
+        position = satellites = true;
+        break;
+    default:
+        return;
+    }
+
+    if (position) {
+        for (qsizetype i = 0; i < m_positionSources.size(); ++i) {
+            if (QNmeaPositionInfoSource *source = m_positionSources.at(i))
+                QNmeaPositionInfoSourcePrivate::get(source)->addDispatchedSentence(sentence);
+        }
+    }
+    if (satellites) {
+        for (qsizetype i = 0; i < m_satelliteSources.size(); ++i) {
+            if (QNmeaSatelliteInfoSource *source = m_satelliteSources.at(i))
+                QNmeaSatelliteInfoSourcePrivate::get(source)->addDispatchedSentence(sentence);
+        }
+    }
+}
+
+QT_END_NAMESPACE
+
+#include "moc_qnmeasentencedispatcher_p.cpp"
@@ -0,0 +1,67 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+#ifndef QNMEASENTENCEDISPATCHER_P_H
+#define QNMEASENTENCEDISPATCHER_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtPositioning/private/qpositioningglobal_p.h>
+#include <QtPositioning/private/qnmeasentencescanner_p.h>
+
+#include <QtCore/QList>
+#include <QtCore/QObject>
+#include <QtCore/QPointer>
+#include <QtCore/qiodevice.h>
+
+QT_BEGIN_NAMESPACE
+
+class QNmeaPositionInfoSource;
+class QNmeaSatelliteInfoSource;
+
+/*
+    Reads the NMEA stream of one receiver for all the RealTimeMode position
+    and satellite sources using it, so that the stream is read, split into
+    sentences and classified only once.
+
+    Every sentence is handed only to the sources that use its type: GGA, GLL,
+    RMC, VTG and ZDA to the position sources, GSV to the satellite sources,
+    and GSA, which has both the satellites in use and the dilution of
+    precision, to both. The checksum is checked by the parser of the source.
+
+    addSource() sets the device of the source. The source does not read from
+    it as long as the dispatcher exists.
+*/
+class Q_POSITIONING_EXPORT QNmeaSentenceDispatcher : public QObject
+{
+    Q_OBJECT
+public:
+    explicit QNmeaSentenceDispatcher(QIODevice *device, QObject *parent = nullptr);
+    ~QNmeaSentenceDispatcher() override;
+
+    QIODevice *device() const { return m_device; }
+
+    bool addSource(QNmeaPositionInfoSource *source);
+    bool addSource(QNmeaSatelliteInfoSource *source);
+
+private:
+    void readAvailableData();
+    void dispatchSentence(QByteArrayView sentence);
+
+    QPointer<QIODevice> m_device;
+    QList<QPointer<QNmeaPositionInfoSource>> m_positionSources;
+    QList<QPointer<QNmeaSatelliteInfoSource>> m_satelliteSources;
+    QNmeaSentenceScanner m_scanner;
+};
+
+QT_END_NAMESPACE
+
+#endif // QNMEASENTENCEDISPATCHER_P_H
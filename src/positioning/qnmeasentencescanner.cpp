@@ -0,0 +1,186 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+#include "qnmeasentencescanner_p.h"
+
+#include <QtCore/qalgorithms.h>
+#include <QtCore/private/qsimd_p.h>
+#include <QtCore/private/qtools_p.h>
+
+#include <string.h>
+
+QT_BEGIN_NAMESPACE
+
+// Each of the functions below calls \a function for every '\n' in the
+// complete blocks of [p, end), and returns where the unscanned rest starts.
+
+#if defined(Q_PROCESSOR_X86) && QT_COMPILER_SUPPORTS_HERE(AVX2)
+template <typename Function>
+static QT_FUNCTION_TARGET(AVX2)
+const char *qnmeasentencescanner_newlinesAvx2(const char *p, const char *end, Function &function)
+{
+    const __m256i newline = _mm256_set1_epi8('\n');
+    for (; end - p >= 32; p += 32) {
+        const __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+        uint mask = uint(_mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, newline)));
+        for (; mask; mask &= mask - 1)
+            function(p + qCountTrailingZeroBits(mask));
+    }
+    return p;
+}
+#endif
+
+#ifdef __SSE2__
+template <typename Function>
+static const char *qnmeasentencescanner_newlinesSse2(const char *p, const char *end,
+                                                     Function &function)
+{
+    const __m128i newline = _mm_set1_epi8('\n');
+    for (; end - p >= 16; p += 16) {
+        const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+        uint mask = uint(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, newline)));
+        for (; mask; mask &= mask - 1)
+            function(p + qCountTrailingZeroBits(mask));
+    }
+    return p;
+}
+#endif
+
+template <typename Function>
+static void qnmeasentencescanner_forEachNewline(const char *p, const char *end, Function function)
+{
+#if defined(Q_PROCESSOR_X86) && QT_COMPILER_SUPPORTS_HERE(AVX2)
+    if (qCpuHasFeature(AVX2))
+        p = qnmeasentencescanner_newlinesAvx2(p, end, function);
+#endif
+#ifdef __SSE2__
+    p = qnmeasentencescanner_newlinesSse2(p, end, function);
+#endif
+    while (p != end) {
+        p = static_cast<const char *>(memchr(p, '\n', end - p));
+        if (!p)
+            break;
+        function(p);
+        ++p;
+    }
+}
+
+// XORs the bytes from \a p up to the first '*' or \a end into \a sum, and
+// returns the position of that '*', or \a end.
+static const char *qnmeasentencescanner_xorUntilAsterisk(const char *p, const char *end,
+                                                         uint *sum)
+{
+    uint result = 0;
+#ifdef __SSE2__
+    const __m128i asterisk = _mm_set1_epi8('*');
+    const __m128i indices = _mm_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+    __m128i acc = _mm_setzero_si128();
+    for (; end - p >= 16; p += 16) {
+        const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+        const uint mask = uint(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, asterisk)));
+        if (mask) {
+            // only the bytes before the '*' count
+            const int index = qCountTrailingZeroBits(mask);
+            const __m128i before = _mm_cmplt_epi8(indices, _mm_set1_epi8(char(index)));
+            acc = _mm_xor_si128(acc, _mm_and_si128(chunk, before));
+            p += index;
+            break;
+        }
+        acc = _mm_xor_si128(acc, chunk);
+    }
+    acc = _mm_xor_si128(acc, _mm_srli_si128(acc, 8));
+    acc = _mm_xor_si128(acc, _mm_srli_si128(acc, 4));
+    acc = _mm_xor_si128(acc, _mm_srli_si128(acc, 2));
+    acc = _mm_xor_si128(acc, _mm_srli_si128(acc, 1));
+    result = uint(_mm_cvtsi128_si32(acc)) & 0xff;
+#endif
+    for (; p != end && *p != '*'; ++p)
+        result ^= uchar(*p);
+    *sum = result;
+    return p;
+}
+
+/*
+    Passes every complete sentence in \a data to \a callback, and returns the
+    number of bytes consumed, that is, up to and including the last line break.
+*/
+qsizetype QNmeaSentenceScanner::scanSentences(QByteArrayView data, SentenceCallback callback)
+{
+    const char *begin = data.data();
+    const char *sentence = begin;
+    qnmeasentencescanner_forEachNewline(begin, begin + data.size(), [&](const char *newline) {
+        callback(QByteArrayView(sentence, newline + 1));
+        sentence = newline + 1;
+    });
+    return sentence - begin;
+}
+
+/*
+    Passes every sentence completed by \a data to \a callback.
+*/
+void QNmeaSentenceScanner::addData(QByteArrayView data, SentenceCallback callback)
+{
+    if (!m_partialSentence.isEmpty()) {
+        const qsizetype end = data.indexOf('\n');
+        if (end < 0) {
+            appendPartialSentence(data);
+            return;
+        }
+        m_partialSentence.append(data.first(end + 1));
+        callback(m_partialSentence);
+        m_partialSentence.truncate(0); // keeps the capacity for the next one
+        data = data.sliced(end + 1);
+    }
+
+    const qsizetype consumed = scanSentences(data, callback);
+    if (consumed < data.size())
+        appendPartialSentence(data.sliced(consumed));
+}
+
+void QNmeaSentenceScanner::appendPartialSentence(QByteArrayView data)
+{
+    // Do not buffer endlessly if the device never sends a line break
+    if (m_partialSentence.size() + data.size() > MaxPartialSentenceLength)
+        m_partialSentence.truncate(0);
+    else
+        m_partialSentence.append(data);
+}
+
+/*
+    Returns whether the XOR of all characters between the leading '$' and the
+    '*' of \a sentence matches the two hex digits following the '*'.
+*/
+bool QNmeaSentenceScanner::hasValidChecksum(QByteArrayView sentence)
+{
+    if (sentence.isEmpty())
+        return false;
+
+    const char *begin = sentence.data();
+    const char *end = begin + sentence.size();
+    uint sum = 0;
+    const char *asterisk = *begin == '*'
+            ? begin
+            : qnmeasentencescanner_xorUntilAsterisk(begin + 1, end, &sum);
+
+    constexpr qsizetype ChecksumLength = 2;
+    if (end - asterisk <= ChecksumLength)
+        return false;
+
+    int checksum;
+    const int high = QtMiscUtils::fromHex(uint(uchar(asterisk[1])));
+    const int low = QtMiscUtils::fromHex(uint(uchar(asterisk[2])));
+    if (high >= 0 && low >= 0) {
+        checksum = high * 16 + low;
+    } else {
+        // whatever else QByteArrayView::toInt() accepts
+        bool ok = false;
+        checksum = QByteArrayView(asterisk + 1, ChecksumLength).toInt(&ok, 16);
+        if (!ok)
+            return false;
+    }
+
+    // The characters used to be XORed as char, so where char is signed the
+    // sum of an odd number of bytes >= 0x80 was sign-extended and never matched.
+    return checksum == static_cast<char>(sum);
+}
+
+QT_END_NAMESPACE
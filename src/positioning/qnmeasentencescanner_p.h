@@ -0,0 +1,58 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+#ifndef QNMEASENTENCESCANNER_P_H
+#define QNMEASENTENCESCANNER_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtPositioning/private/qpositioningglobal_p.h>
+
+#include <QtCore/QByteArray>
+#include <QtCore/QByteArrayView>
+#include <QtCore/qxpfunctional.h>
+
+QT_BEGIN_NAMESPACE
+
+/*
+    Splits a stream of NMEA data into sentences, a whole chunk of data at a
+    time instead of one readLine() call per sentence. The line breaks, and the
+    checksum delimiters in hasValidChecksum(), are found with SSE2 or AVX2 where
+    available.
+
+    The sentences passed to the callback include their line break, just as
+    QIODevice::readLine() returns them. A sentence that is not complete at the
+    end of a chunk is kept and completed by the next call to addData().
+*/
+class Q_POSITIONING_EXPORT QNmeaSentenceScanner
+{
+public:
+    using SentenceCallback = qxp::function_ref<void(QByteArrayView sentence)>;
+
+    // Incomplete sentences growing longer than this are dropped
+    static constexpr qsizetype MaxPartialSentenceLength = 1024;
+
+    void addData(QByteArrayView data, SentenceCallback callback);
+    void clear() { m_partialSentence.clear(); }
+    bool hasPartialSentence() const { return !m_partialSentence.isEmpty(); }
+
+    static qsizetype scanSentences(QByteArrayView data, SentenceCallback callback);
+    static bool hasValidChecksum(QByteArrayView sentence);
+
+private:
+    void appendPartialSentence(QByteArrayView data);
+
+    QByteArray m_partialSentence;
+};
+
+QT_END_NAMESPACE
+
+#endif // QNMEASENTENCESCANNER_P_H
@@ -27,6 +27,7 @@ class Q_POSITIONING_EXPORT QWebMercator
 {
 public:
     static QDoubleVector2D coordToMercator(const QGeoCoordinate &coord);
+    static QDoubleVector2D coordToMercator(double latitude, double longitude);
     static QGeoCoordinate mercatorToCoord(const QDoubleVector2D &mercator);
     static QGeoCoordinate coordinateInterpolation(const QGeoCoordinate &from, const QGeoCoordinate &to, qreal progress);
 
@@ -13,6 +13,8 @@
 #include <QDebug>
 #include <QDataStream>
 #include <QFile>
+#include <QRandomGenerator>
+#include <QSet>
 
 #include <QtPositioning/qgeoareamonitorinfo.h>
 #include <QtPositioning/qgeoareamonitorsource.h>
@@ -124,6 +126,149 @@ private:
 
 const QString DummyMonitorSource::kTestProperty = "TestProperty";
 
+// Reports the positions it is moved to right away
+class ManualPositionSource : public QGeoPositionInfoSource
+{
+    Q_OBJECT
+public:
+    ManualPositionSource(QObject *parent = nullptr) : QGeoPositionInfoSource(parent)
+    {}
+
+    QGeoPositionInfo lastKnownPosition(bool fromSatellitePositioningMethodsOnly = false) const override
+    {
+        Q_UNUSED(fromSatellitePositioningMethodsOnly);
+        return lastPosition;
+    }
+    PositioningMethods supportedPositioningMethods() const override
+    {
+        return AllPositioningMethods;
+    }
+    int minimumUpdateInterval() const override
+    {
+        return 0;
+    }
+    Error error() const override
+    {
+        return NoError;
+    }
+
+    void startUpdates() override {}
+    void stopUpdates() override {}
+    void requestUpdate(int timeout = 5000) override
+    {
+        Q_UNUSED(timeout);
+    }
+
+    void moveTo(const QGeoCoordinate &coordinate)
+    {
+        lastPosition = QGeoPositionInfo(coordinate, QDateTime::currentDateTimeUtc());
+        emit positionUpdated(lastPosition);
+    }
+
+private:
+    QGeoPositionInfo lastPosition;
+};
+
+/*
+    Drives the positionpoll monitors with a ManualPositionSource, and checks
+    the events at every position against testing every monitor, which is
+    what the spatial index of the polling monitors has to be equivalent to.
+*/
+class MonitorTester
+{
+public:
+    MonitorTester()
+        : monitorSource(QGeoAreaMonitorSource::createSource(QStringLiteral("positionpoll"),
+                                                            nullptr)),
+          positionSource(new ManualPositionSource), // owned by the monitors
+          enteredSpy(monitorSource.get(), &QGeoAreaMonitorSource::areaEntered),
+          exitedSpy(monitorSource.get(), &QGeoAreaMonitorSource::areaExited)
+    {
+        if (monitorSource)
+            monitorSource->setPositionInfoSource(positionSource);
+    }
+
+    bool isValid() const
+    {
+        return monitorSource && monitorSource->positionInfoSource() == positionSource;
+    }
+
+    bool start(const QString &identifier, const QGeoShape &area)
+    {
+        QGeoAreaMonitorInfo monitor(identifier);
+        monitor.setArea(area);
+        if (!monitorSource->startMonitoring(monitor))
+            return false;
+        monitors.insert(identifier, monitor);
+        return true;
+    }
+
+    // a stopped monitor forgets whether we are inside of its area
+    bool stop(const QString &identifier)
+    {
+        inside.remove(identifier);
+        return monitorSource->stopMonitoring(monitors.take(identifier));
+    }
+
+    // Small rectangles in a grid, which makes the cells of the index small
+    void startGrid(const QString &prefix, const QGeoCoordinate &origin, int count)
+    {
+        for (int i = 0; i < count; ++i) {
+            for (int j = 0; j < count; ++j) {
+                const QGeoCoordinate center(origin.latitude() + i * 0.02,
+                                            origin.longitude() + j * 0.02);
+                QVERIFY(start(prefix + QString::number(i * count + j),
+                              QGeoRectangle(center, 0.01, 0.01)));
+            }
+        }
+    }
+
+    void moveTo(const QGeoCoordinate &coordinate)
+    {
+        QStringList expectedEntered;
+        QStringList expectedExited;
+        for (const QGeoAreaMonitorInfo &monitor : std::as_const(monitors)) {
+            const QString identifier = monitor.identifier();
+            if (monitor.area().contains(coordinate)) {
+                if (!inside.contains(identifier)) {
+                    inside.insert(identifier);
+                    expectedEntered.append(identifier);
+                }
+            } else if (inside.remove(identifier)) {
+                expectedExited.append(identifier);
+            }
+        }
+
+        positionSource->moveTo(coordinate);
+        entered = takeIdentifiers(enteredSpy);
+        exited = takeIdentifiers(exitedSpy);
+        expectedEntered.sort();
+        expectedExited.sort();
+        QCOMPARE(entered, expectedEntered);
+        QCOMPARE(exited, expectedExited);
+    }
+
+    QStringList entered; // by the last moveTo(), sorted
+    QStringList exited;
+
+private:
+    static QStringList takeIdentifiers(QSignalSpy &spy)
+    {
+        QStringList identifiers;
+        while (!spy.isEmpty())
+            identifiers.append(spy.takeFirst().at(0).value<QGeoAreaMonitorInfo>().identifier());
+        identifiers.sort();
+        return identifiers;
+    }
+
+    std::unique_ptr<QGeoAreaMonitorSource> monitorSource;
+    ManualPositionSource *positionSource;
+    QSignalSpy enteredSpy;
+    QSignalSpy exitedSpy;
+    QHash<QString, QGeoAreaMonitorInfo> monitors;
+    QSet<QString> inside;
+};
+
 class tst_QGeoAreaMonitorSource : public QObject
 {
     Q_OBJECT
@@ -903,6 +1048,140 @@ private slots:
         QCOMPARE(updatesStoppedSpy.size(), 1);
     }
 
+    void tst_manyMonitors()
+    {
+        // more monitors than it takes to rebuild the index, started while
+        // moving around, some of them replaced or restarted on the way
+        MonitorTester tester;
+        QVERIFY(tester.isValid());
+        QRandomGenerator random(11);
+        const QGeoCoordinate origin(10.0, 20.0);
+        const auto randomCoordinate = [&] {
+            return QGeoCoordinate(origin.latitude() - 0.02 + 0.3 * random.generateDouble(),
+                                  origin.longitude() - 0.02 + 0.3 * random.generateDouble());
+        };
+        QGeoCoordinate position = origin;
+        for (int step = 0; step < 600; ++step) {
+            if (step % 4 == 0 && step < 400) {
+                const int i = step / 4;
+                const QGeoCoordinate center(origin.latitude() + (i / 12) * 0.02,
+                                            origin.longitude() + (i % 12) * 0.02);
+                const QString identifier = QStringLiteral("Fence") + QString::number(i);
+                if (i % 5 == 0)
+                    QVERIFY(tester.start(identifier, QGeoCircle(center, 800)));
+                else
+                    QVERIFY(tester.start(identifier, QGeoRectangle(center, 0.01, 0.01)));
+            }
+            if (step % 37 == 0 && step > 0) {
+                const QString identifier = QStringLiteral("Fence")
+                        + QString::number(random.bounded(qMin(step / 4, 100)));
+                if (random.bounded(2))
+                    QVERIFY(tester.start(identifier, QGeoRectangle(randomCoordinate(), 0.01, 0.01)));
+                else if (tester.stop(identifier))
+                    QVERIFY(tester.start(identifier, QGeoRectangle(position, 0.01, 0.01)));
+            }
+
+            if (random.bounded(10) == 0) {
+                position = randomCoordinate(); // leaves areas nowhere near the new position
+            } else {
+                position = QGeoCoordinate(position.latitude() + 0.008 * (random.generateDouble() - 0.5),
+                                          position.longitude() + 0.008 * (random.generateDouble() - 0.5));
+            }
+            tester.moveTo(position);
+            if (QTest::currentTestFailed())
+                return;
+        }
+    }
+
+    void tst_monitorAcrossDateline()
+    {
+        MonitorTester tester;
+        QVERIFY(tester.isValid());
+        tester.startGrid(QStringLiteral("Grid"), QGeoCoordinate(-20.5, 179.5), 10);
+        QVERIFY(tester.start(QStringLiteral("Dateline"),
+                             QGeoRectangle(QGeoCoordinate(-20.005, 179.995),
+                                           QGeoCoordinate(-20.015, -179.995))));
+
+        tester.moveTo(QGeoCoordinate(-20.01, 179.998));
+        QCOMPARE(tester.entered, QStringList{ QStringLiteral("Dateline") });
+        tester.moveTo(QGeoCoordinate(-20.01, -179.998));
+        QVERIFY(tester.entered.isEmpty());
+        QVERIFY(tester.exited.isEmpty());
+        tester.moveTo(QGeoCoordinate(-20.01, -179.99));
+        QCOMPARE(tester.exited, QStringList{ QStringLiteral("Dateline") });
+        tester.moveTo(QGeoCoordinate(-20.01, 179.999));
+        QCOMPARE(tester.entered, QStringList{ QStringLiteral("Dateline") });
+    }
+
+    void tst_wideMonitor()
+    {
+        // covers too many cells of the index to be registered in them
+        MonitorTester tester;
+        QVERIFY(tester.isValid());
+        tester.startGrid(QStringLiteral("Grid"), QGeoCoordinate(30.0, 30.0), 5);
+        QVERIFY(tester.start(QStringLiteral("Wide"), QGeoCircle(QGeoCoordinate(0, 0), 1000000)));
+
+        tester.moveTo(QGeoCoordinate(5.0, 5.0));
+        QCOMPARE(tester.entered, QStringList{ QStringLiteral("Wide") });
+        tester.moveTo(QGeoCoordinate(-5.0, -5.0));
+        QVERIFY(tester.entered.isEmpty());
+        QVERIFY(tester.exited.isEmpty());
+        tester.moveTo(QGeoCoordinate(9.0, 9.0));
+        QCOMPARE(tester.exited, QStringList{ QStringLiteral("Wide") });
+    }
+
+    void tst_exitFromPreviousCell()
+    {
+        // a jump away from a small area, whose cell is only that of the
+        // previous position
+        MonitorTester tester;
+        QVERIFY(tester.isValid());
+        tester.startGrid(QStringLiteral("Grid"), QGeoCoordinate(40.0, 40.0), 5);
+
+        tester.moveTo(QGeoCoordinate(40.0, 40.0));
+        QCOMPARE(tester.entered, QStringList{ QStringLiteral("Grid0") });
+        tester.moveTo(QGeoCoordinate(45.0, 45.0));
+        QCOMPARE(tester.exited, QStringList{ QStringLiteral("Grid0") });
+    }
+
+    void tst_replaceAreaWhileInside()
+    {
+        // the new area is not in the cell of the position, but it still has
+        // to be tested to detect that we have left the monitor
+        MonitorTester tester;
+        QVERIFY(tester.isValid());
+        tester.startGrid(QStringLiteral("Grid"), QGeoCoordinate(50.0, 50.0), 5);
+        const QGeoCoordinate position(50.5, 50.5);
+        QVERIFY(tester.start(QStringLiteral("Moved"), QGeoRectangle(position, 0.005, 0.005)));
+
+        tester.moveTo(position);
+        QCOMPARE(tester.entered, QStringList{ QStringLiteral("Moved") });
+        QVERIFY(tester.start(QStringLiteral("Moved"),
+                             QGeoRectangle(QGeoCoordinate(51.5, 51.5), 0.005, 0.005)));
+        tester.moveTo(QGeoCoordinate(50.5, 50.5001));
+        QCOMPARE(tester.exited, QStringList{ QStringLiteral("Moved") });
+    }
+
+    void tst_restartMonitor()
+    {
+        // a monitor stopped and started again with the same identifier is a
+        // new one, which we enter again
+        MonitorTester tester;
+        QVERIFY(tester.isValid());
+        tester.startGrid(QStringLiteral("Grid"), QGeoCoordinate(60.0, 60.0), 5);
+        const QGeoCoordinate position(60.5, 60.5);
+        const QGeoRectangle area(position, 0.005, 0.005);
+        QVERIFY(tester.start(QStringLiteral("Restarted"), area));
+
+        tester.moveTo(position);
+        QCOMPARE(tester.entered, QStringList{ QStringLiteral("Restarted") });
+        QVERIFY(tester.stop(QStringLiteral("Restarted")));
+        QVERIFY(tester.start(QStringLiteral("Restarted"), area));
+        tester.moveTo(QGeoCoordinate(60.5, 60.5001));
+        QCOMPARE(tester.entered, QStringList{ QStringLiteral("Restarted") });
+        QVERIFY(tester.exited.isEmpty());
+    }
+
     void backendProperties()
     {
         std::unique_ptr<QGeoAreaMonitorSource> obj = std::make_unique<DummyMonitorSource>();
@@ -10,8 +10,10 @@
 
 #include <QMetaType>
 #include <QDebug>
+#include <QtCore/qmath.h>
 
 #include <float.h>
+#include <cmath>
 
 QT_USE_NAMESPACE
 
@@ -27,6 +29,29 @@ static const QGeoCoordinate SOUTH_POLE(-90, 0);
 
 static const QChar DEGREES_SYMB(0x00B0);
 
+// A mix of coordinates far apart and close together, across the dateline
+// and at the poles, with some invalid ones.
+static QList<QGeoCoordinate> batchTestCoordinates()
+{
+    QList<QGeoCoordinate> coordinates = { BRISBANE, MELBOURNE, LONDON, NEW_YORK, NORTH_POLE,
+                                          SOUTH_POLE, QGeoCoordinate(), BRISBANE,
+                                          QGeoCoordinate(91, 0), QGeoCoordinate(0, 179.9),
+                                          QGeoCoordinate(0, -179.9), QGeoCoordinate(0, 0, 100) };
+    for (int i = 0; i < 1000; ++i) {
+        coordinates.append(QGeoCoordinate(std::fmod(i * 37.1, 180.0) - 90.0,
+                                          std::fmod(i * 73.3, 360.0) - 180.0));
+    }
+    for (int i = 0; i < 200; ++i)
+        coordinates.append(BRISBANE.atDistanceAndAzimuth(i * 0.37, i * 7.0));
+    return coordinates;
+}
+
+// see QGeoCoordinate::distancesTo() and azimuthsTo()
+static constexpr double MaxDistanceError = 1e-12;
+static constexpr double MaxAzimuthError = 1e-9;
+static constexpr double MinAntipodalDistance = 100000;
+static constexpr double HalfCircumference = 20015109.4154876769;
+
 
 QByteArray tst_qgeocoordinate_debug;
 
@@ -502,6 +527,90 @@ private slots:
                 << QGeoCoordinate(0.5,45.0,0.0) << QGeoCoordinate(0.5,-134.9999651,0.0)  << qreal(359.998);
     }
 
+    void distancesTo()
+    {
+        const QList<QGeoCoordinate> others = batchTestCoordinates();
+        for (const QGeoCoordinate &origin : { BRISBANE, NORTH_POLE, QGeoCoordinate(0, 179.9),
+                                              QGeoCoordinate() }) {
+            QList<qreal> distances(others.size() + 1, -1);
+            origin.distancesTo(others, distances);
+            QCOMPARE(distances.last(), qreal(-1)); // not written to
+
+            for (qsizetype i = 0; i < others.size(); ++i) {
+                const qreal expected = origin.distanceTo(others.at(i));
+                if (!origin.isValid() || !others.at(i).isValid()) {
+                    QCOMPARE(distances.at(i), qreal(0));
+                    continue;
+                }
+                if (expected > HalfCircumference - MinAntipodalDistance)
+                    continue;
+                QVERIFY2(qAbs(distances.at(i) - expected)
+                                 <= MaxDistanceError * qMax(expected, 1.0),
+                         qPrintable(QString::number(i)));
+            }
+        }
+    }
+
+    void azimuthsTo()
+    {
+        const QList<QGeoCoordinate> others = batchTestCoordinates();
+        for (const QGeoCoordinate &origin : { BRISBANE, NORTH_POLE, QGeoCoordinate(0, 179.9),
+                                              QGeoCoordinate() }) {
+            QList<qreal> azimuths(others.size());
+            origin.azimuthsTo(others, azimuths);
+
+            for (qsizetype i = 0; i < others.size(); ++i) {
+                const qreal azimuth = azimuths.at(i);
+                QVERIFY(azimuth >= 0.0);
+                QVERIFY(azimuth < 360.0);
+
+                const qreal expected = origin.azimuthTo(others.at(i));
+                if (!origin.isValid() || !others.at(i).isValid()) {
+                    QCOMPARE(azimuth, qreal(0));
+                    continue;
+                }
+                const qreal distance = origin.distanceTo(others.at(i));
+                if (distance > HalfCircumference - MinAntipodalDistance)
+                    continue;
+                // the azimuth between close coordinates is ill-conditioned
+                const qreal tolerance = MaxAzimuthError + qRadiansToDegrees(1e-7 / distance);
+                const qreal difference = qAbs(azimuth - expected);
+                QVERIFY2(qMin(difference, 360.0 - difference) <= tolerance,
+                         qPrintable(QString::number(i)));
+            }
+        }
+
+        // the poles, as in azimuthTo_data()
+        const QList<QGeoCoordinate> southPole = { SOUTH_POLE };
+        QList<qreal> azimuths(1);
+        NORTH_POLE.azimuthsTo(southPole, azimuths);
+        QCOMPARE(azimuths.at(0), qreal(180));
+    }
+
+    void consecutiveDistances()
+    {
+        const QList<QGeoCoordinate> path = batchTestCoordinates();
+        QList<qreal> distances(path.size(), -1);
+        QGeoCoordinate::consecutiveDistances(path, distances);
+        QCOMPARE(distances.last(), qreal(-1)); // not written to
+
+        for (qsizetype i = 0; i + 1 < path.size(); ++i) {
+            const qreal expected = path.at(i).distanceTo(path.at(i + 1));
+            if (!path.at(i).isValid() || !path.at(i + 1).isValid()) {
+                QCOMPARE(distances.at(i), qreal(0));
+                continue;
+            }
+            if (expected > HalfCircumference - MinAntipodalDistance)
+                continue;
+            QVERIFY2(qAbs(distances.at(i) - expected) <= MaxDistanceError * qMax(expected, 1.0),
+                     qPrintable(QString::number(i)));
+        }
+
+        // nothing to compute for less than two coordinates
+        QGeoCoordinate::consecutiveDistances({}, {});
+        QGeoCoordinate::consecutiveDistances(QSpan(path).first(1), {});
+    }
+
     void atDistanceAndAzimuth()
     {
         QFETCH(QGeoCoordinate, origin);
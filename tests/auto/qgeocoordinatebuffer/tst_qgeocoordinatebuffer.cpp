@@ -0,0 +1,194 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QtTest/QtTest>
+#include <QtPositioning/QGeoCoordinate>
+#include <QtPositioning/qgeocoordinatebuffer.h>
+
+QT_USE_NAMESPACE
+
+class tst_QGeoCoordinateBuffer : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void defaultConstructor();
+    void listConstructor();
+    void append();
+    void insertReplaceRemove();
+    void indexOf();
+    void arrays();
+    void implicitSharing();
+    void comparison();
+    void hashing();
+};
+
+static QList<QGeoCoordinate> testCoordinates()
+{
+    return { QGeoCoordinate(1, 1), QGeoCoordinate(2, 2, 100), QGeoCoordinate(3, 0),
+             QGeoCoordinate(-45.5, 179.5, -10), QGeoCoordinate(90, 10) };
+}
+
+void tst_QGeoCoordinateBuffer::defaultConstructor()
+{
+    QGeoCoordinateBuffer buffer;
+    QVERIFY(buffer.isEmpty());
+    QCOMPARE(buffer.size(), 0);
+    QVERIFY(buffer.latitudes().isEmpty());
+    QVERIFY(buffer.toList().isEmpty());
+}
+
+void tst_QGeoCoordinateBuffer::listConstructor()
+{
+    const QList<QGeoCoordinate> coords = testCoordinates();
+    QGeoCoordinateBuffer buffer(coords);
+    QCOMPARE(buffer.size(), coords.size());
+    for (qsizetype i = 0; i < coords.size(); ++i) {
+        QCOMPARE(buffer.at(i), coords.at(i));
+        QCOMPARE(buffer.at(i).type(), coords.at(i).type());
+    }
+    QCOMPARE(buffer.toList(), coords);
+}
+
+void tst_QGeoCoordinateBuffer::append()
+{
+    QGeoCoordinateBuffer buffer;
+    buffer.reserve(4);
+    buffer.append(QGeoCoordinate(1, 2));
+    buffer.append(3, 4);
+    buffer.append(5, 6, 7);
+    buffer.append(QGeoCoordinate());
+
+    QCOMPARE(buffer.size(), 4);
+    QCOMPARE(buffer.at(0), QGeoCoordinate(1, 2));
+    QCOMPARE(buffer.at(1), QGeoCoordinate(3, 4));
+    QCOMPARE(buffer.at(1).type(), QGeoCoordinate::Coordinate2D);
+    QCOMPARE(buffer.at(2), QGeoCoordinate(5, 6, 7));
+    QCOMPARE(buffer.at(2).type(), QGeoCoordinate::Coordinate3D);
+    QVERIFY(!buffer.at(3).isValid());
+
+    buffer.clear();
+    QVERIFY(buffer.isEmpty());
+}
+
+void tst_QGeoCoordinateBuffer::insertReplaceRemove()
+{
+    QList<QGeoCoordinate> coords = testCoordinates();
+    QGeoCoordinateBuffer buffer(coords);
+
+    const QGeoCoordinate c(10, 20, 30);
+    buffer.insert(0, c);
+    coords.insert(0, c);
+    buffer.insert(3, c);
+    coords.insert(3, c);
+    buffer.insert(buffer.size(), c);
+    coords.insert(coords.size(), c);
+    QCOMPARE(buffer.toList(), coords);
+
+    buffer.replace(1, QGeoCoordinate(-1, -1));
+    coords.replace(1, QGeoCoordinate(-1, -1));
+    QCOMPARE(buffer.toList(), coords);
+
+    buffer.remove(0);
+    coords.remove(0);
+    buffer.remove(1, 2);
+    coords.remove(1, 2);
+    QCOMPARE(buffer.toList(), coords);
+}
+
+void tst_QGeoCoordinateBuffer::indexOf()
+{
+    QList<QGeoCoordinate> coords = testCoordinates();
+    coords.append(coords.at(1));
+    const QGeoCoordinateBuffer buffer(coords);
+
+    for (const QGeoCoordinate &c : coords) {
+        QCOMPARE(buffer.indexOf(c), coords.indexOf(c));
+        QCOMPARE(buffer.lastIndexOf(c), coords.lastIndexOf(c));
+    }
+    QCOMPARE(buffer.indexOf(QGeoCoordinate(50, 50)), -1);
+    QCOMPARE(buffer.lastIndexOf(QGeoCoordinate(50, 50)), -1);
+    // the longitude does not matter at the poles
+    QCOMPARE(buffer.indexOf(QGeoCoordinate(90, -100)), 4);
+}
+
+void tst_QGeoCoordinateBuffer::arrays()
+{
+    const QList<QGeoCoordinate> coords = testCoordinates();
+    const QGeoCoordinateBuffer buffer(coords);
+
+    const QSpan<const double> latitudes = buffer.latitudes();
+    const QSpan<const double> longitudes = buffer.longitudes();
+    const QSpan<const double> altitudes = buffer.altitudes();
+    QCOMPARE(latitudes.size(), coords.size());
+    QCOMPARE(longitudes.size(), coords.size());
+    QCOMPARE(altitudes.size(), coords.size());
+    for (qsizetype i = 0; i < coords.size(); ++i) {
+        QCOMPARE(latitudes[i], coords.at(i).latitude());
+        QCOMPARE(longitudes[i], coords.at(i).longitude());
+        if (qIsNaN(coords.at(i).altitude()))
+            QVERIFY(qIsNaN(altitudes[i]));
+        else
+            QCOMPARE(altitudes[i], coords.at(i).altitude());
+    }
+
+    // the arrays are shared, not copied
+    const QGeoCoordinateBuffer copy = buffer;
+    QCOMPARE(copy.latitudes().data(), latitudes.data());
+}
+
+void tst_QGeoCoordinateBuffer::implicitSharing()
+{
+    const QList<QGeoCoordinate> coords = testCoordinates();
+    QGeoCoordinateBuffer buffer(coords);
+    QGeoCoordinateBuffer copy = buffer;
+
+    copy.replace(0, QGeoCoordinate(-5, -5));
+    QCOMPARE(buffer.toList(), coords);
+    QCOMPARE(copy.at(0), QGeoCoordinate(-5, -5));
+
+    QGeoCoordinateBuffer moved = std::move(copy);
+    QCOMPARE(moved.at(0), QGeoCoordinate(-5, -5));
+    moved.swap(buffer);
+    QCOMPARE(moved.toList(), coords);
+}
+
+void tst_QGeoCoordinateBuffer::comparison()
+{
+    const QList<QGeoCoordinate> coords = testCoordinates();
+    const QGeoCoordinateBuffer b1(coords);
+    QGeoCoordinateBuffer b2(coords);
+    QVERIFY(b1 == b2);
+    QVERIFY(!(b1 != b2));
+
+    b2.replace(4, QGeoCoordinate(90, -10)); // same pole
+    QVERIFY(b1 == b2);
+
+    b2.replace(0, QGeoCoordinate(1, 1.5));
+    QVERIFY(b1 != b2);
+
+    b2 = b1;
+    b2.remove(4);
+    QVERIFY(b1 != b2);
+
+    QVERIFY(QGeoCoordinateBuffer() == QGeoCoordinateBuffer(QList<QGeoCoordinate>()));
+}
+
+void tst_QGeoCoordinateBuffer::hashing()
+{
+    const QList<QGeoCoordinate> coords = testCoordinates();
+    const QGeoCoordinateBuffer b1(coords);
+    QGeoCoordinateBuffer b2(coords);
+    QCOMPARE(qHash(b1), qHash(b2));
+    QCOMPARE(qHash(b1, 7), qHash(b2, 7));
+
+    b2.replace(4, QGeoCoordinate(90, -10)); // same pole
+    QCOMPARE(qHash(b1), qHash(b2));
+
+    b2.replace(0, QGeoCoordinate(1, 1.5));
+    QVERIFY(qHash(b1) != qHash(b2));
+}
+
+QTEST_APPLESS_MAIN(tst_QGeoCoordinateBuffer)
+
+#include "tst_qgeocoordinatebuffer.moc"
@@ -5,9 +5,122 @@
 #include <QtPositioning/QGeoCoordinate>
 #include <QtPositioning/QGeoRectangle>
 #include <QtPositioning/QGeoPath>
+#include <QtPositioning/qgeocoordinatebuffer.h>
+#include <QtPositioning/private/qgeopath_p.h>
+#include <QtPositioning/private/qwebmercator_p.h>
+#include <QtPositioning/private/qdoublevector2d_p.h>
 
 QT_USE_NAMESPACE
 
+// The closest point to coordinate of each segment of path, tested one by one
+template <typename Function>
+static void referenceForEachSegment(const QGeoPath &path, const QGeoCoordinate &coordinate,
+                                    Function function)
+{
+    const QList<QGeoCoordinate> &coords = path.path();
+    const double leftBound =
+            QWebMercator::coordToMercator(path.boundingGeoRectangle().topLeft()).x();
+    const auto unwrapped = [leftBound](const QGeoCoordinate &c) {
+        QDoubleVector2D crd = QWebMercator::coordToMercator(c);
+        if (crd.x() < leftBound)
+            crd.setX(crd.x() + leftBound);
+        return crd;
+    };
+
+    const QDoubleVector2D p = unwrapped(coordinate);
+    for (qsizetype i = 1; i < coords.size(); ++i) {
+        const QDoubleVector2D a = unwrapped(coords.at(i - 1));
+        const QDoubleVector2D b = unwrapped(coords.at(i));
+        QDoubleVector2D candidate = (p - a).length() < (p - b).length() ? a : b;
+        if (a != b) {
+            const double u = ((p.x() - a.x()) * (b.x() - a.x()) + (p.y() - a.y()) * (b.y() - a.y()))
+                    / (b - a).lengthSquared();
+            const QDoubleVector2D intersection(a.x() + u * (b.x() - a.x()),
+                                               a.y() + u * (b.y() - a.y()));
+            if (u > 0 && u < 1 && (p - intersection).length() < (p - candidate).length())
+                candidate = intersection;
+        }
+        if (candidate.x() > 1.0)
+            candidate.setX(candidate.x() - leftBound);
+        if (function(i - 1, a == b, QWebMercator::mercatorToCoord(candidate)))
+            return;
+    }
+}
+
+// The linear test of every segment QGeoPath::contains() used to do; long
+// paths only test the segments near the coordinate, with the same results.
+static bool referenceContains(const QGeoPath &path, const QGeoCoordinate &coordinate)
+{
+    const QList<QGeoCoordinate> &coords = path.path();
+    const double lineRadius = qMax(path.width() * 0.5, 0.2);
+    if (coords.size() < 2)
+        return !coords.isEmpty() && coords.first().distanceTo(coordinate) <= lineRadius;
+
+    bool contains = false;
+    referenceForEachSegment(path, coordinate,
+                            [&](qsizetype, bool degenerate, const QGeoCoordinate &closest) {
+        contains = !degenerate && coordinate.distanceTo(closest) <= lineRadius;
+        return contains;
+    });
+    return contains || coords.first().distanceTo(coordinate) <= lineRadius;
+}
+
+// The direction of the sum of the coordinates as unit vectors
+static QGeoCoordinate referenceCentroid(const QList<QGeoCoordinate> &coords)
+{
+    double x = 0;
+    double y = 0;
+    double z = 0;
+    for (const QGeoCoordinate &c : coords) {
+        const double latitude = qDegreesToRadians(c.latitude());
+        const double longitude = qDegreesToRadians(c.longitude());
+        x += std::cos(latitude) * std::cos(longitude);
+        y += std::cos(latitude) * std::sin(longitude);
+        z += std::sin(latitude);
+    }
+    return QGeoCoordinate(qRadiansToDegrees(std::atan2(z, std::hypot(x, y))),
+                          qRadiansToDegrees(std::atan2(y, x)));
+}
+
+static bool fuzzyCompareCoordinates(const QGeoCoordinate &a, const QGeoCoordinate &b)
+{
+    return qAbs(a.latitude() - b.latitude()) < 1e-9
+            && qAbs(QLocationUtils::wrapLong(a.longitude() - b.longitude())) < 1e-9;
+}
+
+static QGeoCoordinate referenceNearest(const QGeoPath &path, const QGeoCoordinate &coordinate,
+                                       qsizetype *segmentIndex)
+{
+    double nearestDistance = qInf();
+    QGeoCoordinate nearest;
+    *segmentIndex = -1;
+    referenceForEachSegment(path, coordinate,
+                            [&](qsizetype segment, bool, const QGeoCoordinate &closest) {
+        if (coordinate.distanceTo(closest) < nearestDistance) {
+            nearestDistance = coordinate.distanceTo(closest);
+            nearest = closest;
+            *segmentIndex = segment;
+        }
+        return false;
+    });
+    return nearest;
+}
+
+// A random walk of vertexCount elements, wrapped at the dateline
+static QList<QGeoCoordinate> randomWalk(QRandomGenerator &random, double latitude,
+                                        double longitude, double step, int vertexCount)
+{
+    QList<QGeoCoordinate> coords;
+    for (int i = 0; i < vertexCount; ++i) {
+        coords.append(QGeoCoordinate(latitude, longitude));
+        latitude = qBound(-89.0, latitude + step * (random.generateDouble() - 0.5), 89.0);
+        longitude += step * (random.generateDouble() - 0.2);
+        if (longitude > 180.0)
+            longitude -= 360.0;
+    }
+    return coords;
+}
+
 class tst_QGeoPath : public QObject
 {
     Q_OBJECT
@@ -15,14 +128,19 @@ class tst_QGeoPath : public QObject
 private slots:
     void defaultConstructor();
     void listConstructor();
+    void bufferConstructor();
     void assignment();
 
     void comparison();
     void type();
 
     void path();
+    void pathBuffer();
     void width();
     void size();
+    void length();
+    void lengthAfterEdits_data();
+    void lengthAfterEdits();
 
     void translate_data();
     void translate();
@@ -32,9 +150,25 @@ private slots:
 
     void contains_data();
     void contains();
+    void containsLongPath_data();
+    void containsLongPath();
+
+    void nearestCoordinate();
+    void nearestCoordinateLongPath_data();
+    void nearestCoordinateLongPath();
+
+    void simplified();
+    void simplifiedLongPath_data();
+    void simplifiedLongPath();
+    void simplifiedZigzag();
+    void addCoordinateSimplified();
 
     void boundingGeoRectangle_data();
     void boundingGeoRectangle();
+    void boundingGeoRectangleWhileAppending_data();
+    void boundingGeoRectangleWhileAppending();
+    void boundingGeoRectangleWhileSimplifying_data();
+    void boundingGeoRectangleWhileSimplifying();
 
     void hashing();
 };
@@ -63,6 +197,30 @@ void tst_QGeoPath::listConstructor()
     }
 }
 
+void tst_QGeoPath::bufferConstructor()
+{
+    QList<QGeoCoordinate> coords;
+    coords.append(QGeoCoordinate(1,1));
+    coords.append(QGeoCoordinate(2,2));
+    coords.append(QGeoCoordinate(3,0));
+    const QGeoCoordinateBuffer buffer(coords);
+
+    QGeoPath p(buffer, 1.0);
+    QCOMPARE(p.width(), qreal(1.0));
+    QCOMPARE(p.size(), 3);
+    QCOMPARE(p.path(), coords);
+    QCOMPARE(p.pathBuffer(), buffer);
+    QCOMPARE(p.pathBuffer().latitudes().data(), buffer.latitudes().data());
+    QCOMPARE(p, QGeoPath(coords, 1.0));
+    QCOMPARE(qHash(p), qHash(QGeoPath(coords, 1.0)));
+    QCOMPARE(p.boundingGeoRectangle(), QGeoPath(coords, 1.0).boundingGeoRectangle());
+
+    QGeoCoordinateBuffer invalid(buffer);
+    invalid.append(QGeoCoordinate());
+    p.setPath(invalid);
+    QCOMPARE(p.path(), coords);
+}
+
 void tst_QGeoPath::assignment()
 {
     QGeoPath p1;
@@ -161,6 +319,60 @@ void tst_QGeoPath::path()
     QVERIFY(p.boundingGeoRectangle().isEmpty());
 }
 
+void tst_QGeoPath::pathBuffer()
+{
+    // The list returned by path() is only built on demand, so it must follow
+    // every modification.
+    QList<QGeoCoordinate> coords;
+    coords.append(QGeoCoordinate(1,1));
+    coords.append(QGeoCoordinate(2,2));
+    coords.append(QGeoCoordinate(3,0));
+
+    QGeoPath p(coords);
+    QCOMPARE(p.path(), coords);
+
+    // a list returned before is not changed by later edits
+    const QList<QGeoCoordinate> before = p.path();
+    p.addCoordinate(QGeoCoordinate(4,4));
+    QCOMPARE(before, coords);
+    coords.append(QGeoCoordinate(4,4));
+    QCOMPARE(p.path(), coords);
+
+    p.insertCoordinate(1, QGeoCoordinate(5,5));
+    coords.insert(1, QGeoCoordinate(5,5));
+    QCOMPARE(p.path(), coords);
+
+    p.replaceCoordinate(0, p.path().at(2));
+    coords.replace(0, coords.at(2));
+    QCOMPARE(p.path(), coords);
+
+    p.removeCoordinate(QGeoCoordinate(4,4));
+    coords.removeLast();
+    QCOMPARE(p.path(), coords);
+
+    p.removeCoordinate(0);
+    coords.removeFirst();
+    QCOMPARE(p.path(), coords);
+
+    p.setPath(p.path());
+    QCOMPARE(p.path(), coords);
+
+    p.translate(1, 1);
+    for (QGeoCoordinate &c : coords)
+        c = QGeoCoordinate(c.latitude() + 1, c.longitude() + 1);
+    QCOMPARE(p.path(), coords);
+    QCOMPARE(p.pathBuffer().toList(), coords);
+
+    QGeoPath copy = p;
+    copy.addCoordinate(QGeoCoordinate(10, 10));
+    QCOMPARE(p.path(), coords);
+    QCOMPARE(copy.size(), coords.size() + 1);
+
+    p.clearPath();
+    QVERIFY(p.path().isEmpty());
+    QVERIFY(p.pathBuffer().isEmpty());
+}
+
 void tst_QGeoPath::width()
 {
     QGeoPath p;
@@ -194,6 +406,87 @@ void tst_QGeoPath::size()
     QCOMPARE(p4.size(), coords.size() - 2);
 }
 
+static double referenceLength(const QList<QGeoCoordinate> &coords, qsizetype from, qsizetype to)
+{
+    double length = 0.0;
+    for (qsizetype i = from; i < to; ++i)
+        length += coords.at(i).distanceTo(coords.at(i + 1));
+    return length;
+}
+
+void tst_QGeoPath::length()
+{
+    QList<QGeoCoordinate> coords;
+    coords.append(QGeoCoordinate(1,1));
+    coords.append(QGeoCoordinate(2,2));
+    coords.append(QGeoCoordinate(3,0));
+    const QGeoPath p(coords);
+
+    const double closing = coords.at(2).distanceTo(coords.at(0));
+    QVERIFY(qAbs(p.length() - referenceLength(coords, 0, 2) - closing) < 1e-6);
+    QVERIFY(qAbs(p.length(0, 2) - referenceLength(coords, 0, 2)) < 1e-6);
+    QVERIFY(qAbs(p.length(1, 2) - referenceLength(coords, 1, 2)) < 1e-6);
+    QVERIFY(qAbs(p.length(1, 10) - referenceLength(coords, 1, 2)) < 1e-6);
+    QVERIFY(qAbs(p.length(1, -1) - referenceLength(coords, 1, 2) - closing) < 1e-6);
+    QCOMPARE(p.length(1, 1), 0.0);
+    QCOMPARE(p.length(2, 1), 0.0);
+}
+
+void tst_QGeoPath::lengthAfterEdits_data()
+{
+    QTest::addColumn<bool>("eager");
+
+    QTest::newRow("lazy") << false;
+    QTest::newRow("eager") << true;
+}
+
+void tst_QGeoPath::lengthAfterEdits()
+{
+    QFETCH(bool, eager);
+
+    QRandomGenerator random(3);
+    QList<QGeoCoordinate> coords = randomWalk(random, 40.0, -3.0, 0.01, 100);
+    QGeoPath path = eager ? QGeoPathEager(coords) : QGeoPath(coords);
+    QVERIFY(path.length() > 0.0); // builds the cumulative lengths
+    QCOMPARE(path.path(), coords); // and the list, both kept up to date from now on
+
+    const auto randomCoordinate = [&random] {
+        return QGeoCoordinate(40.0 + random.generateDouble(), -3.0 + random.generateDouble());
+    };
+    for (int i = 0; i < 400; ++i) {
+        const int edit = random.bounded(4);
+        if (edit == 0 || coords.size() < 2) {
+            const QGeoCoordinate c = randomCoordinate();
+            path.addCoordinate(c);
+            coords.append(c);
+        } else if (edit == 1) {
+            const qsizetype index = random.bounded(coords.size() + 1);
+            const QGeoCoordinate c = randomCoordinate();
+            path.insertCoordinate(index, c);
+            coords.insert(index, c);
+        } else if (edit == 2) {
+            const qsizetype index = random.bounded(coords.size());
+            const QGeoCoordinate c = randomCoordinate();
+            path.replaceCoordinate(index, c);
+            coords.replace(index, c);
+        } else {
+            const qsizetype index = random.bounded(coords.size());
+            path.removeCoordinate(index);
+            coords.remove(index);
+        }
+
+        QCOMPARE(path.size(), coords.size());
+        QCOMPARE(path.path(), coords);
+        const qsizetype from = random.bounded(coords.size());
+        const qsizetype to = random.bounded(coords.size());
+        const double expected = referenceLength(coords, from, to);
+        QVERIFY2(qAbs(path.length(from, to) - expected) <= 1e-9 * expected + 1e-6,
+                 qPrintable(QString::number(path.length(from, to) - expected)));
+        const double total = referenceLength(coords, 0, coords.size() - 1);
+        QVERIFY(qAbs(path.length(0, coords.size() - 1) - total) <= 1e-9 * total + 1e-6);
+    }
+}
+
 void tst_QGeoPath::translate_data()
 {
     QTest::addColumn<QGeoCoordinate>("c1");
@@ -306,6 +599,258 @@ void tst_QGeoPath::contains()
     QCOMPARE(area.contains(probe), result);
 }
 
+void tst_QGeoPath::containsLongPath_data()
+{
+    QTest::addColumn<double>("latitude");
+    QTest::addColumn<double>("longitude");
+    QTest::addColumn<double>("step");
+    QTest::addColumn<int>("vertexCount");
+
+    QTest::newRow("short") << 52.5 << 13.4 << 0.001 << 63;
+    QTest::newRow("city") << 52.5 << 13.4 << 0.001 << 2000;
+    QTest::newRow("continent") << 10.0 << -20.0 << 0.05 << 2000;
+    QTest::newRow("dateline") << -30.0 << 175.0 << 0.01 << 2000;
+    QTest::newRow("arctic") << 84.0 << 0.0 << 0.05 << 2000;
+}
+
+void tst_QGeoPath::containsLongPath()
+{
+    QFETCH(double, latitude);
+    QFETCH(double, longitude);
+    QFETCH(double, step);
+    QFETCH(int, vertexCount);
+
+    QRandomGenerator random(42);
+    const QList<QGeoCoordinate> coords = randomWalk(random, latitude, longitude, step, vertexCount);
+
+    for (qreal width : { 0.0, 20.0, 500.0, 50000.0 }) {
+        const QGeoPath path(coords, width);
+        QList<QGeoCoordinate> probes;
+        for (int i = 0; i < 500; ++i) {
+            const QGeoCoordinate &c = coords.at(random.bounded(vertexCount));
+            const QGeoCoordinate probe = c.atDistanceAndAzimuth(random.bounded(width + 10.0),
+                                                                random.bounded(360.0));
+            probes.append(probe);
+            QCOMPARE(path.contains(probe), referenceContains(path, probe));
+        }
+        probes.append(coords.first());
+        probes.append(coords.last());
+        probes.append(QGeoCoordinate());
+
+        QList<bool> results(probes.size());
+        path.contains(probes, results);
+        for (qsizetype i = 0; i < probes.size(); ++i)
+            QCOMPARE(results.at(i), referenceContains(path, probes.at(i)));
+    }
+}
+
+void tst_QGeoPath::nearestCoordinate()
+{
+    qsizetype segment = 0;
+    double along = 1.0;
+    QGeoPath path;
+    QVERIFY(!path.nearestCoordinate(QGeoCoordinate(1, 1), &segment, &along).isValid());
+    QCOMPARE(segment, -1);
+    QCOMPARE(along, 0.0);
+
+    path.addCoordinate(QGeoCoordinate(1, 1, 100));
+    QCOMPARE(path.nearestCoordinate(QGeoCoordinate(2, 2), &segment, &along), QGeoCoordinate(1, 1));
+    QCOMPARE(segment, 0);
+    QCOMPARE(along, 0.0);
+
+    path.addCoordinate(QGeoCoordinate(1, 3));
+    path.addCoordinate(QGeoCoordinate(3, 3));
+    QVERIFY(!path.nearestCoordinate(QGeoCoordinate(), &segment, &along).isValid());
+    QCOMPARE(segment, -1);
+
+    // off the middle of the first segment, along the equator-parallel rhumb line
+    QGeoCoordinate nearest = path.nearestCoordinate(QGeoCoordinate(0.5, 2), &segment, &along);
+    QCOMPARE(segment, 0);
+    QVERIFY(qAbs(nearest.latitude() - 1.0) < 1e-9);
+    QVERIFY(qAbs(nearest.longitude() - 2.0) < 1e-9);
+    QVERIFY(qIsNaN(nearest.altitude()));
+    QVERIFY(qAbs(along - QGeoCoordinate(1, 1).distanceTo(nearest)) < 1e-3);
+
+    // on the corner, shared by both segments: the first one wins
+    nearest = path.nearestCoordinate(QGeoCoordinate(0, 4), &segment, &along);
+    QCOMPARE(nearest, QGeoCoordinate(1, 3));
+    QCOMPARE(segment, 0);
+    QVERIFY(qAbs(along - path.length(0, 1)) < 1e-3);
+
+    // past the end
+    nearest = path.nearestCoordinate(QGeoCoordinate(5, 3), &segment, &along);
+    QCOMPARE(nearest, QGeoCoordinate(3, 3));
+    QCOMPARE(segment, 1);
+    QVERIFY(qAbs(along - path.length(0, 2)) < 1e-3);
+
+    // the output arguments are optional
+    QCOMPARE(path.nearestCoordinate(QGeoCoordinate(5, 3)), QGeoCoordinate(3, 3));
+}
+
+void tst_QGeoPath::nearestCoordinateLongPath_data()
+{
+    containsLongPath_data();
+}
+
+void tst_QGeoPath::nearestCoordinateLongPath()
+{
+    QFETCH(double, latitude);
+    QFETCH(double, longitude);
+    QFETCH(double, step);
+    QFETCH(int, vertexCount);
+
+    QRandomGenerator random(7);
+    const QList<QGeoCoordinate> coords = randomWalk(random, latitude, longitude, step, vertexCount);
+    const QGeoPath path(coords);
+
+    for (int i = 0; i < 500; ++i) {
+        const QGeoCoordinate &c = coords.at(random.bounded(vertexCount));
+        const QGeoCoordinate probe = c.atDistanceAndAzimuth(random.bounded(step * 200000.0),
+                                                            random.bounded(360.0));
+        qsizetype expectedSegment = -1;
+        const QGeoCoordinate expected = referenceNearest(path, probe, &expectedSegment);
+
+        qsizetype segment = -1;
+        double along = -1.0;
+        const QGeoCoordinate nearest = path.nearestCoordinate(probe, &segment, &along);
+        QCOMPARE(segment, expectedSegment);
+        QCOMPARE(nearest, QGeoCoordinate(expected.latitude(), expected.longitude()));
+
+        const double expectedAlong = path.length(0, segment)
+                + coords.at(segment).distanceTo(expected);
+        QVERIFY2(qAbs(along - expectedAlong) <= 1e-6 * expectedAlong + 1e-3,
+                 qPrintable(QString::number(along - expectedAlong)));
+    }
+}
+
+// Whether all of coords are within tolerance of path, give or take the projection
+static bool withinTolerance(const QList<QGeoCoordinate> &coords, const QGeoPath &path,
+                            double tolerance)
+{
+    const QGeoPath corridor(path.pathBuffer(), 2 * tolerance * 1.01);
+    for (const QGeoCoordinate &c : coords) {
+        if (!corridor.contains(c))
+            return false;
+    }
+    return true;
+}
+
+void tst_QGeoPath::simplified()
+{
+    // two straight legs with about a meter of noise, east and then north
+    QList<QGeoCoordinate> coords;
+    for (int i = 0; i <= 50; ++i)
+        coords.append(QGeoCoordinate(10.0 + (i % 2 ? 0.00001 : 0.0), 20.0 + i * 0.001, i));
+    for (int i = 51; i <= 100; ++i)
+        coords.append(QGeoCoordinate(10.0 + (i - 50) * 0.001, 20.05 + (i % 2 ? 0.00001 : 0.0), i));
+    const QGeoPath path(coords, 7.0);
+
+    const QGeoPath simplified = path.simplified(5.0);
+    QCOMPARE(simplified.width(), 7.0);
+    QCOMPARE(simplified.size(), 3);
+    QCOMPARE(simplified.coordinateAt(0), coords.first());
+    QCOMPARE(simplified.coordinateAt(1), coords.at(50));
+    QCOMPARE(simplified.coordinateAt(2), coords.last());
+    QCOMPARE(simplified.coordinateAt(1).altitude(), 50.0);
+    QVERIFY(withinTolerance(coords, simplified, 5.0));
+
+    QCOMPARE(path.simplified(5000.0).size(), 2);
+    QCOMPARE(path.simplified(0.5).size(), 101);
+    QCOMPARE(path.simplified(0.0), path);
+    QCOMPARE(path.simplified(-1.0), path);
+    QCOMPARE(QGeoPath().simplified(5.0), QGeoPath());
+
+    QGeoPath shortPath;
+    shortPath.addCoordinate(QGeoCoordinate(1, 1));
+    shortPath.addCoordinate(QGeoCoordinate(1, 1));
+    QCOMPARE(shortPath.simplified(5.0), shortPath);
+}
+
+void tst_QGeoPath::simplifiedLongPath_data()
+{
+    QTest::addColumn<double>("latitude");
+    QTest::addColumn<double>("longitude");
+    QTest::addColumn<double>("tolerance");
+
+    QTest::newRow("city") << 52.5 << 13.4 << 5.0;
+    QTest::newRow("dateline") << -30.0 << 179.8 << 20.0;
+    QTest::newRow("arctic") << 80.0 << 0.0 << 10.0;
+}
+
+void tst_QGeoPath::simplifiedLongPath()
+{
+    QFETCH(double, latitude);
+    QFETCH(double, longitude);
+    QFETCH(double, tolerance);
+
+    QRandomGenerator random(11);
+    const QList<QGeoCoordinate> coords = randomWalk(random, latitude, longitude, 0.0005, 3000);
+    const QGeoPath path(coords);
+
+    const QGeoPath simplified = path.simplified(tolerance);
+    QVERIFY(simplified.size() < coords.size());
+    QCOMPARE(simplified.coordinateAt(0), coords.first());
+    QCOMPARE(simplified.coordinateAt(simplified.size() - 1), coords.last());
+    QVERIFY(withinTolerance(coords, simplified, tolerance));
+
+    QGeoPath recorded;
+    for (const QGeoCoordinate &c : coords)
+        recorded.addCoordinateSimplified(c, tolerance);
+    QVERIFY(recorded.size() < coords.size());
+    QCOMPARE(recorded.coordinateAt(0), coords.first());
+    QCOMPARE(recorded.coordinateAt(recorded.size() - 1), coords.last());
+    QVERIFY(withinTolerance(coords, recorded, tolerance));
+}
+
+void tst_QGeoPath::simplifiedZigzag()
+{
+    // a zig-zag growing wider, wider than the tolerance after about 230 vertices
+    QList<QGeoCoordinate> coords;
+    for (int i = 0; i < 2000; ++i)
+        coords.append(QGeoCoordinate(48.0 + (i % 2 ? 1e-7 : -1e-7) * i, 11.0 + 0.0001 * i));
+    const QGeoPath path(coords);
+
+    const QGeoPath simplified = path.simplified(5.0);
+    QVERIFY(simplified.size() < coords.size());
+    QVERIFY(withinTolerance(coords, simplified, 5.0));
+    for (qsizetype i = 1; i <= 100; ++i)
+        QCOMPARE(simplified.coordinateAt(simplified.size() - i), coords.at(coords.size() - i));
+}
+
+void tst_QGeoPath::addCoordinateSimplified()
+{
+    // along a parallel, the last coordinate keeps being replaced
+    QGeoPath path;
+    for (int i = 0; i < 10; ++i)
+        path.addCoordinateSimplified(QGeoCoordinate(10.0, 20.0 + i * 0.001), 5.0);
+    QCOMPARE(path.size(), 2);
+    QCOMPARE(path.coordinateAt(1), QGeoCoordinate(10.0, 20.009));
+
+    // a turn starts a new segment
+    path.addCoordinateSimplified(QGeoCoordinate(10.001, 20.009), 5.0);
+    QCOMPARE(path.size(), 3);
+    path.addCoordinateSimplified(QGeoCoordinate(10.002, 20.009), 5.0);
+    QCOMPARE(path.size(), 3);
+
+    // as does going back
+    path.addCoordinateSimplified(QGeoCoordinate(10.0015, 20.009), 5.0);
+    QCOMPARE(path.size(), 4);
+
+    // other edits and other tolerances end the run
+    path.replaceCoordinate(0, QGeoCoordinate(9.0, 20.0));
+    path.addCoordinateSimplified(QGeoCoordinate(10.001, 20.009), 5.0);
+    QCOMPARE(path.size(), 5);
+    path.addCoordinateSimplified(QGeoCoordinate(10.0005, 20.009), 2.0);
+    QCOMPARE(path.size(), 6);
+
+    // without a tolerance, it is a plain append
+    path.addCoordinateSimplified(QGeoCoordinate(10.0, 20.009), 0.0);
+    path.addCoordinateSimplified(QGeoCoordinate(9.9995, 20.009), 0.0);
+    QCOMPARE(path.size(), 8);
+    path.addCoordinateSimplified(QGeoCoordinate(), 5.0);
+    QCOMPARE(path.size(), 8);
+}
+
 void tst_QGeoPath::boundingGeoRectangle_data()
 {
     QTest::addColumn<QGeoCoordinate>("c1");
@@ -345,6 +890,82 @@ void tst_QGeoPath::boundingGeoRectangle()
     QCOMPARE(box.contains(probe), result);
 }
 
+void tst_QGeoPath::boundingGeoRectangleWhileAppending_data()
+{
+    lengthAfterEdits_data();
+}
+
+void tst_QGeoPath::boundingGeoRectangleWhileAppending()
+{
+    QFETCH(bool, eager);
+
+    QVERIFY(!QGeoPath().centroid().isValid());
+    QVERIFY(!QGeoPath({ QGeoCoordinate(10, 20), QGeoCoordinate(-10, -160) }).centroid().isValid());
+
+    // across the dateline and back
+    QRandomGenerator random(5);
+    QList<QGeoCoordinate> coords = randomWalk(random, 10.0, 179.99, 0.001, 300);
+    QGeoPath path = eager ? QGeoPathEager(coords) : QGeoPath(coords);
+    QCOMPARE(path.boundingGeoRectangle(), QGeoPath(coords).boundingGeoRectangle());
+
+    for (int i = 0; i < 300; ++i) {
+        const QGeoCoordinate &last = coords.last();
+        const QGeoCoordinate c(last.latitude() + 0.001 * (random.generateDouble() - 0.5),
+                               QLocationUtils::wrapLong(last.longitude()
+                                                        + 0.001 * (random.generateDouble() - 0.8)));
+        path.addCoordinate(c);
+        coords.append(c);
+        if (i == 150) {
+            path.translate(1.0, -0.02);
+            coords = path.path();
+        }
+        const QGeoPath reference(coords);
+        QCOMPARE(path.boundingGeoRectangle(), reference.boundingGeoRectangle());
+        QCOMPARE(path.center(), reference.center());
+        QVERIFY2(fuzzyCompareCoordinates(path.centroid(), referenceCentroid(coords)),
+                 qPrintable(path.centroid().toString()));
+    }
+    QVERIFY(path.boundingGeoRectangle().topLeft().longitude() > 0.0);
+    QVERIFY(path.boundingGeoRectangle().bottomRight().longitude() < 0.0);
+}
+
+void tst_QGeoPath::boundingGeoRectangleWhileSimplifying_data()
+{
+    lengthAfterEdits_data();
+}
+
+void tst_QGeoPath::boundingGeoRectangleWhileSimplifying()
+{
+    QFETCH(bool, eager);
+
+    // eastwards across the dateline, with turns, so that the last coordinate
+    // keeps being replaced in the runs between them
+    QRandomGenerator random(7);
+    QGeoPath path = eager ? QGeoPathEager() : QGeoPath();
+    QGeoCoordinate c(10.0, 179.9);
+    double heading = 0.0;
+    int added = 0;
+    for (int i = 0; i < 600; ++i) {
+        if (random.bounded(25) == 0)
+            heading = 0.002 * (random.generateDouble() - 0.5);
+        c = QGeoCoordinate(c.latitude() + heading + 0.00002 * (random.generateDouble() - 0.5),
+                           QLocationUtils::wrapLong(c.longitude() + 0.001));
+        path.addCoordinateSimplified(c, 10.0);
+        ++added;
+        // the lazy box is not always built when a run starts
+        if (eager || i % 7 == 0) {
+            const QGeoPath reference(path.path());
+            QCOMPARE(path.boundingGeoRectangle(), reference.boundingGeoRectangle());
+            QCOMPARE(path.center(), reference.center());
+            QVERIFY(fuzzyCompareCoordinates(path.centroid(), referenceCentroid(path.path())));
+        }
+    }
+    QVERIFY(path.size() < added / 2);
+    QCOMPARE(path.boundingGeoRectangle(), QGeoPath(path.path()).boundingGeoRectangle());
+    QVERIFY(path.boundingGeoRectangle().topLeft().longitude() > 0.0);
+    QVERIFY(path.boundingGeoRectangle().bottomRight().longitude() < 0.0);
+}
+
 void tst_QGeoPath::hashing()
 {
     const QGeoPath path({ QGeoCoordinate(1, 1), QGeoCoordinate(1, 2), QGeoCoordinate(2, 5) }, 1.0);
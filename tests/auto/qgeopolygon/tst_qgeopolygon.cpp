@@ -5,6 +5,8 @@
 #include <QtPositioning/QGeoCoordinate>
 #include <QtPositioning/QGeoRectangle>
 #include <QtPositioning/QGeoPolygon>
+#include <QtPositioning/qgeocoordinatebuffer.h>
+#include <QtPositioning/private/qclipperutils_p.h>
 
 QT_USE_NAMESPACE
 
@@ -15,6 +17,7 @@ class tst_QGeoPolygon : public QObject
 private slots:
     void defaultConstructor();
     void listConstructor();
+    void bufferConstructor();
     void assignment();
 
     void comparison();
@@ -33,6 +36,8 @@ private slots:
     void contains();
 
     void containsAfterCopy();
+    void containsWithHoles();
+    void containsLargePerimeter();
 
     void boundingGeoRectangle_data();
     void boundingGeoRectangle();
@@ -75,6 +80,43 @@ void tst_QGeoPolygon::listConstructor()
     }
 }
 
+void tst_QGeoPolygon::bufferConstructor()
+{
+    const QList<QGeoCoordinate> coords = { QGeoCoordinate(0, 0), QGeoCoordinate(0, 10),
+                                           QGeoCoordinate(10, 10), QGeoCoordinate(10, 0) };
+    const QGeoCoordinateBuffer buffer(coords);
+
+    QGeoPolygon p(buffer);
+    QCOMPARE(p.size(), 4);
+    QVERIFY(p.isValid());
+    QCOMPARE(p.perimeter(), coords);
+    QCOMPARE(p.perimeterBuffer(), buffer);
+    QCOMPARE(p, QGeoPolygon(coords));
+    QCOMPARE(qHash(p), qHash(QGeoPolygon(coords)));
+    QVERIFY(p.contains(QGeoCoordinate(5, 5)));
+
+    p.addHole({ QGeoCoordinate(1, 1), QGeoCoordinate(1, 3),
+                QGeoCoordinate(3, 3), QGeoCoordinate(3, 1) });
+    QVERIFY(!p.contains(QGeoCoordinate(2, 2)));
+
+    // the perimeter list is built on demand and follows the translation
+    p.translate(1, 2);
+    QList<QGeoCoordinate> translated;
+    for (const QGeoCoordinate &c : coords)
+        translated.append(QGeoCoordinate(c.latitude() + 1, c.longitude() + 2));
+    QCOMPARE(p.perimeter(), translated);
+    QCOMPARE(p.holePath(0).first(), QGeoCoordinate(2, 3));
+    QVERIFY(!p.contains(QGeoCoordinate(3, 4)));
+    QCOMPARE(buffer.toList(), coords);
+
+    QGeoPolygon p2;
+    p2.setPerimeter(buffer);
+    QCOMPARE(p2.perimeter(), coords);
+    p2.addCoordinate(QGeoCoordinate(5, -5));
+    QCOMPARE(p2.perimeter().size(), 5);
+    QCOMPARE(p2.perimeter().last(), QGeoCoordinate(5, -5));
+}
+
 void tst_QGeoPolygon::assignment()
 {
     QGeoPolygon p1;
@@ -322,6 +364,79 @@ void tst_QGeoPolygon::containsAfterCopy()
     QVERIFY(!p2.contains(testPoint));
 }
 
+void tst_QGeoPolygon::containsWithHoles()
+{
+    // The projected holes are cached, so they must follow every change
+    QGeoPolygon p({ QGeoCoordinate(0, 0), QGeoCoordinate(0, 10),
+                    QGeoCoordinate(10, 10), QGeoCoordinate(10, 0) });
+    const QGeoCoordinate inHole(2, 2);
+    const QGeoCoordinate outsideHoles(8, 8);
+    QVERIFY(p.contains(inHole));
+
+    p.addHole({ QGeoCoordinate(1, 1), QGeoCoordinate(1, 3),
+                QGeoCoordinate(3, 3), QGeoCoordinate(3, 1) });
+    QVERIFY(!p.contains(inHole));
+    QVERIFY(p.contains(outsideHoles));
+
+    p.addHole({ QGeoCoordinate(7, 7), QGeoCoordinate(7, 9),
+                QGeoCoordinate(9, 9), QGeoCoordinate(9, 7) });
+    QVERIFY(!p.contains(inHole));
+    QVERIFY(!p.contains(outsideHoles));
+
+    QGeoPolygon copy = p;
+    p.removeHole(0);
+    QVERIFY(p.contains(inHole));
+    QVERIFY(!p.contains(outsideHoles));
+    QVERIFY(!copy.contains(inHole));
+    QVERIFY(!copy.contains(outsideHoles));
+
+    copy.translate(0, 5);
+    QVERIFY(!copy.contains(inHole));
+    QVERIFY(!copy.contains(QGeoCoordinate(2, 7)));
+    QVERIFY(!copy.contains(QGeoCoordinate(8, 13)));
+    QVERIFY(copy.contains(QGeoCoordinate(2, 11)));
+
+    // a hole crossing the dateline
+    QGeoPolygon dateline({ QGeoCoordinate(-10, 170), QGeoCoordinate(-10, -170),
+                           QGeoCoordinate(10, -170), QGeoCoordinate(10, 170) });
+    QVERIFY(dateline.contains(QGeoCoordinate(0, 179.5)));
+    dateline.addHole({ QGeoCoordinate(-5, 175), QGeoCoordinate(-5, -175),
+                       QGeoCoordinate(5, -175), QGeoCoordinate(5, 175) });
+    QVERIFY(!dateline.contains(QGeoCoordinate(0, 179.5)));
+    QVERIFY(!dateline.contains(QGeoCoordinate(0, -179.5)));
+    QVERIFY(dateline.contains(QGeoCoordinate(0, 172)));
+    QVERIFY(dateline.contains(QGeoCoordinate(0, -172)));
+}
+
+void tst_QGeoPolygon::containsLargePerimeter()
+{
+    // Large polygons are tested with an index of their edges, which has to
+    // give the same results as testing every edge, also on the boundary.
+    QRandomGenerator random(42);
+    for (int vertexCount : { 63, 64, 100, 1000, 5000 }) {
+        QList<QDoubleVector2D> star;
+        for (int i = 0; i < vertexCount; ++i) {
+            const double angle = 2 * M_PI * i / vertexCount;
+            const double radius = (i % 2 ? 0.1 : 0.2) + random.bounded(0.05);
+            star.append(QDoubleVector2D(0.5 + radius * std::cos(angle),
+                                        0.5 + radius * std::sin(angle)));
+        }
+        QClipperUtils clipper;
+        clipper.setPolygon(star);
+
+        QList<QDoubleVector2D> probes;
+        for (int i = 0; i < 2000; ++i)
+            probes.append(QDoubleVector2D(random.bounded(1.0), random.bounded(1.0)));
+        for (const QDoubleVector2D &vertex : std::as_const(star)) {
+            probes.append(vertex);
+            probes.append(QDoubleVector2D(random.bounded(1.0), vertex.y()));
+        }
+
+        for (const QDoubleVector2D &probe : std::as_const(probes))
+            QCOMPARE(clipper.pointInPolygon(probe), QClipperUtils::pointInPolygon(probe, star));
+    }
+}
+
 void tst_QGeoPolygon::boundingGeoRectangle_data()
 {
     QTest::addColumn<QGeoCoordinate>("c1");
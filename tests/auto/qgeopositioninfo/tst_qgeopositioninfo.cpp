@@ -5,6 +5,8 @@
 
 #include <QtPositioning/qgeopositioninfo.h>
 
+#include <QDataStream>
+#include <QHash>
 #include <QMetaType>
 #include <QObject>
 #include <QDebug>
@@ -348,6 +350,55 @@ private slots:
         addTestData_info();
     }
 
+    void datastreamCompatibility()
+    {
+        // The attributes used to be streamed as a QHash<Attribute, qreal>
+        const QDateTime dt = QDateTime::currentDateTimeUtc();
+        const QGeoCoordinate coord(-27.3422, 150.2342, 42);
+        QHash<QGeoPositionInfo::Attribute, qreal> attributes;
+        attributes.insert(QGeoPositionInfo::Direction, 1.5);
+        attributes.insert(QGeoPositionInfo::VerticalAccuracy, 2.5);
+        attributes.insert(QGeoPositionInfo::DirectionAccuracy, 3.5);
+
+        QByteArray ba;
+        {
+            QDataStream out(&ba, QIODevice::WriteOnly);
+            out << dt << coord << attributes;
+        }
+        QGeoPositionInfo info;
+        {
+            QDataStream in(&ba, QIODevice::ReadOnly);
+            in >> info;
+            QCOMPARE(in.status(), QDataStream::Ok);
+        }
+        QCOMPARE(info.timestamp(), dt);
+        QCOMPARE(info.coordinate(), coord);
+        for (int i = QGeoPositionInfo::Direction; i <= QGeoPositionInfo::DirectionAccuracy; ++i) {
+            const auto attribute = static_cast<QGeoPositionInfo::Attribute>(i);
+            QCOMPARE(info.hasAttribute(attribute), attributes.contains(attribute));
+            if (attributes.contains(attribute))
+                QCOMPARE(info.attribute(attribute), attributes.value(attribute));
+        }
+
+        ba.clear();
+        {
+            QDataStream out(&ba, QIODevice::WriteOnly);
+            out << info;
+        }
+        QDateTime inDt;
+        QGeoCoordinate inCoord;
+        QHash<QGeoPositionInfo::Attribute, qreal> inAttributes;
+        {
+            QDataStream in(&ba, QIODevice::ReadOnly);
+            in >> inDt >> inCoord >> inAttributes;
+            QCOMPARE(in.status(), QDataStream::Ok);
+            QVERIFY(in.atEnd());
+        }
+        QCOMPARE(inDt, dt);
+        QCOMPARE(inCoord, coord);
+        QCOMPARE(inAttributes, attributes);
+    }
+
     void debug()
     {
         QFETCH(QGeoPositionInfo, info);
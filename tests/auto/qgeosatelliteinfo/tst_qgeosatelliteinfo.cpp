@@ -5,6 +5,8 @@
 
 #include <QtPositioning/qgeosatelliteinfo.h>
 
+#include <QDataStream>
+#include <QHash>
 #include <QMetaType>
 #include <QObject>
 #include <QDebug>
@@ -353,6 +355,49 @@ private slots:
         addTestData_update();
     }
 
+    void datastreamCompatibility()
+    {
+        // The attributes used to be streamed as a QHash<int, qreal>
+        QHash<int, qreal> attributes;
+        attributes.insert(QGeoSatelliteInfo::Elevation, 12.5);
+        attributes.insert(QGeoSatelliteInfo::Azimuth, 270.0);
+
+        QByteArray ba;
+        {
+            QDataStream out(&ba, QIODevice::WriteOnly);
+            out << 35 << attributes << 7 << int(QGeoSatelliteInfo::GALILEO);
+        }
+        QGeoSatelliteInfo info;
+        {
+            QDataStream in(&ba, QIODevice::ReadOnly);
+            in >> info;
+            QCOMPARE(in.status(), QDataStream::Ok);
+        }
+        QCOMPARE(info.signalStrength(), 35);
+        QCOMPARE(info.satelliteIdentifier(), 7);
+        QCOMPARE(info.satelliteSystem(), QGeoSatelliteInfo::GALILEO);
+        QCOMPARE(info.attribute(QGeoSatelliteInfo::Elevation), 12.5);
+        QCOMPARE(info.attribute(QGeoSatelliteInfo::Azimuth), 270.0);
+
+        ba.clear();
+        {
+            QDataStream out(&ba, QIODevice::WriteOnly);
+            out << info;
+        }
+        int signal, satId, system;
+        QHash<int, qreal> inAttributes;
+        {
+            QDataStream in(&ba, QIODevice::ReadOnly);
+            in >> signal >> inAttributes >> satId >> system;
+            QCOMPARE(in.status(), QDataStream::Ok);
+            QVERIFY(in.atEnd());
+        }
+        QCOMPARE(signal, 35);
+        QCOMPARE(inAttributes, attributes);
+        QCOMPARE(satId, 7);
+        QCOMPARE(system, int(QGeoSatelliteInfo::GALILEO));
+    }
+
     void debug()
     {
         QFETCH(QGeoSatelliteInfo, info);
@@ -34,6 +34,8 @@ private slots:
     void conversions();
     void serialization();
     void hashing();
+    void containsBatch_data();
+    void containsBatch();
 };
 
 void tst_qgeoshape::testArea()
@@ -214,5 +216,68 @@ void tst_qgeoshape::hashing()
     QCOMPARE(qHash(path), pathShapeHash);
 }
 
+void tst_qgeoshape::containsBatch_data()
+{
+    QTest::addColumn<QGeoShape>("shape");
+
+    QTest::newRow("default") << QGeoShape();
+    QTest::newRow("rectangle")
+            << QGeoShape(QGeoRectangle(QGeoCoordinate(30, -20), QGeoCoordinate(-10, 40)));
+    QTest::newRow("rectangle across dateline")
+            << QGeoShape(QGeoRectangle(QGeoCoordinate(60, 150), QGeoCoordinate(-60, -170)));
+    QTest::newRow("rectangle to the pole")
+            << QGeoShape(QGeoRectangle(QGeoCoordinate(90, -180), QGeoCoordinate(45, 180)));
+    QTest::newRow("invalid rectangle") << QGeoShape(QGeoRectangle());
+    QTest::newRow("circle") << QGeoShape(QGeoCircle(QGeoCoordinate(10, 20), 2000000));
+    QTest::newRow("circle around pole")
+            << QGeoShape(QGeoCircle(QGeoCoordinate(80, 0), 3000000));
+    QTest::newRow("zero radius circle") << QGeoShape(QGeoCircle(QGeoCoordinate(15, 15), 0));
+    QTest::newRow("path")
+            << QGeoShape(QGeoPath({ QGeoCoordinate(0, 0), QGeoCoordinate(15, 15),
+                                    QGeoCoordinate(15, 45), QGeoCoordinate(-30, 60) }, 800000));
+    QTest::newRow("path across dateline")
+            << QGeoShape(QGeoPath({ QGeoCoordinate(-15, 165), QGeoCoordinate(15, -165) },
+                                  500000));
+    QTest::newRow("single point path")
+            << QGeoShape(QGeoPath({ QGeoCoordinate(30, 30) }, 1000000));
+
+    QGeoPolygon polygon({ QGeoCoordinate(45, -45), QGeoCoordinate(45, 45),
+                          QGeoCoordinate(-45, 45), QGeoCoordinate(-45, -45) });
+    QTest::newRow("polygon") << QGeoShape(polygon);
+    polygon.addHole({ QGeoCoordinate(15, -15), QGeoCoordinate(15, 15),
+                      QGeoCoordinate(-15, 15), QGeoCoordinate(-15, -15) });
+    QTest::newRow("polygon with hole") << QGeoShape(polygon);
+}
+
+void tst_qgeoshape::containsBatch()
+{
+    QFETCH(QGeoShape, shape);
+
+    QList<QGeoCoordinate> coordinates;
+    for (double latitude = -90; latitude <= 90; latitude += 7.5) {
+        for (double longitude = -180; longitude <= 180; longitude += 7.5)
+            coordinates.append(QGeoCoordinate(latitude, longitude));
+    }
+    coordinates.append(QGeoCoordinate());
+    coordinates.append(QGeoCoordinate(15, 15));
+    coordinates.append(QGeoCoordinate(30, 30));
+    coordinates.append(QGeoCoordinate(91, 0));
+
+    QList<bool> results(coordinates.size() + 1, true);
+    shape.contains(coordinates, QSpan(results).first(coordinates.size()));
+
+    qsizetype containedCount = 0;
+    for (qsizetype i = 0; i < coordinates.size(); ++i) {
+        QCOMPARE(results.at(i), shape.contains(coordinates.at(i)));
+        containedCount += results.at(i);
+    }
+    QCOMPARE(results.last(), true); // not written to
+    if (shape.isValid() && !shape.isEmpty())
+        QVERIFY(containedCount > 0);
+
+    // no coordinates, nothing to do
+    shape.contains({}, QSpan(results).first(0));
+}
+
 QTEST_MAIN(tst_qgeoshape)
 #include "tst_qgeoshape.moc"
@@ -0,0 +1,263 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include "qiopipe_p.h"
+
+#include <QTest>
+
+// A sequential device standing in for a serial port
+class FeedDevice : public QIODevice
+{
+    Q_OBJECT
+public:
+    FeedDevice() { open(ReadOnly); }
+
+    bool isSequential() const override { return true; }
+    qint64 bytesAvailable() const override
+    {
+        return m_data.size() + QIODevice::bytesAvailable();
+    }
+
+    void feed(const QByteArray &data)
+    {
+        m_data += data;
+        emit readyRead();
+    }
+
+protected:
+    qint64 readData(char *data, qint64 maxlen) override
+    {
+        const qint64 size = qMin(maxlen, qint64(m_data.size()));
+        memcpy(data, m_data.constData(), size);
+        m_data.remove(0, size);
+        return size;
+    }
+    qint64 writeData(const char *, qint64) override { return -1; }
+
+private:
+    QByteArray m_data;
+};
+
+class tst_QIOPipe : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void wrapAround();
+    void growth();
+    void overrun();
+    void overrunBySingleAppend();
+    void lateReader();
+    void readerSlotReuse();
+    void indexOfAcrossWrap();
+    void canReadLineAcrossWrap();
+    void fanOut();
+};
+
+// The byte at position of a test stream, so that every part can be checked
+static char streamByte(qint64 position)
+{
+    return char('a' + position % 23);
+}
+
+static QByteArray streamData(qint64 position, qint64 size)
+{
+    QByteArray data(size, Qt::Uninitialized);
+    for (qint64 i = 0; i < size; ++i)
+        data[i] = streamByte(position + i);
+    return data;
+}
+
+static QByteArray readAll(QIOPipeBuffer &buffer, qsizetype reader)
+{
+    QByteArray data(buffer.bytesAvailable(reader), Qt::Uninitialized);
+    data.resize(qMax(buffer.read(reader, data.data(), data.size()), qint64(0)));
+    return data;
+}
+
+void tst_QIOPipe::wrapAround()
+{
+    // appending more than is read makes the data wrap around the end of
+    // the ring several times
+    QIOPipeBuffer buffer;
+    const qsizetype reader = buffer.addReader();
+    qint64 written = 0;
+    qint64 read = 0;
+    for (int i = 0; i < 50; ++i) {
+        buffer.append(streamData(written, 700));
+        written += 700;
+
+        QByteArray data(650, Qt::Uninitialized);
+        QCOMPARE(buffer.read(reader, data.data(), data.size()), data.size());
+        QCOMPARE(data, streamData(read, data.size()));
+        read += data.size();
+        QCOMPARE(buffer.bytesAvailable(reader), written - read);
+    }
+    QCOMPARE(readAll(buffer, reader), streamData(read, written - read));
+    QCOMPARE(buffer.bytesAvailable(reader), 0);
+}
+
+void tst_QIOPipe::growth()
+{
+    // the ring grows while its data wraps around its end
+    QIOPipeBuffer buffer;
+    const qsizetype reader = buffer.addReader();
+    buffer.append(streamData(0, 3000));
+    QByteArray data(2500, Qt::Uninitialized);
+    QCOMPARE(buffer.read(reader, data.data(), data.size()), 2500);
+    buffer.append(streamData(3000, 3000)); // wraps in a ring of 4096 bytes
+    buffer.append(streamData(6000, 10000)); // grows to 16384 bytes
+
+    QCOMPARE(buffer.bytesAvailable(reader), 13500);
+    QCOMPARE(readAll(buffer, reader), streamData(2500, 13500));
+
+    // and keeps working after growing
+    buffer.append(streamData(16000, 20000));
+    QCOMPARE(readAll(buffer, reader), streamData(16000, 20000));
+}
+
+void tst_QIOPipe::overrun()
+{
+    // a reader that falls behind by more than MaximumSize loses the oldest
+    // data, while a reader that keeps up gets everything
+    QIOPipeBuffer buffer;
+    const qsizetype fast = buffer.addReader();
+    const qsizetype slow = buffer.addReader();
+
+    constexpr qint64 ChunkSize = 64 * 1024;
+    const qint64 total = QIOPipeBuffer::MaximumSize + 8 * ChunkSize;
+    for (qint64 written = 0; written < total; written += ChunkSize) {
+        buffer.append(streamData(written, ChunkSize));
+        QCOMPARE(readAll(buffer, fast), streamData(written, ChunkSize));
+    }
+
+    QCOMPARE(buffer.bytesAvailable(slow), QIOPipeBuffer::MaximumSize);
+    QCOMPARE(readAll(buffer, slow),
+             streamData(total - QIOPipeBuffer::MaximumSize, QIOPipeBuffer::MaximumSize));
+
+    // once caught up, nothing more is lost
+    buffer.append(streamData(total, 100));
+    QCOMPARE(readAll(buffer, slow), streamData(total, 100));
+    QCOMPARE(readAll(buffer, fast), streamData(total, 100));
+}
+
+void tst_QIOPipe::overrunBySingleAppend()
+{
+    QIOPipeBuffer buffer;
+    const qsizetype reader = buffer.addReader();
+    buffer.append(streamData(0, 10));
+
+    const qint64 size = QIOPipeBuffer::MaximumSize + 1000;
+    buffer.append(streamData(10, size));
+    QCOMPARE(buffer.bytesAvailable(reader), QIOPipeBuffer::MaximumSize);
+    QCOMPARE(readAll(buffer, reader),
+             streamData(10 + size - QIOPipeBuffer::MaximumSize, QIOPipeBuffer::MaximumSize));
+}
+
+void tst_QIOPipe::lateReader()
+{
+    // a reader only gets the data appended after it joined
+    QIOPipeBuffer buffer;
+    const qsizetype early = buffer.addReader();
+    buffer.append(streamData(0, 100));
+
+    const qsizetype late = buffer.addReader();
+    QCOMPARE(buffer.bytesAvailable(late), 0);
+    buffer.append(streamData(100, 50));
+
+    QCOMPARE(readAll(buffer, late), streamData(100, 50));
+    QCOMPARE(readAll(buffer, early), streamData(0, 150));
+}
+
+void tst_QIOPipe::readerSlotReuse()
+{
+    QIOPipeBuffer buffer;
+    const qsizetype first = buffer.addReader();
+    const qsizetype second = buffer.addReader();
+    buffer.append(streamData(0, 100));
+
+    // the slot of a removed reader is reused, without its unread data
+    buffer.removeReader(first);
+    const qsizetype third = buffer.addReader();
+    QCOMPARE(third, first);
+    QCOMPARE(buffer.bytesAvailable(third), 0);
+    buffer.append(streamData(100, 10));
+    QCOMPARE(readAll(buffer, third), streamData(100, 10));
+    QCOMPARE(readAll(buffer, second), streamData(0, 110));
+
+    // without readers nothing is kept
+    buffer.removeReader(second);
+    buffer.removeReader(third);
+    buffer.append(streamData(110, 10));
+    const qsizetype fourth = buffer.addReader();
+    QCOMPARE(buffer.bytesAvailable(fourth), 0);
+    buffer.append(streamData(120, 10));
+    QCOMPARE(readAll(buffer, fourth), streamData(120, 10));
+}
+
+void tst_QIOPipe::indexOfAcrossWrap()
+{
+    QIOPipeBuffer buffer;
+    const qsizetype reader = buffer.addReader();
+    buffer.append(QByteArray(4090, 'x'));
+    QCOMPARE(readAll(buffer, reader).size(), 4090);
+    QCOMPARE(buffer.indexOf(reader, '\n'), -1);
+
+    // the line break is behind the end of the ring of 4096 bytes
+    buffer.append("abcdefghij\n");
+    QCOMPARE(buffer.indexOf(reader, 'a'), 0);
+    QCOMPARE(buffer.indexOf(reader, 'f'), 5);
+    QCOMPARE(buffer.indexOf(reader, 'g'), 6);
+    QCOMPARE(buffer.indexOf(reader, '\n'), 10);
+    QCOMPARE(buffer.indexOf(reader, 'x'), -1);
+    QCOMPARE(readAll(buffer, reader), QByteArray("abcdefghij\n"));
+}
+
+void tst_QIOPipe::canReadLineAcrossWrap()
+{
+    FeedDevice device;
+    QIOPipe pipe(&device);
+    device.feed(QByteArray(4090, 'x'));
+    QVERIFY(!pipe.canReadLine());
+    QCOMPARE(pipe.read(4090).size(), 4090);
+
+    device.feed("abcdefghij");
+    QVERIFY(!pipe.canReadLine());
+    device.feed("\nnext");
+    QVERIFY(pipe.canReadLine());
+    QCOMPARE(pipe.bytesAvailable(), 15);
+    QCOMPARE(pipe.readLine(), QByteArray("abcdefghij\n"));
+    QVERIFY(!pipe.canReadLine());
+    QCOMPARE(pipe.readAll(), QByteArray("next"));
+}
+
+void tst_QIOPipe::fanOut()
+{
+    // all the child pipes of a proxy read the whole stream
+    FeedDevice device;
+    QIOPipe *proxy = new QIOPipe(&device, QIOPipe::ProxyPipe);
+    QList<QIOPipe *> pipes;
+    QList<QByteArray> received(3);
+    for (qsizetype i = 0; i < received.size(); ++i) {
+        QIOPipe *pipe = new QIOPipe(proxy);
+        proxy->addChildPipe(pipe);
+        pipes.append(pipe);
+        connect(pipe, &QIODevice::readyRead, this,
+                [pipe, &received, i] { received[i] += pipe->readAll(); });
+    }
+
+    device.feed(streamData(0, 5000));
+    device.feed(streamData(5000, 100));
+    for (const QByteArray &data : std::as_const(received))
+        QCOMPARE(data, streamData(0, 5100));
+
+    // a child pipe deleted in between does not keep the others from reading
+    delete pipes.takeLast();
+    device.feed(streamData(5100, 10));
+    QCOMPARE(received.at(0), streamData(0, 5110));
+    QCOMPARE(received.at(1), streamData(0, 5110));
+}
+
+QTEST_GUILESS_MAIN(tst_QIOPipe)
+
+#include "tst_qiopipe.moc"
@@ -0,0 +1,289 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QtPositioning/private/qlocationutils_p.h>
+#include <QtCore/QDate>
+#include <QtCore/QTime>
+#include <qtest.h>
+
+#include <math.h>
+
+QT_USE_NAMESPACE
+
+// The fixed-format NMEA field parsers in QLocationUtils work directly on
+// bytes. The reference implementations below are the generic conversions they
+// replaced; the new parsers must give exactly the same results.
+namespace Reference {
+
+static bool getNmeaTime(QByteArrayView bytes, QTime *time)
+{
+    QTime tempTime = QTime::fromString(QString::fromLatin1(bytes),
+                        QStringView(bytes.size() > 6 && bytes[6] == '.'
+                                                       ? u"hhmmss.z"
+                                                       : u"hhmmss"));
+
+    if (tempTime.isValid()) {
+        *time = tempTime;
+        return true;
+    }
+    return false;
+}
+
+static bool getNmeaDate(QByteArrayView bytes, QDate *date)
+{
+    if (bytes.size() != 6)
+        return false;
+    QDate tempDate = QDate::fromString(QString::fromLatin1(bytes), QStringLiteral("ddMMyy"));
+    if (!tempDate.isValid())
+        return false;
+    *date = tempDate.addYears(100); // otherwise starts from 1900
+    return true;
+}
+
+static double nmeaDegreesToDecimal(double nmeaDegrees)
+{
+    double deg;
+    double min = 100.0 * modf(nmeaDegrees / 100.0, &deg);
+    return deg + (min / 60.0);
+}
+
+static bool getNmeaLatLong(QByteArrayView latString, char latDirection,
+                           QByteArrayView lngString, char lngDirection,
+                           double *lat, double *lng)
+{
+    if ((latDirection != 'N' && latDirection != 'S')
+            || (lngDirection != 'E' && lngDirection != 'W')) {
+        return false;
+    }
+
+    bool hasLat = false;
+    bool hasLong = false;
+    double tempLat = latString.toDouble(&hasLat);
+    double tempLng = lngString.toDouble(&hasLong);
+    if (hasLat && hasLong) {
+        tempLat = nmeaDegreesToDecimal(tempLat);
+        if (latDirection == 'S')
+            tempLat *= -1;
+        tempLng = nmeaDegreesToDecimal(tempLng);
+        if (lngDirection == 'W')
+            tempLng *= -1;
+
+        if (QLocationUtils::isValidLat(tempLat) && QLocationUtils::isValidLong(tempLng)) {
+            *lat = tempLat;
+            *lng = tempLng;
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace Reference
+
+class tst_QLocationUtils : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void getNmeaTime_data();
+    void getNmeaTime();
+    void getNmeaTime_exhaustive();
+
+    void getNmeaDate_data();
+    void getNmeaDate();
+    void getNmeaDate_exhaustive();
+
+    void getNmeaLatLong_data();
+    void getNmeaLatLong();
+    void getNmeaLatLong_exhaustive();
+};
+
+void tst_QLocationUtils::getNmeaTime_data()
+{
+    QTest::addColumn<QByteArray>("bytes");
+    QTest::addColumn<bool>("valid");
+    QTest::addColumn<QTime>("time");
+
+    QTest::newRow("hhmmss") << QByteArray("123519") << true << QTime(12, 35, 19);
+    QTest::newRow("hhmmss.z") << QByteArray("123519.5") << true << QTime(12, 35, 19, 500);
+    QTest::newRow("hhmmss.zz") << QByteArray("123519.25") << true << QTime(12, 35, 19, 250);
+    QTest::newRow("hhmmss.zzz") << QByteArray("123519.125") << true << QTime(12, 35, 19, 125);
+    QTest::newRow("midnight") << QByteArray("000000.00") << true << QTime(0, 0);
+    QTest::newRow("last second") << QByteArray("235959.999") << true << QTime(23, 59, 59, 999);
+    QTest::newRow("empty") << QByteArray() << false << QTime();
+    QTest::newRow("short") << QByteArray("12351") << false << QTime();
+    QTest::newRow("hour 24") << QByteArray("240000") << false << QTime();
+    QTest::newRow("minute 60") << QByteArray("126000") << false << QTime();
+    QTest::newRow("second 60") << QByteArray("120060") << false << QTime();
+    QTest::newRow("no fraction") << QByteArray("123519.") << false << QTime();
+    QTest::newRow("bad separator") << QByteArray("123519,5") << false << QTime();
+    QTest::newRow("letters") << QByteArray("12a519") << false << QTime();
+    QTest::newRow("bad fraction") << QByteArray("123519.5x") << false << QTime();
+}
+
+void tst_QLocationUtils::getNmeaTime()
+{
+    QFETCH(QByteArray, bytes);
+    QFETCH(bool, valid);
+    QFETCH(QTime, time);
+
+    QTime parsed;
+    QCOMPARE(QLocationUtils::getNmeaTime(bytes, &parsed), valid);
+    QCOMPARE(parsed, time);
+}
+
+void tst_QLocationUtils::getNmeaTime_exhaustive()
+{
+    static const char *fractions[] = { "", ".0", ".5", ".05", ".25", ".125", ".999", ".1234" };
+    for (int hour = 0; hour <= 24; ++hour) {
+        for (int minute = 0; minute <= 60; ++minute) {
+            for (int second : { 0, 7, 30, 59, 60 }) {
+                for (const char *fraction : fractions) {
+                    const QByteArray bytes = QByteArray::asprintf("%02d%02d%02d%s", hour, minute,
+                                                                  second, fraction);
+                    QTime parsed;
+                    QTime reference;
+                    const bool ok = QLocationUtils::getNmeaTime(bytes, &parsed);
+                    const bool referenceOk = Reference::getNmeaTime(bytes, &reference);
+                    QVERIFY2(ok == referenceOk && parsed == reference, bytes.constData());
+                }
+            }
+        }
+    }
+}
+
+void tst_QLocationUtils::getNmeaDate_data()
+{
+    QTest::addColumn<QByteArray>("bytes");
+    QTest::addColumn<bool>("valid");
+    QTest::addColumn<QDate>("date");
+
+    QTest::newRow("ddmmyy") << QByteArray("230394") << true << QDate(2094, 3, 23);
+    QTest::newRow("year 00") << QByteArray("010100") << true << QDate(2000, 1, 1);
+    QTest::newRow("leap day") << QByteArray("290224") << true << QDate(2024, 2, 29);
+    QTest::newRow("no leap day") << QByteArray("290223") << false << QDate();
+    QTest::newRow("empty") << QByteArray() << false << QDate();
+    QTest::newRow("short") << QByteArray("23039") << false << QDate();
+    QTest::newRow("long") << QByteArray("2303944") << false << QDate();
+    QTest::newRow("day 0") << QByteArray("000394") << false << QDate();
+    QTest::newRow("month 13") << QByteArray("231394") << false << QDate();
+    QTest::newRow("letters") << QByteArray("23o394") << false << QDate();
+}
+
+void tst_QLocationUtils::getNmeaDate()
+{
+    QFETCH(QByteArray, bytes);
+    QFETCH(bool, valid);
+    QFETCH(QDate, date);
+
+    QDate parsed;
+    QCOMPARE(QLocationUtils::getNmeaDate(bytes, &parsed), valid);
+    QCOMPARE(parsed, date);
+}
+
+void tst_QLocationUtils::getNmeaDate_exhaustive()
+{
+    for (int day = 0; day <= 32; ++day) {
+        for (int month = 0; month <= 13; ++month) {
+            for (int year = 0; year <= 99; ++year) {
+                const QByteArray bytes = QByteArray::asprintf("%02d%02d%02d", day, month, year);
+                QDate parsed;
+                QDate reference;
+                const bool ok = QLocationUtils::getNmeaDate(bytes, &parsed);
+                const bool referenceOk = Reference::getNmeaDate(bytes, &reference);
+                if (day == 29 && month == 2 && year == 0) {
+                    // The reference parsed the year as 1900, which is not a
+                    // leap year, before moving it to 2000.
+                    QVERIFY(!referenceOk);
+                    QVERIFY(ok);
+                    QCOMPARE(parsed, QDate(2000, 2, 29));
+                    continue;
+                }
+                QVERIFY2(ok == referenceOk && parsed == reference, bytes.constData());
+            }
+        }
+    }
+}
+
+void tst_QLocationUtils::getNmeaLatLong_data()
+{
+    QTest::addColumn<QByteArray>("latString");
+    QTest::addColumn<char>("latDirection");
+    QTest::addColumn<QByteArray>("lngString");
+    QTest::addColumn<char>("lngDirection");
+
+    QTest::newRow("NE") << QByteArray("4807.038") << 'N' << QByteArray("01131.000") << 'E';
+    QTest::newRow("SW") << QByteArray("2734.7964") << 'S' << QByteArray("15306.0124") << 'W';
+    QTest::newRow("integers") << QByteArray("4807") << 'N' << QByteArray("1131") << 'E';
+    QTest::newRow("trailing dot") << QByteArray("4807.") << 'N' << QByteArray("1131.") << 'E';
+    QTest::newRow("leading dot") << QByteArray(".5") << 'N' << QByteArray(".25") << 'E';
+    QTest::newRow("zero") << QByteArray("0000.0000") << 'S' << QByteArray("00000.0000") << 'W';
+    QTest::newRow("negative") << QByteArray("-4807.038") << 'N' << QByteArray("-1131.0") << 'E';
+    QTest::newRow("exponent") << QByteArray("4.807038e3") << 'N' << QByteArray("1131") << 'E';
+    QTest::newRow("plus sign") << QByteArray("+4807.038") << 'N' << QByteArray("1131") << 'E';
+    QTest::newRow("whitespace") << QByteArray(" 4807.038") << 'N' << QByteArray("1131 ") << 'E';
+    QTest::newRow("many digits") << QByteArray("4807.0380000000000000000001") << 'N'
+                                 << QByteArray("01131.00000000000000000000000") << 'E';
+    QTest::newRow("out of range") << QByteArray("9100.0") << 'N' << QByteArray("1131") << 'E';
+    QTest::newRow("empty") << QByteArray() << 'N' << QByteArray("1131") << 'E';
+    QTest::newRow("dot only") << QByteArray(".") << 'N' << QByteArray("1131") << 'E';
+    QTest::newRow("two dots") << QByteArray("48.07.038") << 'N' << QByteArray("1131") << 'E';
+    QTest::newRow("letters") << QByteArray("48o7.038") << 'N' << QByteArray("1131") << 'E';
+    QTest::newRow("bad direction") << QByteArray("4807.038") << 'E' << QByteArray("1131") << 'N';
+}
+
+void tst_QLocationUtils::getNmeaLatLong()
+{
+    QFETCH(QByteArray, latString);
+    QFETCH(char, latDirection);
+    QFETCH(QByteArray, lngString);
+    QFETCH(char, lngDirection);
+
+    double lat = qQNaN();
+    double lng = qQNaN();
+    const bool ok = QLocationUtils::getNmeaLatLong(latString, latDirection,
+                                                   lngString, lngDirection, &lat, &lng);
+    double referenceLat = qQNaN();
+    double referenceLng = qQNaN();
+    const bool referenceOk = Reference::getNmeaLatLong(latString, latDirection,
+                                                       lngString, lngDirection,
+                                                       &referenceLat, &referenceLng);
+    QCOMPARE(ok, referenceOk);
+    if (ok) {
+        // bitwise identical, not just fuzzy equal
+        QCOMPARE_EQ(lat, referenceLat);
+        QCOMPARE_EQ(lng, referenceLng);
+    }
+}
+
+void tst_QLocationUtils::getNmeaLatLong_exhaustive()
+{
+    // Walk through the whole value range with the field widths and precisions
+    // that receivers commonly send.
+    for (int degrees = 0; degrees <= 180; ++degrees) {
+        for (int precision = 0; precision <= 7; ++precision) {
+            for (double minutes = 0.0; minutes < 60.0; minutes += 0.7919) {
+                const QByteArray value = QByteArray::asprintf("%03d%0*.*f", degrees,
+                                                              precision ? precision + 3 : 2,
+                                                              precision, minutes);
+                double lat = qQNaN();
+                double lng = qQNaN();
+                double referenceLat = qQNaN();
+                double referenceLng = qQNaN();
+                const bool ok = QLocationUtils::getNmeaLatLong(value.sliced(1), 'S', value, 'W',
+                                                               &lat, &lng);
+                const bool referenceOk = Reference::getNmeaLatLong(value.sliced(1), 'S', value,
+                                                                   'W', &referenceLat,
+                                                                   &referenceLng);
+                QVERIFY2(ok == referenceOk, value.constData());
+                if (ok) {
+                    QVERIFY2(lat == referenceLat, value.constData());
+                    QVERIFY2(lng == referenceLng, value.constData());
+                }
+            }
+        }
+    }
+}
+
+QTEST_GUILESS_MAIN(tst_QLocationUtils)
+
+#include "tst_qlocationutils.moc"
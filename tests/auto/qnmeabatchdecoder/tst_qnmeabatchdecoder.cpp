@@ -0,0 +1,255 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include "../utils/qlocationtestutils_p.h"
+#include "../utils/qnmeaproxyfactory.h"
+
+#include <QtPositioning/QNmeaPositionInfoSource>
+#include <QtPositioning/private/qnmeabatchdecoder_p.h>
+
+#include <QSignalSpy>
+#include <QTemporaryFile>
+#include <QTest>
+#include <QTimeZone>
+
+QT_USE_NAMESPACE
+
+class tst_QNmeaBatchDecoder : public QObject
+{
+    Q_OBJECT
+
+private:
+    static QByteArray createLog(int epochs);
+    static QByteArray createMixedLog(int epochs);
+
+private slots:
+    void initTestCase();
+
+    void decode();
+    void decodeEmpty();
+    void decodeGarbage();
+    void decodeWithoutTrailingLineBreak();
+    void addDataInChunks_data();
+    void addDataInChunks();
+    void decodeFile();
+    void sameAsRealTimeSource();
+    void parallelSameAsSequential_data();
+    void parallelSameAsSequential();
+};
+
+static const QDateTime startTime(QDate(2024, 3, 1), QTime(12, 0), QTimeZone::UTC);
+
+QByteArray tst_QNmeaBatchDecoder::createLog(int epochs)
+{
+    QByteArray log;
+    for (int i = 0; i < epochs; ++i) {
+        const QDateTime dt = startTime.addMSecs(100 * i);
+        log += QLocationTestUtils::createRmcSentence(dt).toLatin1();
+        log += QLocationTestUtils::createGgaSentence(dt.time()).toLatin1();
+        log += QLocationTestUtils::createGsaSentence().toLatin1();
+        log += QLocationTestUtils::createGsvSentence().toLatin1();
+    }
+    return log;
+}
+
+// Uses the same sentence generators as the QNmeaPositionInfoSource tests, with
+// epochs lacking dates, timestamps or fixes, garbage and out of order data.
+QByteArray tst_QNmeaBatchDecoder::createMixedLog(int epochs)
+{
+    QByteArray log;
+    for (int i = 0; i < epochs; ++i) {
+        const QDateTime dt = startTime.addMSecs(100 * i);
+        switch (i % 7) {
+        case 0:
+            log += QLocationTestUtils::createRmcSentence(dt).toLatin1();
+            log += QLocationTestUtils::createGgaSentence(dt.time()).toLatin1();
+            log += QLocationTestUtils::createGsaSentence().toLatin1();
+            log += QLocationTestUtils::createGsvSentence().toLatin1();
+            break;
+        case 1:
+            log += QLocationTestUtils::createGgaSentence(dt.time()).toLatin1();
+            log += QLocationTestUtils::createGsaLongSentence().toLatin1();
+            break;
+        case 2:
+            log += QLocationTestUtils::createZdaSentence(dt).toLatin1();
+            log += QLocationTestUtils::createGgaSentence(i % 90, i % 180, dt.time()).toLatin1();
+            break;
+        case 3:
+            log += "$GPGGA,garbage*00\r\n";
+            log += QLocationTestUtils::createRmcSentence(dt).toLatin1();
+            break;
+        case 4:
+            log += QLocationTestUtils::createRmcSentence(dt).toLatin1();
+            log += QLocationTestUtils::createGgaSentence(dt.addSecs(-1).time()).toLatin1();
+            break;
+        case 5:
+            log += QLocationTestUtils::createGsaVariableSentence(quint8(i)).toLatin1();
+            log += QLocationTestUtils::createGgaSentence(dt.time()).toLatin1();
+            break;
+        case 6:
+            log += QLocationTestUtils::createGsaSentence().toLatin1();
+            break;
+        }
+    }
+    return log;
+}
+
+void tst_QNmeaBatchDecoder::initTestCase()
+{
+    // Make sure the real-time source never pushes a partially received epoch
+    // in sameAsRealTimeSource().
+    qputenv("QT_NMEA_PUSH_DELAY", "1000");
+}
+
+void tst_QNmeaBatchDecoder::decode()
+{
+    constexpr int epochs = 50;
+    QNmeaBatchDecoder decoder(5.1);
+    const QList<QGeoPositionInfo> positions = decoder.decode(createLog(epochs));
+
+    // RMC, GGA and GSA are parsed, GSV is not a position sentence
+    QCOMPARE(decoder.sentenceCount(), epochs * 3);
+    QCOMPARE(positions.size(), epochs);
+    for (int i = 0; i < epochs; ++i) {
+        const QGeoPositionInfo &info = positions.at(i);
+        QCOMPARE(info.timestamp(), startTime.addMSecs(100 * i));
+        QVERIFY(info.coordinate().isValid());
+        QCOMPARE(info.coordinate().altitude(), 49.4); // from GGA
+        QVERIFY(info.hasAttribute(QGeoPositionInfo::GroundSpeed)); // from RMC
+        QVERIFY(info.hasAttribute(QGeoPositionInfo::MagneticVariation)); // from RMC
+        QCOMPARE(info.attribute(QGeoPositionInfo::HorizontalAccuracy), 2 * 3.5 * 5.1); // from GSA
+        QCOMPARE(info.attribute(QGeoPositionInfo::VerticalAccuracy), 2 * 4.0 * 5.1); // from GSA
+    }
+
+    // the decoder can be reused for more data
+    QCOMPARE(decoder.decode(createLog(1)).size(), 0); // not newer than the last update
+}
+
+void tst_QNmeaBatchDecoder::decodeEmpty()
+{
+    QNmeaBatchDecoder decoder;
+    QVERIFY(decoder.decode(QByteArrayView()).isEmpty());
+    QCOMPARE(decoder.sentenceCount(), 0);
+}
+
+void tst_QNmeaBatchDecoder::decodeGarbage()
+{
+    QByteArray log = createLog(3);
+    log.prepend("garbage\r\n$GPRMC,invalid*00\r\n\r\n");
+    log.insert(log.indexOf("$GPGGA"), "$GPGGA,no checksum\r\n");
+
+    QNmeaBatchDecoder decoder;
+    const QList<QGeoPositionInfo> positions = decoder.decode(log);
+    QCOMPARE(decoder.sentenceCount(), 9);
+    QCOMPARE(positions, QNmeaBatchDecoder().decode(createLog(3)));
+}
+
+void tst_QNmeaBatchDecoder::decodeWithoutTrailingLineBreak()
+{
+    QByteArray log = createLog(2);
+    log += QLocationTestUtils::createRmcSentence(startTime.addSecs(1)).toLatin1();
+    log.chop(2);
+
+    QNmeaBatchDecoder decoder;
+    const QList<QGeoPositionInfo> positions = decoder.decode(log);
+    QCOMPARE(positions.size(), 3);
+    QCOMPARE(positions.last().timestamp(), startTime.addSecs(1));
+}
+
+void tst_QNmeaBatchDecoder::addDataInChunks_data()
+{
+    QTest::addColumn<int>("chunkSize");
+
+    QTest::newRow("1") << 1;
+    QTest::newRow("7") << 7;
+    QTest::newRow("64") << 64;
+    QTest::newRow("1000") << 1000;
+}
+
+void tst_QNmeaBatchDecoder::addDataInChunks()
+{
+    QFETCH(int, chunkSize);
+
+    const QByteArray log = createLog(20);
+    const QList<QGeoPositionInfo> expected = QNmeaBatchDecoder().decode(log);
+
+    QNmeaBatchDecoder decoder;
+    for (qsizetype i = 0; i < log.size(); i += chunkSize)
+        decoder.addData(QByteArrayView(log).sliced(i, qMin(qsizetype(chunkSize), log.size() - i)));
+    decoder.finish();
+    QCOMPARE(decoder.takePositions(), expected);
+    QCOMPARE(decoder.sentenceCount(), 60);
+}
+
+void tst_QNmeaBatchDecoder::decodeFile()
+{
+    const QByteArray log = createLog(20);
+
+    QTemporaryFile file;
+    QVERIFY(file.open());
+    QCOMPARE(file.write(log), log.size());
+    QVERIFY(file.seek(0));
+
+    QCOMPARE(QNmeaBatchDecoder().decode(&file), QNmeaBatchDecoder().decode(log));
+}
+
+void tst_QNmeaBatchDecoder::sameAsRealTimeSource()
+{
+    const QByteArray log = createLog(20);
+    const QList<QGeoPositionInfo> expected = QNmeaBatchDecoder(5.1).decode(log);
+    QCOMPARE(expected.size(), 20);
+
+    QNmeaProxyFactory factory;
+    QNmeaPositionInfoSource source(QNmeaPositionInfoSource::RealTimeMode);
+    source.setUserEquivalentRangeError(5.1);
+    QNmeaPositionInfoSourceProxy *proxy = factory.createPositionInfoSourceProxy(&source);
+
+    QSignalSpy spy(&source, &QNmeaPositionInfoSource::positionUpdated);
+    source.startUpdates();
+    proxy->feedBytes(log);
+
+    QTRY_COMPARE(spy.size(), expected.size());
+    for (qsizetype i = 0; i < expected.size(); ++i)
+        QCOMPARE(spy.at(i).at(0).value<QGeoPositionInfo>(), expected.at(i));
+}
+
+void tst_QNmeaBatchDecoder::parallelSameAsSequential_data()
+{
+    QTest::addColumn<int>("threadCount");
+
+    QTest::newRow("2") << 2;
+    QTest::newRow("3") << 3;
+    QTest::newRow("4") << 4;
+    QTest::newRow("ideal") << 0;
+}
+
+void tst_QNmeaBatchDecoder::parallelSameAsSequential()
+{
+    QFETCH(int, threadCount);
+
+    // Large enough to be decoded in several rounds of parallel parsing
+    static const QByteArray log = createMixedLog(70000);
+
+    QNmeaBatchDecoder sequential(5.1);
+    const QList<QGeoPositionInfo> expected = sequential.decode(log);
+    QVERIFY(expected.size() > 50000);
+
+    QNmeaBatchDecoder parallel(5.1);
+    parallel.setThreadCount(threadCount);
+    QVERIFY(parallel.threadCount() > 0);
+    QCOMPARE(parallel.decode(log), expected);
+    QCOMPARE(parallel.sentenceCount(), sequential.sentenceCount());
+
+    // the same when fed in pieces that do not end at sentence boundaries
+    QNmeaBatchDecoder chunked(5.1);
+    chunked.setThreadCount(threadCount);
+    constexpr qsizetype chunkSize = 3 * 1024 * 1024 + 17;
+    for (qsizetype i = 0; i < log.size(); i += chunkSize)
+        chunked.addData(QByteArrayView(log).sliced(i, qMin(chunkSize, log.size() - i)));
+    chunked.finish();
+    QCOMPARE(chunked.takePositions(), expected);
+}
+
+QTEST_GUILESS_MAIN(tst_QNmeaBatchDecoder)
+
+#include "tst_qnmeabatchdecoder.moc"
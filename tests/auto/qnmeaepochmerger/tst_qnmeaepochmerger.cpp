@@ -0,0 +1,134 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include "../utils/qlocationtestutils_p.h"
+
+#include <QtPositioning/private/qlocationutils_p.h>
+#include <QtPositioning/private/qnmeaepochmerger_p.h>
+
+#include <QTest>
+#include <QTimeZone>
+
+QT_USE_NAMESPACE
+
+class tst_QNmeaEpochMerger : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void keepSentences();
+    void keepSentencesOfLateSentence();
+    void keepNoSentencesByDefault();
+
+private:
+    static QList<QByteArray> epoch(const QDateTime &dt, int lat = 0);
+    static void addSentences(QNmeaEpochMerger &merger, const QList<QByteArray> &sentences,
+                             QList<QGeoPositionInfo> *updates);
+    static QList<QByteArray> toByteArrays(const QList<QByteArrayView> &views);
+};
+
+QList<QByteArray> tst_QNmeaEpochMerger::epoch(const QDateTime &dt, int lat)
+{
+    return {
+        QLocationTestUtils::createRmcSentence(dt).toLatin1(),
+        QLocationTestUtils::createGgaSentence(lat, 0, dt.time()).toLatin1(),
+        QLocationTestUtils::createGsaSentence().toLatin1(),
+    };
+}
+
+void tst_QNmeaEpochMerger::addSentences(QNmeaEpochMerger &merger,
+                                        const QList<QByteArray> &sentences,
+                                        QList<QGeoPositionInfo> *updates)
+{
+    for (const QByteArray &sentence : sentences) {
+        QGeoPositionInfo pos;
+        bool hasFix = false;
+        QVERIFY(QLocationUtils::getPosInfoFromNmea(sentence, &pos, qQNaN(), &hasFix));
+        merger.addPosition(std::move(pos), hasFix, sentence,
+                           [updates](QGeoPositionInfo *update, bool) {
+            updates->append(*update);
+        });
+    }
+}
+
+QList<QByteArray> tst_QNmeaEpochMerger::toByteArrays(const QList<QByteArrayView> &views)
+{
+    QList<QByteArray> result;
+    for (QByteArrayView view : views)
+        result.append(view.toByteArray());
+    return result;
+}
+
+void tst_QNmeaEpochMerger::keepSentences()
+{
+    const QDateTime start(QDate(2024, 5, 1), QTime(12, 0), QTimeZone::UTC);
+    QList<QList<QByteArray>> epochs;
+    for (int i = 0; i < 3; ++i)
+        epochs.append(epoch(start.addSecs(i), i));
+
+    QList<QGeoPositionInfo> updates;
+    {
+        QNmeaEpochMerger merger;
+        merger.setKeepSentences(true);
+        QVERIFY(merger.keepsSentences());
+        for (const QList<QByteArray> &sentences : std::as_const(epochs))
+            addSentences(merger, sentences, &updates);
+        merger.flush([&updates](QGeoPositionInfo *update, bool) { updates.append(*update); });
+    }
+
+    // the updates handed out outlive the merger, and keep their own sentences
+    QCOMPARE(updates.size(), epochs.size());
+    for (qsizetype i = 0; i < updates.size(); ++i) {
+        QCOMPARE(updates.at(i).timestamp(), start.addSecs(i));
+        QCOMPARE(toByteArrays(QNmeaEpochMerger::keptSentences(updates.at(i))), epochs.at(i));
+    }
+
+    // detaching a copy keeps the sentences
+    QGeoPositionInfo copy = updates.constFirst();
+    copy.setAttribute(QGeoPositionInfo::Direction, 90);
+    QCOMPARE(toByteArrays(QNmeaEpochMerger::keptSentences(copy)), epochs.constFirst());
+    QCOMPARE(toByteArrays(QNmeaEpochMerger::keptSentences(updates.constFirst())),
+             epochs.constFirst());
+}
+
+void tst_QNmeaEpochMerger::keepSentencesOfLateSentence()
+{
+    const QDateTime start(QDate(2024, 5, 1), QTime(12, 0), QTimeZone::UTC);
+    const QList<QByteArray> sentences = epoch(start);
+    const QByteArray late = QLocationTestUtils::createGgaSentence(10, 20, start.time()).toLatin1();
+
+    QNmeaEpochMerger merger;
+    merger.setKeepSentences(true);
+    QList<QGeoPositionInfo> updates;
+    const auto push = [&updates](QGeoPositionInfo *update, bool) { updates.append(*update); };
+    addSentences(merger, sentences, &updates);
+    merger.flush(push);
+    QCOMPARE(updates.size(), 1);
+
+    // a sentence of the same epoch after the flush changes the update, which
+    // is then handed out again, while the first one is left as it was
+    addSentences(merger, { late }, &updates);
+    merger.flush(push);
+    QCOMPARE(updates.size(), 2);
+    QCOMPARE(toByteArrays(QNmeaEpochMerger::keptSentences(updates.at(0))), sentences);
+    QCOMPARE(toByteArrays(QNmeaEpochMerger::keptSentences(updates.at(1))),
+             sentences + QList<QByteArray>{ late });
+    QCOMPARE_NE(updates.at(1).coordinate(), updates.at(0).coordinate());
+}
+
+void tst_QNmeaEpochMerger::keepNoSentencesByDefault()
+{
+    QNmeaEpochMerger merger;
+    QCOMPARE(merger.keepsSentences(), bool(QT_NMEA_EPOCH_MERGER_KEEP_SENTENCES));
+    merger.setKeepSentences(false);
+
+    const QDateTime start(QDate(2024, 5, 1), QTime(12, 0), QTimeZone::UTC);
+    QList<QGeoPositionInfo> updates;
+    addSentences(merger, epoch(start), &updates);
+    merger.flush([&updates](QGeoPositionInfo *update, bool) { updates.append(*update); });
+    QCOMPARE(updates.size(), 1);
+    QVERIFY(QNmeaEpochMerger::keptSentences(updates.constFirst()).isEmpty());
+}
+
+QTEST_GUILESS_MAIN(tst_QNmeaEpochMerger)
+#include "tst_qnmeaepochmerger.moc"
@@ -0,0 +1,179 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include "../utils/qlocationtestutils_p.h"
+
+#include <QtPositioning/private/qnmealogindex_p.h>
+
+#include <QBuffer>
+#include <QFile>
+#include <QTemporaryDir>
+#include <QTest>
+#include <QTimeZone>
+
+QT_USE_NAMESPACE
+
+class tst_QNmeaLogIndex : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void build();
+    void find();
+    void timeOnlySentences();
+    void sidecar();
+};
+
+static const QDateTime logStart(QDate(2024, 5, 17), QTime(6, 59, 50), QTimeZone::UTC);
+
+// Two epochs per second; returns the offsets of the epochs in \a offsets
+static QByteArray createLog(int epochCount, QList<qint64> *offsets = nullptr)
+{
+    QByteArray log;
+    for (int i = 0; i < epochCount; ++i) {
+        if (offsets)
+            offsets->append(log.size());
+        const QDateTime dt = logStart.addMSecs(i * 500);
+        log += QLocationTestUtils::createRmcSentence(dt).toLatin1();
+        log += QLocationTestUtils::createGgaSentence(dt.time()).toLatin1();
+        log += QLocationTestUtils::createGsaSentence().toLatin1();
+        log += QLocationTestUtils::createGsvSentence().toLatin1();
+    }
+    return log;
+}
+
+void tst_QNmeaLogIndex::build()
+{
+    QList<qint64> offsets;
+    QBuffer buffer;
+    buffer.setData(createLog(40, &offsets));
+    QVERIFY(buffer.open(QIODevice::ReadOnly));
+    buffer.seek(10);
+
+    QNmeaLogIndex index;
+    QVERIFY(index.build(&buffer));
+    QCOMPARE(buffer.pos(), 10);
+
+    // one entry per second of the log, at every other epoch
+    const QList<QNmeaLogIndex::Entry> &entries = index.entries();
+    QCOMPARE(entries.size(), 20);
+    for (qsizetype i = 0; i < entries.size(); ++i) {
+        QCOMPARE(entries.at(i).msecsSinceEpoch, logStart.addSecs(i).toMSecsSinceEpoch());
+        QCOMPARE(entries.at(i).offset, offsets.at(2 * i));
+    }
+
+    QVERIFY(!index.build(nullptr));
+    QVERIFY(index.isEmpty());
+}
+
+void tst_QNmeaLogIndex::find()
+{
+    QList<qint64> offsets;
+    QBuffer buffer;
+    buffer.setData(createLog(40, &offsets));
+    QVERIFY(buffer.open(QIODevice::ReadOnly));
+
+    QNmeaLogIndex index;
+    QVERIFY(index.open(&buffer));
+
+    // every epoch is found, also those between the entries of the index
+    for (qsizetype i = 0; i < offsets.size(); ++i)
+        QCOMPARE(index.find(&buffer, logStart.addMSecs(i * 500)), offsets.at(i));
+    QCOMPARE(buffer.pos(), 0);
+
+    // a time between two epochs finds the later one
+    QCOMPARE(index.find(&buffer, logStart.addMSecs(1250)), offsets.at(3));
+    QCOMPARE(index.find(&buffer, logStart.addSecs(-60)), 0);
+    QCOMPARE(index.find(&buffer, logStart.addSecs(60)), -1);
+    QCOMPARE(index.find(&buffer, QDateTime()), -1);
+}
+
+void tst_QNmeaLogIndex::timeOnlySentences()
+{
+    // the date of GGA sentences comes from the ZDA sentence preceding them
+    QByteArray log = QLocationTestUtils::createZdaSentence(logStart).toLatin1();
+    QList<qint64> offsets;
+    for (int i = 1; i <= 5; ++i) {
+        offsets.append(log.size());
+        log += QLocationTestUtils::createGgaSentence(logStart.addSecs(i).time()).toLatin1();
+    }
+    QBuffer buffer(&log);
+    QVERIFY(buffer.open(QIODevice::ReadOnly));
+
+    QNmeaLogIndex index;
+    QVERIFY(index.open(&buffer));
+    QCOMPARE(index.entries().size(), 6);
+    QCOMPARE(index.find(&buffer, logStart.addSecs(3)), offsets.at(2));
+}
+
+void tst_QNmeaLogIndex::sidecar()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString logFileName = dir.filePath(QStringLiteral("log.nmea"));
+    const QString sidecarFileName = QNmeaLogIndex::sidecarFileName(logFileName);
+
+    QList<qint64> offsets;
+    QFile log(logFileName);
+    QVERIFY(log.open(QIODevice::WriteOnly));
+    log.write(createLog(40, &offsets));
+    log.close();
+    QVERIFY(log.open(QIODevice::ReadOnly));
+
+    // opening does not write the sidecar, saving does, and the next index reads it
+    QNmeaLogIndex index;
+    QVERIFY(!QFile::exists(sidecarFileName));
+    QVERIFY(index.open(&log));
+    QVERIFY(!QFile::exists(sidecarFileName));
+    QVERIFY(index.save(logFileName));
+    QVERIFY(QFile::exists(sidecarFileName));
+
+    QNmeaLogIndex loaded;
+    QVERIFY(loaded.load(logFileName));
+    QCOMPARE(loaded.entries().size(), index.entries().size());
+    for (qsizetype i = 0; i < index.entries().size(); ++i) {
+        QCOMPARE(loaded.entries().at(i).msecsSinceEpoch, index.entries().at(i).msecsSinceEpoch);
+        QCOMPARE(loaded.entries().at(i).offset, index.entries().at(i).offset);
+    }
+    QCOMPARE(loaded.find(&log, logStart.addSecs(5)), offsets.at(10));
+    log.close();
+
+    // a sidecar does not match a log that has changed since
+    QVERIFY(log.open(QIODevice::Append));
+    log.write(QLocationTestUtils::createRmcSentence(logStart.addSecs(30)).toLatin1());
+    log.close();
+    QVERIFY(!loaded.load(logFileName));
+    QVERIFY(loaded.isEmpty());
+
+    QVERIFY(log.open(QIODevice::ReadOnly));
+    QVERIFY(loaded.open(&log));
+    QCOMPARE(loaded.entries().size(), index.entries().size() + 1);
+    QVERIFY(!loaded.load(logFileName)); // opening did not update the sidecar
+    QVERIFY(loaded.open(&log));
+    log.close();
+
+    // nor does an index kept in memory, when the size has not changed
+    QFile changed(logFileName);
+    QVERIFY(changed.open(QIODevice::ReadWrite));
+    changed.write("#"); // the first sentence is no longer one
+    QVERIFY(changed.flush());
+    QVERIFY(changed.setFileTime(QDateTime::currentDateTimeUtc().addSecs(60),
+                                QFileDevice::FileModificationTime));
+    changed.close();
+    QVERIFY(log.open(QIODevice::ReadOnly));
+    QVERIFY(loaded.open(&log));
+    QCOMPARE(loaded.entries().constFirst().offset, offsets.at(1));
+    QVERIFY(loaded.save(logFileName));
+    QVERIFY(loaded.load(logFileName));
+
+    // a corrupt sidecar is not used
+    QFile corrupt(sidecarFileName);
+    QVERIFY(corrupt.open(QIODevice::WriteOnly | QIODevice::Truncate));
+    corrupt.write("garbage");
+    corrupt.close();
+    QVERIFY(!loaded.load(logFileName));
+}
+
+QTEST_APPLESS_MAIN(tst_QNmeaLogIndex)
+
+#include "tst_qnmealogindex.moc"
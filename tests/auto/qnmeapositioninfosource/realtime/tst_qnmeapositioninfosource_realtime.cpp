@@ -5,6 +5,11 @@
 
 #include "tst_qnmeapositioninfosource.h"
 
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QScopeGuard>
+
+#include <algorithm>
+
 class tst_QNmeaPositionInfoSource_RealTime : public tst_QNmeaPositionInfoSource
 {
     Q_OBJECT
@@ -12,8 +17,121 @@ class tst_QNmeaPositionInfoSource_RealTime : public tst_QNmeaPositionInfoSource
 public:
     tst_QNmeaPositionInfoSource_RealTime()
         : tst_QNmeaPositionInfoSource(QNmeaPositionInfoSource::RealTimeMode) {}
+
+private slots:
+    void epochLatency();
+    void lateSentenceAfterEarlyPush();
 };
 
+static QByteArray epochSentences(const QDateTime &dt, int ggaCount = 1)
+{
+    QString sentences = QLocationTestUtils::createRmcSentence(dt);
+    for (int i = 0; i < ggaCount; ++i)
+        sentences += QLocationTestUtils::createGgaSentence(dt.time());
+    sentences += QLocationTestUtils::createGsaSentence();
+    return sentences.toLatin1();
+}
+
+void tst_QNmeaPositionInfoSource_RealTime::epochLatency()
+{
+    // Long enough to tell a push on the last sentence of an epoch from one
+    // on the timeout, even on a busy machine.
+    constexpr int PushDelay = 1000;
+    qputenv("QT_NMEA_PUSH_DELAY", QByteArray::number(PushDelay));
+    const auto resetPushDelay = qScopeGuard([] { qunsetenv("QT_NMEA_PUSH_DELAY"); });
+
+    QNmeaPositionInfoSource source(QNmeaPositionInfoSource::RealTimeMode);
+    QNmeaProxyFactory factory;
+    QNmeaPositionInfoSourceProxy *proxy = factory.createPositionInfoSourceProxy(&source);
+
+    QElapsedTimer timer;
+    QList<qint64> latencies;
+    connect(proxy->source(), &QGeoPositionInfoSource::positionUpdated, this,
+            [&](const QGeoPositionInfo &) { latencies.append(timer.elapsed()); });
+    proxy->source()->startUpdates();
+
+    // Three epochs in a row: the first two are pushed by the sentences of
+    // the next one, the third by its last sentence, as the order is known
+    // by then.
+    QDateTime dt = QDateTime::currentDateTimeUtc();
+    QByteArray learning;
+    for (int i = 0; i < 3; ++i) {
+        dt = dt.addMSecs(100);
+        learning += epochSentences(dt);
+    }
+    timer.start();
+    proxy->feedBytes(learning);
+    QTRY_COMPARE(latencies.size(), 3);
+    QVERIFY2(latencies.last() < PushDelay / 2, QByteArray::number(latencies.last()));
+
+    // Sentence-to-signal time of epochs that follow the learned order
+    for (int i = 0; i < 10; ++i) {
+        latencies.clear();
+        dt = dt.addMSecs(100);
+        timer.start();
+        proxy->feedBytes(epochSentences(dt));
+        QTRY_COMPARE(latencies.size(), 1);
+        QVERIFY2(latencies.first() < PushDelay / 2, QByteArray::number(latencies.first()));
+    }
+
+    // An epoch with an additional sentence breaks the order, so the next
+    // one has to wait for the timeout again.
+    dt = dt.addMSecs(100);
+    proxy->feedBytes(epochSentences(dt, 2));
+    QTRY_VERIFY(!latencies.isEmpty());
+    latencies.clear();
+    dt = dt.addMSecs(100);
+    timer.start();
+    proxy->feedBytes(epochSentences(dt));
+    QTRY_COMPARE_WITH_TIMEOUT(latencies.size(), 1, 4 * PushDelay);
+    QVERIFY2(latencies.first() >= PushDelay / 2, QByteArray::number(latencies.first()));
+}
+
+void tst_QNmeaPositionInfoSource_RealTime::lateSentenceAfterEarlyPush()
+{
+    QNmeaPositionInfoSource source(QNmeaPositionInfoSource::RealTimeMode);
+    QNmeaProxyFactory factory;
+    QNmeaPositionInfoSourceProxy *proxy = factory.createPositionInfoSourceProxy(&source);
+
+    QList<QGeoPositionInfo> updates;
+    connect(proxy->source(), &QGeoPositionInfoSource::positionUpdated, this,
+            [&](const QGeoPositionInfo &update) { updates.append(update); });
+    proxy->source()->startUpdates();
+
+    // RMC and GSA, without altitude, twice: the order is learned
+    QDateTime dt = QDateTime::currentDateTimeUtc();
+    for (int i = 0; i < 2; ++i) {
+        dt = dt.addMSecs(100);
+        proxy->feedBytes((QLocationTestUtils::createRmcSentence(dt)
+                          + QLocationTestUtils::createGsaSentence()).toLatin1());
+    }
+
+    // The epoch is pushed on its GSA. The GGA trailing it has the same time,
+    // and does not make the epoch be pushed again, even once the push delay
+    // has passed.
+    dt = dt.addMSecs(100);
+    const QTime lateTime = dt.time();
+    proxy->feedBytes((QLocationTestUtils::createRmcSentence(dt)
+                      + QLocationTestUtils::createGsaSentence()
+                      + QLocationTestUtils::createGgaSentence(dt.time())).toLatin1());
+    const auto countUpdatesAt = [&updates](QTime time) {
+        return std::count_if(updates.cbegin(), updates.cend(), [time](const QGeoPositionInfo &u) {
+            return u.timestamp().time() == time;
+        });
+    };
+    QTRY_COMPARE(countUpdatesAt(lateTime), 1);
+    QTest::qWait(200);
+    QCOMPARE(countUpdatesAt(lateTime), 1);
+    QVERIFY(qIsNaN(updates.last().coordinate().altitude()));
+
+    // The altitude of the late GGA is folded into the next epoch instead
+    dt = dt.addMSecs(100);
+    proxy->feedBytes((QLocationTestUtils::createRmcSentence(dt)
+                      + QLocationTestUtils::createGsaSentence()).toLatin1());
+    QTRY_COMPARE(countUpdatesAt(dt.time()), 1);
+    QCOMPARE(updates.last().coordinate().altitude(), 49.4);
+}
+
 #include "tst_qnmeapositioninfosource_realtime.moc"
 
 QTEST_GUILESS_MAIN(tst_QNmeaPositionInfoSource_RealTime);
@@ -5,14 +5,189 @@
 
 #include "tst_qnmeapositioninfosource.h"
 
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QTemporaryDir>
+#include <QtPositioning/private/qnmealogindex_p.h>
+
 class tst_QNmeaPositionInfoSource_Simulation : public tst_QNmeaPositionInfoSource
 {
     Q_OBJECT
 public:
     tst_QNmeaPositionInfoSource_Simulation()
         : tst_QNmeaPositionInfoSource(QNmeaPositionInfoSource::SimulationMode) {}
+
+private slots:
+    void simulationSpeedProperty();
+    void simulationSpeed_data();
+    void simulationSpeed();
+    void tinySimulationSpeed();
+    void seek();
+    void seekSavesIndex();
 };
 
+void tst_QNmeaPositionInfoSource_Simulation::simulationSpeedProperty()
+{
+    const QString &name = QNmeaPositionInfoSource::SimulationSpeed;
+
+    QNmeaPositionInfoSource source(QNmeaPositionInfoSource::SimulationMode);
+    QCOMPARE(source.backendProperty(name).toDouble(), 1.0);
+    QVERIFY(source.setBackendProperty(name, 2.5));
+    QCOMPARE(source.backendProperty(name).toDouble(), 2.5);
+    QVERIFY(source.setBackendProperty(name, 0));
+    QCOMPARE(source.backendProperty(name).toDouble(), 0.0);
+
+    QVERIFY(!source.setBackendProperty(name, -1));
+    QVERIFY(!source.setBackendProperty(name, qQNaN()));
+    QVERIFY(!source.setBackendProperty(name, QStringLiteral("fast")));
+    QCOMPARE(source.backendProperty(name).toDouble(), 0.0);
+
+    QNmeaPositionInfoSource realTimeSource(QNmeaPositionInfoSource::RealTimeMode);
+    QVERIFY(!realTimeSource.setBackendProperty(name, 2));
+    QVERIFY(!realTimeSource.backendProperty(name).isValid());
+}
+
+void tst_QNmeaPositionInfoSource_Simulation::simulationSpeed_data()
+{
+    QTest::addColumn<double>("speed");
+    QTest::addColumn<int>("minimumDuration");
+    QTest::addColumn<int>("timeout");
+
+    // 10 seconds of recorded data
+    QTest::newRow("as fast as possible") << 0.0 << 0 << 1000;
+    QTest::newRow("twenty times faster") << 20.0 << 400 << 5000;
+}
+
+void tst_QNmeaPositionInfoSource_Simulation::simulationSpeed()
+{
+    QFETCH(double, speed);
+    QFETCH(int, minimumDuration);
+    QFETCH(int, timeout);
+
+    QList<QDateTime> dateTimes;
+    QByteArray bytes;
+    const QDateTime dt = QDateTime::currentDateTimeUtc();
+    for (int i = 0; i <= 10; ++i) {
+        dateTimes << dt.addSecs(i);
+        bytes += QLocationTestUtils::createRmcSentence(dateTimes.last()).toLatin1();
+    }
+    QBuffer buffer;
+    buffer.setData(bytes);
+
+    QNmeaPositionInfoSource source(QNmeaPositionInfoSource::SimulationMode);
+    QVERIFY(source.setBackendProperty(QNmeaPositionInfoSource::SimulationSpeed, speed));
+    QSignalSpy spy(&source, &QGeoPositionInfoSource::positionUpdated);
+    source.setDevice(&buffer);
+
+    QElapsedTimer timer;
+    timer.start();
+    source.startUpdates();
+    QTRY_COMPARE_WITH_TIMEOUT(spy.size(), dateTimes.size(), timeout);
+    QVERIFY(timer.elapsed() >= minimumDuration);
+
+    for (qsizetype i = 0; i < dateTimes.size(); ++i)
+        QCOMPARE(spy.at(i).at(0).value<QGeoPositionInfo>().timestamp(), dateTimes.at(i));
+}
+
+void tst_QNmeaPositionInfoSource_Simulation::tinySimulationSpeed()
+{
+    const QDateTime dt = QDateTime::currentDateTimeUtc();
+    QBuffer buffer;
+    buffer.setData((QLocationTestUtils::createRmcSentence(dt)
+                    + QLocationTestUtils::createRmcSentence(dt.addSecs(1))).toLatin1());
+
+    // the second update is a second away, divided by 1e-9
+    QNmeaPositionInfoSource source(QNmeaPositionInfoSource::SimulationMode);
+    QVERIFY(source.setBackendProperty(QNmeaPositionInfoSource::SimulationSpeed, 1e-9));
+    QSignalSpy spy(&source, &QGeoPositionInfoSource::positionUpdated);
+    source.setDevice(&buffer);
+
+    source.startUpdates();
+    QTRY_COMPARE(spy.size(), 1);
+    QTest::qWait(500);
+    QCOMPARE(spy.size(), 1);
+}
+
+void tst_QNmeaPositionInfoSource_Simulation::seek()
+{
+    QList<QDateTime> dateTimes;
+    QByteArray bytes;
+    const QDateTime dt = QDateTime::currentDateTimeUtc();
+    for (int i = 0; i <= 10; ++i) {
+        dateTimes << dt.addSecs(i);
+        bytes += QLocationTestUtils::createRmcSentence(dateTimes.last()).toLatin1();
+    }
+    QBuffer buffer;
+    buffer.setData(bytes);
+
+    QNmeaPositionInfoSource source(QNmeaPositionInfoSource::SimulationMode);
+    QVERIFY(source.setBackendProperty(QNmeaPositionInfoSource::SimulationSpeed, 0));
+    QSignalSpy spy(&source, &QGeoPositionInfoSource::positionUpdated);
+    QVERIFY(!source.seek(dateTimes.at(6)));
+    source.setDevice(&buffer);
+
+    // before the replay has started
+    QVERIFY(source.seek(dateTimes.at(6)));
+    source.startUpdates();
+    QTRY_COMPARE(spy.size(), 5);
+    for (qsizetype i = 0; i < spy.size(); ++i)
+        QCOMPARE(spy.at(i).at(0).value<QGeoPositionInfo>().timestamp(), dateTimes.at(6 + i));
+
+    // back, once the replay has reached the end
+    spy.clear();
+    QVERIFY(source.seek(dateTimes.at(2).addMSecs(-200)));
+    QTRY_COMPARE(spy.size(), 9);
+    for (qsizetype i = 0; i < spy.size(); ++i)
+        QCOMPARE(spy.at(i).at(0).value<QGeoPositionInfo>().timestamp(), dateTimes.at(2 + i));
+
+    // a time after the end of the log leaves the replay where it is
+    QVERIFY(!source.seek(dateTimes.last().addSecs(1)));
+
+    QNmeaPositionInfoSource realTimeSource(QNmeaPositionInfoSource::RealTimeMode);
+    QBuffer realTimeBuffer;
+    realTimeBuffer.setData(bytes);
+    realTimeSource.setDevice(&realTimeBuffer);
+    QVERIFY(!realTimeSource.seek(dateTimes.at(6)));
+}
+
+void tst_QNmeaPositionInfoSource_Simulation::seekSavesIndex()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString logFileName = dir.filePath(QStringLiteral("log.nmea"));
+    const QString sidecarFileName = QNmeaLogIndex::sidecarFileName(logFileName);
+
+    const QDateTime dt = QDateTime::currentDateTimeUtc();
+    QFile log(logFileName);
+    QVERIFY(log.open(QIODevice::WriteOnly));
+    for (int i = 0; i <= 10; ++i)
+        log.write(QLocationTestUtils::createRmcSentence(dt.addSecs(i)).toLatin1());
+    log.close();
+
+    // the index is not saved by default
+    QNmeaPositionInfoSource source(QNmeaPositionInfoSource::SimulationMode);
+    QCOMPARE(source.backendProperty(QNmeaPositionInfoSource::SimulationIndex).toBool(), false);
+    source.setDevice(&log);
+    QVERIFY(source.seek(dt.addSecs(5)));
+    QVERIFY(!QFile::exists(sidecarFileName));
+
+    // nor before the first seek
+    QFile otherLog(logFileName);
+    QNmeaPositionInfoSource indexing(QNmeaPositionInfoSource::SimulationMode);
+    QVERIFY(indexing.setBackendProperty(QNmeaPositionInfoSource::SimulationIndex, true));
+    QCOMPARE(indexing.backendProperty(QNmeaPositionInfoSource::SimulationIndex).toBool(), true);
+    indexing.setDevice(&otherLog);
+    QVERIFY(!QFile::exists(sidecarFileName));
+    QVERIFY(indexing.seek(dt.addSecs(5)));
+    QVERIFY(QFile::exists(sidecarFileName));
+
+    QNmeaLogIndex index;
+    QVERIFY(index.load(logFileName));
+    QCOMPARE(index.entries().size(), 11);
+
+    QNmeaPositionInfoSource realTimeSource(QNmeaPositionInfoSource::RealTimeMode);
+    QVERIFY(!realTimeSource.setBackendProperty(QNmeaPositionInfoSource::SimulationIndex, true));
+}
+
 #include "tst_qnmeapositioninfosource_simulation.moc"
 
 QTEST_GUILESS_MAIN(tst_QNmeaPositionInfoSource_Simulation);
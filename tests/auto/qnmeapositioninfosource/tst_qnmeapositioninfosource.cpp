@@ -6,6 +6,8 @@
 
 #include "tst_qnmeapositioninfosource.h"
 
+#include <QtPositioning/private/qnmeaepochmerger_p.h>
+
 #include <QtCore/QDateTime>
 #include <QtCore/QElapsedTimer>
 #include <QtCore/QtNumeric>
@@ -77,6 +79,36 @@ void tst_QNmeaPositionInfoSource::userEquivalentRangeError()
     QVERIFY(qFuzzyCompare(source.userEquivalentRangeError(), 5.1));
 }
 
+void tst_QNmeaPositionInfoSource::keepSentences()
+{
+    const QString &name = QNmeaPositionInfoSource::KeepSentences;
+
+    QNmeaPositionInfoSource source(m_mode);
+    QNmeaProxyFactory factory;
+    QNmeaPositionInfoSourceProxy *proxy = static_cast<QNmeaPositionInfoSourceProxy *>(
+            factory.createPositionInfoSourceProxy(&source));
+
+    QVERIFY(source.setBackendProperty(name, false));
+    QCOMPARE(source.backendProperty(name), QVariant(false));
+    QVERIFY(source.setBackendProperty(name, true));
+    QCOMPARE(source.backendProperty(name), QVariant(true));
+
+    QList<QGeoPositionInfo> updates;
+    connect(proxy->source(), &QGeoPositionInfoSource::positionUpdated, this,
+            [&updates](const QGeoPositionInfo &update) { updates.append(update); });
+    proxy->source()->startUpdates();
+
+    const QList<QDateTime> dateTimes = createDateTimes(3);
+    for (const QDateTime &dt : dateTimes)
+        proxy->feedUpdate(dt);
+    QTRY_COMPARE(updates.size(), dateTimes.size());
+    for (const QGeoPositionInfo &update : std::as_const(updates)) {
+        const QList<QByteArrayView> sentences = QNmeaEpochMerger::keptSentences(update);
+        QCOMPARE(sentences.size(), 1);
+        QVERIFY(sentences.constFirst().startsWith("$GPRMC"));
+    }
+}
+
 void tst_QNmeaPositionInfoSource::setUpdateInterval_delayedUpdate()
 {
     // If an update interval is set, and an update is not available at a
@@ -63,6 +63,8 @@ private slots:
 
     void userEquivalentRangeError();
 
+    void keepSentences();
+
     void setUpdateInterval_delayedUpdate();
 
     void lastKnownPosition();
@@ -1,8 +1,10 @@
 // Copyright (C) 2021 The Qt Company Ltd.
 // SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
 
+#include <QBuffer>
 #include <QTest>
 #include <QTimer>
+#include <QTimeZone>
 #include <QSignalSpy>
 #include <QtPositioning/QNmeaSatelliteInfoSource>
 #include "../../utils/qlocationtestutils_p.h"
@@ -82,6 +84,8 @@ private slots:
     void parseDataStream();
     void parseDataStream_data();
 
+    void seek();
+
 private:
     QGeoSatelliteInfo createSatelliteInfo(QGeoSatelliteInfo::SatelliteSystem system, int id,
                                           int snr);
@@ -513,6 +517,50 @@ void tst_QNmeaSatelliteInfoSource::parseDataStream_data()
             << complexGpsGlnsBduInView << complexGpsGlnsBduInUse;
 }
 
+void tst_QNmeaSatelliteInfoSource::seek()
+{
+    // The satellites of the second epoch are found by the time of its RMC
+    const QDateTime dt(QDate(2024, 5, 17), QTime(7, 0), QTimeZone::UTC);
+    QByteArray log;
+    log += QLocationTestUtils::createRmcSentence(dt).toLatin1();
+    log += QLocationTestUtils::addNmeaChecksumAndBreaks(
+                   "$GPGSV,1,1,4,05,,,25,07,,,,08,,,,13,,,36*").toLatin1();
+    log += QLocationTestUtils::addNmeaChecksumAndBreaks(
+                   "$GPGSA,A,3,05,13,,,,,,,,,,,50.95,50.94,1.00*").toLatin1();
+    log += QLocationTestUtils::createRmcSentence(dt.addSecs(1)).toLatin1();
+    log += QLocationTestUtils::addNmeaChecksumAndBreaks(
+                   "$GLGSV,1,1,4,65,,,,66,,,,71,,,20,72,,,28*").toLatin1();
+    log += QLocationTestUtils::addNmeaChecksumAndBreaks(
+                   "$GNGSA,A,3,71,72,,,,,,,,,,,50.95,50.94,1.00*").toLatin1();
+    QBuffer buffer(&log);
+
+    QNmeaSatelliteInfoSource source(QNmeaSatelliteInfoSource::UpdateMode::SimulationMode);
+    QSignalSpy inViewSpy(&source, &QNmeaSatelliteInfoSource::satellitesInViewUpdated);
+    QSignalSpy inUseSpy(&source, &QNmeaSatelliteInfoSource::satellitesInUseUpdated);
+    source.setDevice(&buffer);
+
+    QVERIFY(source.seek(dt.addMSecs(500)));
+    source.startUpdates();
+    QTRY_VERIFY(!inViewSpy.isEmpty() && !inUseSpy.isEmpty());
+
+    const auto inView = inViewSpy.first().at(0).value<QList<QGeoSatelliteInfo>>();
+    QCOMPARE(inView, (QList<QGeoSatelliteInfo> {
+                             createSatelliteInfo(QGeoSatelliteInfo::GLONASS, 65, -1),
+                             createSatelliteInfo(QGeoSatelliteInfo::GLONASS, 66, -1),
+                             createSatelliteInfo(QGeoSatelliteInfo::GLONASS, 71, 20),
+                             createSatelliteInfo(QGeoSatelliteInfo::GLONASS, 72, 28) }));
+    const auto inUse = inUseSpy.first().at(0).value<QList<QGeoSatelliteInfo>>();
+    QCOMPARE(inUse, (QList<QGeoSatelliteInfo> {
+                            createSatelliteInfo(QGeoSatelliteInfo::GLONASS, 71, 20),
+                            createSatelliteInfo(QGeoSatelliteInfo::GLONASS, 72, 28) }));
+
+    QVERIFY(!source.seek(dt.addSecs(2)));
+
+    QNmeaSatelliteInfoSource realTimeSource(QNmeaSatelliteInfoSource::UpdateMode::RealTimeMode);
+    realTimeSource.setDevice(&buffer);
+    QVERIFY(!realTimeSource.seek(dt));
+}
+
 QGeoSatelliteInfo
 tst_QNmeaSatelliteInfoSource::createSatelliteInfo(QGeoSatelliteInfo::SatelliteSystem system, int id,
                                                   int snr)
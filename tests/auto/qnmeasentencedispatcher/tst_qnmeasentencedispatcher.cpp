@@ -0,0 +1,152 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include "../utils/qlocationtestutils_p.h"
+
+#include <QtPositioning/QNmeaPositionInfoSource>
+#include <QtPositioning/QNmeaSatelliteInfoSource>
+#include <QtPositioning/private/qnmeasentencedispatcher_p.h>
+
+#include <QSignalSpy>
+#include <QTest>
+
+QT_USE_NAMESPACE
+
+// A sequential device standing in for a serial port
+class FeedDevice : public QIODevice
+{
+    Q_OBJECT
+public:
+    FeedDevice() { open(ReadOnly); }
+
+    bool isSequential() const override { return true; }
+    qint64 bytesAvailable() const override
+    {
+        return m_data.size() + QIODevice::bytesAvailable();
+    }
+
+    void feed(const QString &data)
+    {
+        m_data += data.toLatin1();
+        emit readyRead();
+    }
+
+protected:
+    qint64 readData(char *data, qint64 maxlen) override
+    {
+        const qint64 size = qMin(maxlen, qint64(m_data.size()));
+        memcpy(data, m_data.constData(), size);
+        m_data.remove(0, size);
+        return size;
+    }
+    qint64 writeData(const char *, qint64) override { return -1; }
+
+private:
+    QByteArray m_data;
+};
+
+class tst_QNmeaSentenceDispatcher : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void sharedStream();
+    void routing();
+    void simulationModeRejected();
+};
+
+void tst_QNmeaSentenceDispatcher::sharedStream()
+{
+    FeedDevice device;
+    QNmeaSentenceDispatcher dispatcher(&device);
+    QNmeaPositionInfoSource positionSource(QNmeaPositionInfoSource::RealTimeMode);
+    QNmeaSatelliteInfoSource satelliteSource(QNmeaSatelliteInfoSource::UpdateMode::RealTimeMode);
+    QVERIFY(dispatcher.addSource(&positionSource));
+    QVERIFY(dispatcher.addSource(&satelliteSource));
+    QCOMPARE(positionSource.device(), &device);
+    QCOMPARE(satelliteSource.device(), &device);
+
+    QSignalSpy positionSpy(&positionSource, &QGeoPositionInfoSource::positionUpdated);
+    QSignalSpy inViewSpy(&satelliteSource, &QGeoSatelliteInfoSource::satellitesInViewUpdated);
+    QSignalSpy inUseSpy(&satelliteSource, &QGeoSatelliteInfoSource::satellitesInUseUpdated);
+    positionSource.startUpdates();
+    satelliteSource.startUpdates();
+
+    const QDateTime dt = QDateTime::currentDateTimeUtc();
+    device.feed(QLocationTestUtils::createRmcSentence(dt)
+                + QLocationTestUtils::createGgaSentence(dt.time())
+                + QLocationTestUtils::createGsaLongSentence()
+                + QLocationTestUtils::createGsvLongSentence());
+    // read once, by the dispatcher
+    QCOMPARE(device.bytesAvailable(), 0);
+
+    QTRY_COMPARE(positionSpy.size(), 1);
+    const QGeoPositionInfo info = positionSpy.at(0).at(0).value<QGeoPositionInfo>();
+    QVERIFY(info.coordinate().isValid());
+    QCOMPARE(info.timestamp().time(), dt.time());
+
+    QTRY_COMPARE(inViewSpy.size(), 1);
+    QCOMPARE(inViewSpy.at(0).at(0).value<QList<QGeoSatelliteInfo>>().size(), 4);
+    QTRY_COMPARE(inUseSpy.size(), 1);
+    QCOMPARE(inUseSpy.at(0).at(0).value<QList<QGeoSatelliteInfo>>().size(), 2);
+}
+
+void tst_QNmeaSentenceDispatcher::routing()
+{
+    FeedDevice device;
+    QNmeaSentenceDispatcher dispatcher(&device);
+    QNmeaPositionInfoSource positionSource(QNmeaPositionInfoSource::RealTimeMode);
+    QNmeaSatelliteInfoSource satelliteSource(QNmeaSatelliteInfoSource::UpdateMode::RealTimeMode);
+    dispatcher.addSource(&positionSource);
+    dispatcher.addSource(&satelliteSource);
+
+    QSignalSpy positionSpy(&positionSource, &QGeoPositionInfoSource::positionUpdated);
+    QSignalSpy inViewSpy(&satelliteSource, &QGeoSatelliteInfoSource::satellitesInViewUpdated);
+    positionSource.startUpdates();
+    satelliteSource.startUpdates();
+
+    // position sentences do not reach the satellite source
+    const QDateTime dt = QDateTime::currentDateTimeUtc();
+    device.feed(QLocationTestUtils::createRmcSentence(dt));
+    device.feed(QLocationTestUtils::createRmcSentence(dt.addSecs(1)));
+    QTRY_VERIFY(!positionSpy.isEmpty());
+    QVERIFY(inViewSpy.isEmpty());
+
+    // and satellite sentences do not reach the position source
+    positionSpy.clear();
+    device.feed(QLocationTestUtils::createGsvLongSentence());
+    QTRY_COMPARE(inViewSpy.size(), 1);
+    QTest::qWait(100);
+    QVERIFY(positionSpy.isEmpty());
+
+    // a deleted source is dropped
+    {
+        QNmeaPositionInfoSource other(QNmeaPositionInfoSource::RealTimeMode);
+        dispatcher.addSource(&other);
+        other.startUpdates();
+    }
+    device.feed(QLocationTestUtils::createRmcSentence(dt.addSecs(2)));
+    QTRY_VERIFY(!positionSpy.isEmpty());
+}
+
+void tst_QNmeaSentenceDispatcher::simulationModeRejected()
+{
+    FeedDevice device;
+    QNmeaSentenceDispatcher dispatcher(&device);
+    QNmeaPositionInfoSource positionSource(QNmeaPositionInfoSource::SimulationMode);
+    QNmeaSatelliteInfoSource satelliteSource(
+            QNmeaSatelliteInfoSource::UpdateMode::SimulationMode);
+
+    QTest::ignoreMessage(QtWarningMsg,
+                         "QNmeaSentenceDispatcher: only sources in RealTimeMode can be added");
+    QVERIFY(!dispatcher.addSource(&positionSource));
+    QTest::ignoreMessage(QtWarningMsg,
+                         "QNmeaSentenceDispatcher: only sources in RealTimeMode can be added");
+    QVERIFY(!dispatcher.addSource(&satelliteSource));
+    QVERIFY(!positionSource.device());
+    QVERIFY(!satelliteSource.device());
+}
+
+QTEST_GUILESS_MAIN(tst_QNmeaSentenceDispatcher)
+
+#include "tst_qnmeasentencedispatcher.moc"
@@ -0,0 +1,190 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QtPositioning/private/qnmeasentencescanner_p.h>
+#include <QtCore/QList>
+#include <QtCore/QRandomGenerator>
+#include <qtest.h>
+
+QT_USE_NAMESPACE
+
+// The byte by byte checksum validation the vectorized one replaced; both must
+// give exactly the same results.
+static bool referenceHasValidChecksum(QByteArrayView bv)
+{
+    qsizetype asteriskIndex = bv.indexOf('*');
+
+    constexpr qsizetype CSUM_LEN = 2;
+    if (asteriskIndex < 0 || asteriskIndex >= bv.size() - CSUM_LEN)
+        return false;
+
+    int result = 0;
+    for (qsizetype i = 1; i < asteriskIndex; ++i)
+        result ^= bv[i];
+
+    QByteArrayView checkSumBytes = bv.sliced(asteriskIndex + 1, 2);
+    bool ok = false;
+    int checksum = checkSumBytes.toInt(&ok,16);
+    return ok && checksum == result;
+}
+
+static QList<QByteArray> referenceSplit(QByteArrayView data)
+{
+    QList<QByteArray> lines;
+    qsizetype from = 0;
+    for (qsizetype end; (end = data.indexOf('\n', from)) >= 0; from = end + 1)
+        lines.append(data.sliced(from, end + 1 - from).toByteArray());
+    return lines;
+}
+
+class tst_QNmeaSentenceScanner : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void hasValidChecksum_data();
+    void hasValidChecksum();
+    void hasValidChecksumSameAsReference();
+
+    void scanSentences_data();
+    void scanSentences();
+    void addDataInChunks();
+    void dropOverlongPartialSentence();
+};
+
+void tst_QNmeaSentenceScanner::hasValidChecksum_data()
+{
+    QTest::addColumn<QByteArray>("sentence");
+    QTest::addColumn<bool>("valid");
+
+    QTest::newRow("RMC")
+            << QByteArray("$GPRMC,123519.00,A,4807.038,N,01131.000,E,022.4,084.4,230394,003.1,W*44\r\n")
+            << true;
+    QTest::newRow("wrong checksum")
+            << QByteArray("$GPRMC,123519.00,A,4807.038,N,01131.000,E,022.4,084.4,230394,003.1,W*45\r\n")
+            << false;
+    QTest::newRow("lower case hex") << QByteArray("$GPGSA,A,3,,,,,,,,,,,,,3.0,3.5,4.9*3a") << true;
+    QTest::newRow("upper case hex") << QByteArray("$GPGSA,A,3,,,,,,,,,,,,,3.0,3.5,4.9*3A") << true;
+    QTest::newRow("short") << QByteArray("$A*41") << true;
+    QTest::newRow("nothing to sum") << QByteArray("$*00") << true;
+    QTest::newRow("asterisk first") << QByteArray("*00") << true;
+    QTest::newRow("empty") << QByteArray() << false;
+    QTest::newRow("no asterisk") << QByteArray("$GPGSA,A,3,,,,,,,,,,,,,3.0,3.5,4.0\r\n") << false;
+    QTest::newRow("one digit") << QByteArray("$A*4") << false;
+    QTest::newRow("not hex") << QByteArray("$A*4g") << false;
+    QTest::newRow("second asterisk") << QByteArray("$A*41*00") << true;
+}
+
+void tst_QNmeaSentenceScanner::hasValidChecksum()
+{
+    QFETCH(QByteArray, sentence);
+    QFETCH(bool, valid);
+
+    QCOMPARE(QNmeaSentenceScanner::hasValidChecksum(sentence), valid);
+    QCOMPARE(referenceHasValidChecksum(sentence), valid);
+}
+
+void tst_QNmeaSentenceScanner::hasValidChecksumSameAsReference()
+{
+    // Covers the '*' in every position of the vector blocks, the scalar tail,
+    // and bytes >= 0x80 XORed as char.
+    QRandomGenerator random(42);
+    for (qsizetype size = 0; size < 100; ++size) {
+        for (qsizetype asterisk = -1; asterisk < size; ++asterisk) {
+            for (int highBytes = 0; highBytes < 3; ++highBytes) {
+                QByteArray sentence(size, Qt::Uninitialized);
+                for (char &c : sentence)
+                    c = char('0' + random.bounded(43)); // never '*'
+                for (int i = 0; i < highBytes && size > 0; ++i)
+                    sentence[random.bounded(size)] = char(0x80 + random.bounded(0x80));
+                if (asterisk >= 0)
+                    sentence[asterisk] = '*';
+
+                QCOMPARE(QNmeaSentenceScanner::hasValidChecksum(sentence),
+                         referenceHasValidChecksum(sentence));
+
+                // and with the correct checksum
+                if (asterisk >= 0 && asterisk + 2 < size) {
+                    uchar sum = 0;
+                    for (qsizetype i = 1; i < asterisk; ++i)
+                        sum ^= uchar(sentence.at(i));
+                    const QByteArray hex = QByteArray::number(sum, 16).rightJustified(2, '0');
+                    sentence[asterisk + 1] = hex.at(0);
+                    sentence[asterisk + 2] = hex.at(1);
+                    QCOMPARE(QNmeaSentenceScanner::hasValidChecksum(sentence),
+                             referenceHasValidChecksum(sentence));
+                }
+            }
+        }
+    }
+}
+
+void tst_QNmeaSentenceScanner::scanSentences_data()
+{
+    QTest::addColumn<QByteArray>("data");
+
+    QTest::newRow("empty") << QByteArray();
+    QTest::newRow("no line break") << QByteArray("$GPGSA,A,3,,,,,,,,,,,,,3.0,3.5,4.0*3a");
+    QTest::newRow("one") << QByteArray("$GPGSA,A,3,,,,,,,,,,,,,3.0,3.5,4.0*3a\r\n");
+    QTest::newRow("empty lines") << QByteArray("\n\n\r\n\n");
+    QTest::newRow("partial") << QByteArray("$A*41\r\n$B*42\n$GPGSA,A,3,,,,,,,");
+
+    QByteArray mixed;
+    for (int i = 0; i < 300; ++i)
+        mixed += QByteArray(i % 97, char('A' + i % 26)) + (i % 3 ? "\r\n" : "\n");
+    mixed += "tail";
+    QTest::newRow("mixed") << mixed;
+}
+
+void tst_QNmeaSentenceScanner::scanSentences()
+{
+    QFETCH(QByteArray, data);
+
+    const QList<QByteArray> expected = referenceSplit(data);
+
+    QList<QByteArray> sentences;
+    const qsizetype consumed = QNmeaSentenceScanner::scanSentences(data,
+            [&](QByteArrayView sentence) { sentences.append(sentence.toByteArray()); });
+    QCOMPARE(sentences, expected);
+    QCOMPARE(consumed, data.lastIndexOf('\n') + 1);
+}
+
+void tst_QNmeaSentenceScanner::addDataInChunks()
+{
+    QByteArray data;
+    for (int i = 0; i < 200; ++i)
+        data += "$GPGGA," + QByteArray::number(i) + ",2734.76859,S,15305.99361,E,1,04,3.5*00\r\n";
+    const QList<QByteArray> expected = referenceSplit(data);
+
+    for (qsizetype chunkSize : { 1, 2, 7, 16, 31, 32, 33, 100, 4096 }) {
+        QNmeaSentenceScanner scanner;
+        QList<QByteArray> sentences;
+        for (qsizetype i = 0; i < data.size(); i += chunkSize) {
+            scanner.addData(QByteArrayView(data).sliced(i, qMin(chunkSize, data.size() - i)),
+                            [&](QByteArrayView s) { sentences.append(s.toByteArray()); });
+        }
+        QCOMPARE(sentences, expected);
+        QVERIFY(!scanner.hasPartialSentence());
+    }
+}
+
+void tst_QNmeaSentenceScanner::dropOverlongPartialSentence()
+{
+    QNmeaSentenceScanner scanner;
+    QList<QByteArray> sentences;
+    const auto append = [&](QByteArrayView s) { sentences.append(s.toByteArray()); };
+
+    const QByteArray garbage(QNmeaSentenceScanner::MaxPartialSentenceLength / 2 + 1, 'x');
+    scanner.addData(garbage, append);
+    QVERIFY(scanner.hasPartialSentence());
+    scanner.addData(garbage, append);
+    QVERIFY(!scanner.hasPartialSentence());
+    QVERIFY(sentences.isEmpty());
+
+    scanner.addData("end of garbage\r\n$A*41\r\n", append);
+    QCOMPARE(sentences, QList<QByteArray>({ "end of garbage\r\n", "$A*41\r\n" }));
+}
+
+QTEST_APPLESS_MAIN(tst_QNmeaSentenceScanner)
+
+#include "tst_qnmeasentencescanner.moc"
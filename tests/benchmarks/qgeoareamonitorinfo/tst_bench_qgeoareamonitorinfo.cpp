@@ -2,9 +2,14 @@
 // SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
 
 #include <QtPositioning/QGeoAreaMonitorInfo>
+#include <QtPositioning/QGeoAreaMonitorSource>
 #include <QtPositioning/QGeoCircle>
+#include <QtPositioning/QGeoPositionInfoSource>
+#include <QRandomGenerator>
 #include <QTest>
 
+#include <memory>
+
 static const QDateTime expirationTime = QDateTime::currentDateTimeUtc().addSecs(60);
 static const QGeoCircle area = QGeoCircle(QGeoCoordinate(1.0, 1.0), 100);
 
@@ -38,6 +43,39 @@ private slots:
 
     void setNotificationParameters();
     void queryNotificationParameters();
+
+    void pollingPositionUpdate_data();
+    void pollingPositionUpdate();
+};
+
+// Passes the positions it is given on to the area monitor
+class BenchmarkPositionSource : public QGeoPositionInfoSource
+{
+    Q_OBJECT
+public:
+    BenchmarkPositionSource() : QGeoPositionInfoSource(nullptr) {}
+
+    void pushPosition(const QGeoPositionInfo &info)
+    {
+        lastPosition = info;
+        emit positionUpdated(info);
+    }
+
+    QGeoPositionInfo lastKnownPosition(bool) const override { return lastPosition; }
+    PositioningMethods supportedPositioningMethods() const override
+    {
+        return AllPositioningMethods;
+    }
+    int minimumUpdateInterval() const override { return 0; }
+    Error error() const override { return NoError; }
+
+public slots:
+    void startUpdates() override {}
+    void stopUpdates() override {}
+    void requestUpdate(int) override {}
+
+private:
+    QGeoPositionInfo lastPosition;
 };
 
 
@@ -225,6 +263,68 @@ void tst_QGeoAreaMonitorInfoBenchmark::queryNotificationParameters()
     }
 }
 
+void tst_QGeoAreaMonitorInfoBenchmark::pollingPositionUpdate_data()
+{
+    QTest::addColumn<int>("monitorCount");
+
+    QTest::newRow("10") << 10;
+    QTest::newRow("100") << 100;
+    QTest::newRow("1000") << 1000;
+    QTest::newRow("10000") << 10000;
+    QTest::newRow("100000") << 100000;
+}
+
+void tst_QGeoAreaMonitorInfoBenchmark::pollingPositionUpdate()
+{
+    QFETCH(int, monitorCount);
+
+    std::unique_ptr<QGeoAreaMonitorSource> monitor(
+            QGeoAreaMonitorSource::createSource(QStringLiteral("positionpoll"), nullptr));
+    if (!monitor)
+        QSKIP("The positionpoll plugin is not available");
+
+    auto *source = new BenchmarkPositionSource;
+    monitor->setPositionInfoSource(source);
+
+    int events = 0;
+    const auto countEvent = [&events] { ++events; };
+    QObject::connect(monitor.get(), &QGeoAreaMonitorSource::areaEntered, countEvent);
+    QObject::connect(monitor.get(), &QGeoAreaMonitorSource::areaExited, countEvent);
+
+    // Circles of 200 m spread over one square degree, and a walk through them
+    QRandomGenerator random(42);
+    const auto randomCoordinate = [&random] {
+        return QGeoCoordinate(52.0 + random.generateDouble(), 13.0 + random.generateDouble());
+    };
+
+    QList<QGeoAreaMonitorInfo> monitors;
+    monitors.reserve(monitorCount);
+    for (int i = 0; i < monitorCount; ++i) {
+        QGeoAreaMonitorInfo info(QString::number(i));
+        info.setArea(QGeoCircle(randomCoordinate(), 200));
+        QVERIFY(monitor->startMonitoring(info));
+        monitors.append(info);
+    }
+
+    QList<QGeoPositionInfo> positions;
+    QGeoCoordinate coordinate = randomCoordinate();
+    for (int i = 0; i < 1000; ++i) {
+        coordinate = coordinate.atDistanceAndAzimuth(50, random.bounded(360.0));
+        positions.append(QGeoPositionInfo(coordinate, QDateTime::currentDateTimeUtc()));
+    }
+
+    qsizetype i = 0;
+    QBENCHMARK {
+        source->pushPosition(positions.at(i));
+        i = (i + 1) % positions.size();
+    }
+    Q_UNUSED(events)
+
+    // the monitors are shared by all positionpoll monitor sources
+    for (const QGeoAreaMonitorInfo &info : std::as_const(monitors))
+        monitor->stopMonitoring(info);
+}
+
 QTEST_MAIN(tst_QGeoAreaMonitorInfoBenchmark)
 
 #include "tst_bench_qgeoareamonitorinfo.moc"
@@ -0,0 +1,158 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QtPositioning/QGeoCoordinate>
+#include <QTest>
+
+#include <cmath>
+
+class tst_QGeoCoordinateBenchmark : public QObject
+{
+    Q_OBJECT
+private slots:
+    void distanceTo_data();
+    void distanceTo();
+    void distancesTo_data();
+    void distancesTo();
+    void azimuthTo_data();
+    void azimuthTo();
+    void azimuthsTo_data();
+    void azimuthsTo();
+    void trackLength_data();
+    void trackLength();
+    void consecutiveDistances_data();
+    void consecutiveDistances();
+};
+
+// Vehicles spread over a city, or the points of a track through it
+static QList<QGeoCoordinate> createCoordinates(int count)
+{
+    QList<QGeoCoordinate> coordinates;
+    coordinates.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        coordinates.append(QGeoCoordinate(52.5 + 0.1 * std::sin(i * 0.01),
+                                          13.4 + 0.1 * std::cos(i * 0.013)));
+    }
+    return coordinates;
+}
+
+static void addCountRows()
+{
+    QTest::addColumn<int>("count");
+
+    QTest::newRow("16") << 16;
+    QTest::newRow("1000") << 1000;
+    QTest::newRow("100000") << 100000;
+}
+
+static const QGeoCoordinate origin(52.52, 13.405);
+
+void tst_QGeoCoordinateBenchmark::distanceTo_data()
+{
+    addCountRows();
+}
+
+void tst_QGeoCoordinateBenchmark::distanceTo()
+{
+    QFETCH(int, count);
+    const QList<QGeoCoordinate> coordinates = createCoordinates(count);
+    QList<qreal> distances(count);
+
+    QBENCHMARK {
+        for (int i = 0; i < count; ++i)
+            distances[i] = origin.distanceTo(coordinates.at(i));
+    }
+}
+
+void tst_QGeoCoordinateBenchmark::distancesTo_data()
+{
+    addCountRows();
+}
+
+void tst_QGeoCoordinateBenchmark::distancesTo()
+{
+    QFETCH(int, count);
+    const QList<QGeoCoordinate> coordinates = createCoordinates(count);
+    QList<qreal> distances(count);
+
+    QBENCHMARK {
+        origin.distancesTo(coordinates, distances);
+    }
+}
+
+void tst_QGeoCoordinateBenchmark::azimuthTo_data()
+{
+    addCountRows();
+}
+
+void tst_QGeoCoordinateBenchmark::azimuthTo()
+{
+    QFETCH(int, count);
+    const QList<QGeoCoordinate> coordinates = createCoordinates(count);
+    QList<qreal> azimuths(count);
+
+    QBENCHMARK {
+        for (int i = 0; i < count; ++i)
+            azimuths[i] = origin.azimuthTo(coordinates.at(i));
+    }
+}
+
+void tst_QGeoCoordinateBenchmark::azimuthsTo_data()
+{
+    addCountRows();
+}
+
+void tst_QGeoCoordinateBenchmark::azimuthsTo()
+{
+    QFETCH(int, count);
+    const QList<QGeoCoordinate> coordinates = createCoordinates(count);
+    QList<qreal> azimuths(count);
+
+    QBENCHMARK {
+        origin.azimuthsTo(coordinates, azimuths);
+    }
+}
+
+void tst_QGeoCoordinateBenchmark::trackLength_data()
+{
+    addCountRows();
+}
+
+void tst_QGeoCoordinateBenchmark::trackLength()
+{
+    QFETCH(int, count);
+    const QList<QGeoCoordinate> track = createCoordinates(count);
+
+    qreal length = 0;
+    QBENCHMARK {
+        length = 0;
+        for (int i = 0; i + 1 < count; ++i)
+            length += track.at(i).distanceTo(track.at(i + 1));
+    }
+    QVERIFY(length > 0);
+}
+
+void tst_QGeoCoordinateBenchmark::consecutiveDistances_data()
+{
+    addCountRows();
+}
+
+void tst_QGeoCoordinateBenchmark::consecutiveDistances()
+{
+    QFETCH(int, count);
+    const QList<QGeoCoordinate> track = createCoordinates(count);
+    QList<qreal> distances(count - 1);
+
+    qreal length = 0;
+    QBENCHMARK {
+        QGeoCoordinate::consecutiveDistances(track, distances);
+        length = 0;
+        for (qreal distance : std::as_const(distances))
+            length += distance;
+    }
+    QVERIFY(length > 0);
+}
+
+QTEST_MAIN(tst_QGeoCoordinateBenchmark)
+
+#include "tst_bench_qgeocoordinate.moc"
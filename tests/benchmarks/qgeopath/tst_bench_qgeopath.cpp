@@ -0,0 +1,218 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QtPositioning/QGeoCoordinate>
+#include <QtPositioning/QGeoPath>
+#include <QTest>
+
+#include <cmath>
+
+class tst_QGeoPathBenchmark : public QObject
+{
+    Q_OBJECT
+private slots:
+    void containsLongPath_data();
+    void containsLongPath();
+    void nearestCoordinateLongPath_data();
+    void nearestCoordinateLongPath();
+    void remainingLength_data();
+    void remainingLength();
+    void lengthWhileRecording_data();
+    void lengthWhileRecording();
+    void simplified_data();
+    void simplified();
+    void simplifiedZigzag_data();
+    void simplifiedZigzag();
+    void addCoordinateSimplified_data();
+    void addCoordinateSimplified();
+    void boundingGeoRectangleWhileRecording_data();
+    void boundingGeoRectangleWhileRecording();
+};
+
+// A winding route of about 1 km per 100 vertices
+static QGeoPath createRoute(int vertexCount, qreal width)
+{
+    QList<QGeoCoordinate> route;
+    route.reserve(vertexCount);
+    for (int i = 0; i < vertexCount; ++i) {
+        route.append(QGeoCoordinate(48.0 + 0.02 * std::sin(i * 0.001),
+                                    11.0 + 0.0001 * i + 0.0005 * std::sin(i * 0.1)));
+    }
+    return QGeoPath(route, width);
+}
+
+void tst_QGeoPathBenchmark::containsLongPath_data()
+{
+    QTest::addColumn<int>("vertexCount");
+
+    QTest::newRow("100") << 100;
+    QTest::newRow("1000") << 1000;
+    QTest::newRow("10000") << 10000;
+    QTest::newRow("100000") << 100000;
+}
+
+void tst_QGeoPathBenchmark::containsLongPath()
+{
+    QFETCH(int, vertexCount);
+
+    // a vehicle on the road near the end, and one off the route
+    const QGeoPath route = createRoute(vertexCount, 30.0);
+    const QGeoCoordinate onRoute = route.path().at(vertexCount - 2);
+    const QGeoCoordinate offRoute(47.9, 11.0);
+    QVERIFY(route.contains(onRoute));
+    QVERIFY(!route.contains(offRoute));
+
+    QBENCHMARK {
+        const bool on = route.contains(onRoute);
+        const bool off = route.contains(offRoute);
+        Q_UNUSED(on)
+        Q_UNUSED(off)
+    }
+}
+
+void tst_QGeoPathBenchmark::nearestCoordinateLongPath_data()
+{
+    containsLongPath_data();
+}
+
+void tst_QGeoPathBenchmark::nearestCoordinateLongPath()
+{
+    QFETCH(int, vertexCount);
+
+    // a vehicle a little off the road near the end
+    const QGeoPath route = createRoute(vertexCount, 0.0);
+    const QGeoCoordinate vehicle =
+            route.path().at(vertexCount - 2).atDistanceAndAzimuth(20.0, 0.0);
+    qsizetype segment = -1;
+    route.nearestCoordinate(vehicle, &segment);
+    QVERIFY(segment >= vertexCount - 4);
+
+    QBENCHMARK {
+        double along = 0.0;
+        const QGeoCoordinate nearest = route.nearestCoordinate(vehicle, &segment, &along);
+        Q_UNUSED(nearest)
+    }
+}
+
+void tst_QGeoPathBenchmark::remainingLength_data()
+{
+    containsLongPath_data();
+}
+
+void tst_QGeoPathBenchmark::remainingLength()
+{
+    QFETCH(int, vertexCount);
+
+    // the distance left to drive, as a navigation view shows it every frame
+    const QGeoPath route = createRoute(vertexCount, 0.0);
+    qsizetype position = 0;
+    QBENCHMARK {
+        const double remaining = route.length(position, vertexCount - 1);
+        Q_UNUSED(remaining)
+        position = (position + 1) % vertexCount;
+    }
+}
+
+void tst_QGeoPathBenchmark::lengthWhileRecording_data()
+{
+    containsLongPath_data();
+}
+
+void tst_QGeoPathBenchmark::lengthWhileRecording()
+{
+    QFETCH(int, vertexCount);
+
+    // a track being recorded, with its length shown after each new position
+    QGeoPath track = createRoute(vertexCount, 0.0);
+    const QGeoCoordinate position = track.path().last();
+    track.length();
+    QBENCHMARK {
+        track.addCoordinate(position);
+        const double length = track.length(0, track.size() - 1);
+        Q_UNUSED(length)
+    }
+}
+
+void tst_QGeoPathBenchmark::simplified_data()
+{
+    containsLongPath_data();
+}
+
+void tst_QGeoPathBenchmark::simplified()
+{
+    QFETCH(int, vertexCount);
+
+    const QGeoPath route = createRoute(vertexCount, 0.0);
+    QVERIFY(route.simplified(5.0).size() < vertexCount);
+
+    QBENCHMARK {
+        const QGeoPath simplified = route.simplified(5.0);
+        Q_UNUSED(simplified)
+    }
+}
+
+void tst_QGeoPathBenchmark::simplifiedZigzag_data()
+{
+    containsLongPath_data();
+}
+
+void tst_QGeoPathBenchmark::simplifiedZigzag()
+{
+    QFETCH(int, vertexCount);
+
+    // A zig-zag growing wider, whose farthest vertex from every segment is
+    // next to its end, so that each split only takes a vertex off a range.
+    QList<QGeoCoordinate> zigzag;
+    zigzag.reserve(vertexCount);
+    for (int i = 0; i < vertexCount; ++i)
+        zigzag.append(QGeoCoordinate(48.0 + (i % 2 ? 1e-7 : -1e-7) * i, 11.0 + 0.0001 * i));
+    const QGeoPath track(zigzag);
+    QVERIFY(track.simplified(5.0).size() < vertexCount);
+
+    QBENCHMARK {
+        const QGeoPath simplified = track.simplified(5.0);
+        Q_UNUSED(simplified)
+    }
+}
+
+void tst_QGeoPathBenchmark::addCoordinateSimplified_data()
+{
+    containsLongPath_data();
+}
+
+void tst_QGeoPathBenchmark::addCoordinateSimplified()
+{
+    QFETCH(int, vertexCount);
+
+    // recording a track, simplified as it is recorded
+    const QList<QGeoCoordinate> positions = createRoute(vertexCount, 0.0).path();
+    QBENCHMARK {
+        QGeoPath track;
+        for (const QGeoCoordinate &position : positions)
+            track.addCoordinateSimplified(position, 5.0);
+    }
+}
+
+void tst_QGeoPathBenchmark::boundingGeoRectangleWhileRecording_data()
+{
+    containsLongPath_data();
+}
+
+void tst_QGeoPathBenchmark::boundingGeoRectangleWhileRecording()
+{
+    QFETCH(int, vertexCount);
+
+    // a track being recorded, with the map following its bounds
+    QGeoPath track = createRoute(vertexCount, 0.0);
+    const QGeoCoordinate position = track.path().last();
+    track.boundingGeoRectangle();
+    QBENCHMARK {
+        track.addCoordinate(position);
+        const QGeoCoordinate center = track.center();
+        Q_UNUSED(center)
+    }
+}
+
+QTEST_MAIN(tst_QGeoPathBenchmark)
+
+#include "tst_bench_qgeopath.moc"
@@ -0,0 +1,108 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QtPositioning/QGeoCoordinate>
+#include <QtPositioning/QGeoPolygon>
+#include <QTest>
+
+#include <cmath>
+
+class tst_QGeoPolygonBenchmark : public QObject
+{
+    Q_OBJECT
+private slots:
+    void contains_data();
+    void contains();
+    void containsLargePerimeter_data();
+    void containsLargePerimeter();
+};
+
+// A square campus of about 1 km, with holes for the buildings laid out on a grid
+static QGeoPolygon createCampus(int holeCount)
+{
+    constexpr double south = 52.5;
+    constexpr double west = 13.4;
+    constexpr double size = 0.01;
+    QGeoPolygon campus({ QGeoCoordinate(south, west), QGeoCoordinate(south, west + size),
+                         QGeoCoordinate(south + size, west + size),
+                         QGeoCoordinate(south + size, west) });
+
+    const int columns = int(std::ceil(std::sqrt(double(holeCount))));
+    const double cell = size / (columns + 1);
+    for (int i = 0; i < holeCount; ++i) {
+        const double lat = south + cell * (i / columns + 1);
+        const double lon = west + cell * (i % columns + 1);
+        const double half = cell / 4;
+        campus.addHole({ QGeoCoordinate(lat - half, lon - half),
+                         QGeoCoordinate(lat - half, lon + half),
+                         QGeoCoordinate(lat, lon + half * 1.5),
+                         QGeoCoordinate(lat + half, lon + half),
+                         QGeoCoordinate(lat + half, lon - half),
+                         QGeoCoordinate(lat, lon - half * 1.5) });
+    }
+    return campus;
+}
+
+void tst_QGeoPolygonBenchmark::contains_data()
+{
+    QTest::addColumn<int>("holeCount");
+
+    QTest::newRow("0") << 0;
+    QTest::newRow("1") << 1;
+    QTest::newRow("10") << 10;
+    QTest::newRow("50") << 50;
+    QTest::newRow("200") << 200;
+}
+
+void tst_QGeoPolygonBenchmark::contains()
+{
+    QFETCH(int, holeCount);
+
+    const QGeoPolygon campus = createCampus(holeCount);
+    // between the buildings, so that every hole has to be checked
+    const QGeoCoordinate probe(52.5 + 0.0001, 13.4 + 0.005);
+    QVERIFY(campus.contains(probe));
+
+    QBENCHMARK {
+        const bool result = campus.contains(probe);
+        Q_UNUSED(result)
+    }
+}
+
+void tst_QGeoPolygonBenchmark::containsLargePerimeter_data()
+{
+    QTest::addColumn<int>("vertexCount");
+
+    QTest::newRow("100") << 100;
+    QTest::newRow("1000") << 1000;
+    QTest::newRow("10000") << 10000;
+    QTest::newRow("100000") << 100000;
+    QTest::newRow("500000") << 500000;
+}
+
+void tst_QGeoPolygonBenchmark::containsLargePerimeter()
+{
+    QFETCH(int, vertexCount);
+
+    // a jagged boundary around a region of about 100 km
+    QList<QGeoCoordinate> boundary;
+    boundary.reserve(vertexCount);
+    for (int i = 0; i < vertexCount; ++i) {
+        const double angle = 2 * M_PI * i / vertexCount;
+        const double radius = i % 2 ? 0.45 : 0.5;
+        boundary.append(QGeoCoordinate(47.0 + radius * std::sin(angle),
+                                       8.0 + radius * std::cos(angle)));
+    }
+    const QGeoPolygon region(boundary);
+    const QGeoCoordinate probe(47.1, 8.2);
+    QVERIFY(region.contains(probe));
+
+    QBENCHMARK {
+        const bool result = region.contains(probe);
+        Q_UNUSED(result)
+    }
+}
+
+QTEST_MAIN(tst_QGeoPolygonBenchmark)
+
+#include "tst_bench_qgeopolygon.moc"
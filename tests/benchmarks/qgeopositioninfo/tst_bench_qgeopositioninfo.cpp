@@ -36,6 +36,11 @@ private slots:
     void removeAttributeNonExisting();
     void hasAttributeExisting();
     void hasAttributeNonExisting();
+
+    void constructWithAttributes();
+    void constructCopyAndDetachWithAttributes();
+    void checkEqualityWithAttributes();
+    void queryAllAttributes();
 };
 
 void tst_QGeoPositionInfoBenchmark::constructDefault()
@@ -223,6 +228,57 @@ void tst_QGeoPositionInfoBenchmark::hasAttributeNonExisting()
     }
 }
 
+void tst_QGeoPositionInfoBenchmark::constructWithAttributes()
+{
+    // What parsing a typical NMEA epoch amounts to
+    QBENCHMARK {
+        QGeoPositionInfo info(coordinate, dateTime);
+        info.setAttribute(QGeoPositionInfo::Direction, 1.0);
+        info.setAttribute(QGeoPositionInfo::GroundSpeed, 2.0);
+        info.setAttribute(QGeoPositionInfo::HorizontalAccuracy, 3.0);
+        info.setAttribute(QGeoPositionInfo::VerticalAccuracy, 4.0);
+        Q_UNUSED(info)
+    }
+}
+
+void tst_QGeoPositionInfoBenchmark::constructCopyAndDetachWithAttributes()
+{
+    const QGeoPositionInfo info = generateInfoWithAttributes();
+    QBENCHMARK {
+        QGeoPositionInfo newInfo(info);
+        newInfo.setAttribute(QGeoPositionInfo::HorizontalAccuracy, 5.0);
+        Q_UNUSED(newInfo)
+    }
+}
+
+void tst_QGeoPositionInfoBenchmark::checkEqualityWithAttributes()
+{
+    QGeoPositionInfo info1 = generateInfoWithAttributes();
+    info1.setCoordinate(coordinate);
+    info1.setTimestamp(dateTime);
+    QGeoPositionInfo info2 = generateInfoWithAttributes();
+    info2.setCoordinate(coordinate);
+    info2.setTimestamp(dateTime);
+    QBENCHMARK {
+        const bool equal = info1 == info2;
+        Q_UNUSED(equal)
+    }
+}
+
+void tst_QGeoPositionInfoBenchmark::queryAllAttributes()
+{
+    const QGeoPositionInfo info = generateInfoWithAttributes();
+    QBENCHMARK {
+        qreal sum = 0;
+        for (int i = QGeoPositionInfo::Direction; i <= QGeoPositionInfo::DirectionAccuracy; ++i) {
+            const auto attribute = static_cast<QGeoPositionInfo::Attribute>(i);
+            if (info.hasAttribute(attribute))
+                sum += info.attribute(attribute);
+        }
+        Q_UNUSED(sum)
+    }
+}
+
 QTEST_MAIN(tst_QGeoPositionInfoBenchmark)
 
 #include "tst_bench_qgeopositioninfo.moc"
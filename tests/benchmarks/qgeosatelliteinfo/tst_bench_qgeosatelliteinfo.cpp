@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
 
 #include <QtPositioning/QGeoSatelliteInfo>
+#include <QtPositioning/private/qlocationutils_p.h>
 #include <QTest>
 
 class tst_QGeoSatelliteInfoBenchmark : public QObject
@@ -33,8 +34,42 @@ private slots:
     void removeAttributeNonExisting();
     void hasAttributeExisting();
     void hasAttributeNonExisting();
+
+    void constructEpoch();
+    void parseEpoch();
 };
 
+// A four constellation receiver reporting ten satellites of each system
+static constexpr int satellitesPerSystem = 10;
+
+static QByteArray gsvSentence(const char *talker, int sentence, int firstSatellite)
+{
+    const int totalSentences = (satellitesPerSystem + 3) / 4;
+    QByteArray nmea = QByteArray("$") + talker + "GSV," + QByteArray::number(totalSentences)
+            + ',' + QByteArray::number(sentence) + ',' + QByteArray::number(satellitesPerSystem);
+    const int count = qMin(4, satellitesPerSystem - (sentence - 1) * 4);
+    for (int i = 0; i < count; ++i) {
+        const int satellite = firstSatellite + (sentence - 1) * 4 + i;
+        nmea += ',' + QByteArray::number(satellite) + ',' + QByteArray::number(10 + i * 15)
+                + ',' + QByteArray::number(satellite * 7 % 360) + ',' + QByteArray::number(30 + i);
+    }
+    uchar checksum = 0;
+    for (qsizetype i = 1; i < nmea.size(); ++i)
+        checksum ^= uchar(nmea.at(i));
+    return nmea + '*' + QByteArray::number(checksum, 16).rightJustified(2, '0').toUpper() + "\r\n";
+}
+
+static QList<QByteArray> gsvEpoch()
+{
+    QList<QByteArray> sentences;
+    const int totalSentences = (satellitesPerSystem + 3) / 4;
+    for (const char *talker : { "GP", "GL", "GA", "GB" }) {
+        for (int i = 1; i <= totalSentences; ++i)
+            sentences.append(gsvSentence(talker, i, 1));
+    }
+    return sentences;
+}
+
 void tst_QGeoSatelliteInfoBenchmark::constructDefault()
 {
     QBENCHMARK {
@@ -218,6 +253,49 @@ void tst_QGeoSatelliteInfoBenchmark::hasAttributeNonExisting()
     }
 }
 
+void tst_QGeoSatelliteInfoBenchmark::constructEpoch()
+{
+    // All satellites of an epoch, built through the public setters
+    static constexpr QGeoSatelliteInfo::SatelliteSystem systems[] = {
+        QGeoSatelliteInfo::GPS, QGeoSatelliteInfo::GLONASS,
+        QGeoSatelliteInfo::GALILEO, QGeoSatelliteInfo::BEIDOU
+    };
+    QBENCHMARK {
+        QList<QGeoSatelliteInfo> infos;
+        for (const auto system : systems) {
+            for (int i = 0; i < satellitesPerSystem; ++i) {
+                QGeoSatelliteInfo info;
+                info.setSatelliteSystem(system);
+                info.setSatelliteIdentifier(i + 1);
+                info.setAttribute(QGeoSatelliteInfo::Elevation, 10 + i);
+                info.setAttribute(QGeoSatelliteInfo::Azimuth, i * 7);
+                info.setSignalStrength(30 + i);
+                infos.append(info);
+            }
+        }
+        Q_UNUSED(infos)
+    }
+}
+
+void tst_QGeoSatelliteInfoBenchmark::parseEpoch()
+{
+    // All satellites of an epoch, parsed from its GSV sentences
+    const QList<QByteArray> sentences = gsvEpoch();
+    qsizetype satellites = 0;
+    QBENCHMARK {
+        satellites = 0;
+        QList<QGeoSatelliteInfo> infos;
+        QGeoSatelliteInfo::SatelliteSystem system;
+        for (const QByteArray &sentence : sentences) {
+            if (QLocationUtils::getSatInfoFromNmea(sentence, infos, system)
+                    == QNmeaSatelliteInfoSource::FullyParsed) {
+                satellites += infos.size();
+            }
+        }
+    }
+    QCOMPARE(satellites, 4 * satellitesPerSystem);
+}
+
 QTEST_MAIN(tst_QGeoSatelliteInfoBenchmark)
 
 #include "tst_bench_qgeosatelliteinfo.moc"
@@ -0,0 +1,101 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include "qiopipe_p.h"
+
+#include <QTest>
+
+// A sequential device standing in for a serial port
+class FeedDevice : public QIODevice
+{
+    Q_OBJECT
+public:
+    FeedDevice() { open(ReadOnly); }
+
+    bool isSequential() const override { return true; }
+    qint64 bytesAvailable() const override
+    {
+        return m_data.size() - m_position + QIODevice::bytesAvailable();
+    }
+
+    void feed(const QByteArray &data)
+    {
+        m_data = data;
+        m_position = 0;
+        emit readyRead();
+    }
+
+protected:
+    qint64 readData(char *data, qint64 maxlen) override
+    {
+        const qint64 size = qMin(maxlen, m_data.size() - m_position);
+        memcpy(data, m_data.constData() + m_position, size);
+        m_position += size;
+        return size;
+    }
+    qint64 writeData(const char *, qint64) override { return -1; }
+
+private:
+    QByteArray m_data;
+    qint64 m_position = 0;
+};
+
+class tst_QIOPipeBenchmark : public QObject
+{
+    Q_OBJECT
+private slots:
+    void fanOut_data();
+    void fanOut();
+};
+
+static QByteArray epoch()
+{
+    return QByteArrayLiteral(
+            "$GPRMC,123519.00,A,4807.038,N,01131.000,E,022.4,084.4,230394,003.1,W*44\r\n"
+            "$GPGGA,123519.00,4807.038,N,01131.000,E,1,08,0.9,545.4,M,46.9,M,,*69\r\n"
+            "$GPGSA,A,3,04,05,,09,12,,,24,,,,,2.5,1.3,2.1*39\r\n"
+            "$GPGSV,3,1,11,03,03,111,00,04,15,270,00,06,01,010,00,13,06,292,00*74\r\n");
+}
+
+void tst_QIOPipeBenchmark::fanOut_data()
+{
+    QTest::addColumn<int>("consumerCount");
+    QTest::newRow("1 consumer") << 1;
+    QTest::newRow("4 consumers") << 4;
+    QTest::newRow("16 consumers") << 16;
+}
+
+// One device shared by several readers, the way the NMEA plugin shares a
+// serial port: every consumer reads all data on readyRead().
+void tst_QIOPipeBenchmark::fanOut()
+{
+    QFETCH(int, consumerCount);
+
+    FeedDevice device;
+    qint64 bytesRead = 0;
+    // the pipes are deleted with the device
+    QIOPipe *proxy = new QIOPipe(&device, QIOPipe::ProxyPipe);
+    for (int i = 0; i < consumerCount; ++i) {
+        QIOPipe *pipe = new QIOPipe(proxy);
+        proxy->addChildPipe(pipe);
+        connect(pipe, &QIODevice::readyRead, this, [pipe, &bytesRead] {
+            char buf[4096];
+            qint64 size;
+            while ((size = pipe->read(buf, sizeof(buf))) > 0)
+                bytesRead += size;
+        });
+    }
+
+    const QByteArray data = epoch();
+    constexpr int EpochCount = 1000;
+    QBENCHMARK {
+        for (int i = 0; i < EpochCount; ++i)
+            device.feed(data);
+    }
+    QVERIFY(bytesRead > 0);
+    QCOMPARE(bytesRead % (qint64(data.size()) * EpochCount * consumerCount), 0);
+}
+
+QTEST_MAIN(tst_QIOPipeBenchmark)
+
+#include "tst_bench_qiopipe.moc"
@@ -0,0 +1,299 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QtPositioning/QGeoPositionInfo>
+#include <QtPositioning/QGeoSatelliteInfo>
+#include <QtPositioning/private/qlocationutils_p.h>
+#include <QtPositioning/private/qnmeabatchdecoder_p.h>
+#include <QtPositioning/private/qnmeasentencescanner_p.h>
+#include <QBuffer>
+#include <QTest>
+
+#include <atomic>
+
+// Sanitizers replace malloc() themselves, also when enabled by compiler flags
+// instead of the Qt configuration.
+#if defined(__SANITIZE_ADDRESS__) || defined(__SANITIZE_THREAD__)
+#  define QT_NMEA_BENCHMARK_SANITIZED
+#elif defined(__has_feature)
+#  if __has_feature(address_sanitizer) || __has_feature(thread_sanitizer) \
+        || __has_feature(memory_sanitizer)
+#    define QT_NMEA_BENCHMARK_SANITIZED
+#  endif
+#endif
+
+#if defined(QT_NMEA_BENCHMARK_COUNT_ALLOCATIONS) && defined(__GLIBC__) \
+        && !defined(QT_NMEA_BENCHMARK_SANITIZED)
+// Count every heap allocation made by the process, including the ones made by
+// the container classes inside QtCore, which do not go through operator new.
+// Only built with the QT_NMEA_BENCHMARK_COUNT_ALLOCATIONS CMake option.
+extern "C" {
+void *__libc_malloc(size_t size);
+void *__libc_calloc(size_t count, size_t size);
+void *__libc_realloc(void *ptr, size_t size);
+}
+
+static std::atomic<quint64> allocationCount{0};
+
+extern "C" void *malloc(size_t size) noexcept
+{
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    return __libc_malloc(size);
+}
+
+extern "C" void *calloc(size_t count, size_t size) noexcept
+{
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    return __libc_calloc(count, size);
+}
+
+extern "C" void *realloc(void *ptr, size_t size) noexcept
+{
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    return __libc_realloc(ptr, size);
+}
+#define HAS_ALLOCATION_COUNTER
+#endif
+
+static const QByteArray rmc("$GPRMC,123519.00,A,4807.038,N,01131.000,E,022.4,084.4,230394,003.1,W*44\r\n");
+static const QByteArray gga("$GPGGA,123519.00,4807.038,N,01131.000,E,1,08,0.9,545.4,M,46.9,M,,*69\r\n");
+static const QByteArray gsa("$GPGSA,A,3,04,05,,09,12,,,24,,,,,2.5,1.3,2.1*39\r\n");
+static const QByteArray gll("$GPGLL,4916.45,N,12311.12,W,225444,A*31\r\n");
+static const QByteArray vtg("$GPVTG,054.7,T,034.4,M,005.5,N,010.2,K*48\r\n");
+static const QByteArray zda("$GPZDA,201530.00,04,07,2002,00,00*60\r\n");
+static const QByteArray gsv("$GPGSV,3,1,11,03,03,111,00,04,15,270,00,06,01,010,00,13,06,292,00*74\r\n");
+
+class tst_QNmeaParsingBenchmark : public QObject
+{
+    Q_OBJECT
+private slots:
+    void parsePosition_data();
+    void parsePosition();
+
+    void parseSatellitesInView();
+    void parseSatellitesInUse();
+
+    void allocationsPerSentence_data();
+    void allocationsPerSentence();
+
+    void decodeBatch_data();
+    void decodeBatch();
+
+    void validateChecksum_data();
+    void validateChecksum();
+    void splitStream_data();
+    void splitStream();
+};
+
+// The byte by byte implementation QLocationUtils::hasValidNmeaChecksum() used
+// before QNmeaSentenceScanner, for comparison.
+static bool legacyHasValidNmeaChecksum(QByteArrayView bv)
+{
+    qsizetype asteriskIndex = bv.indexOf('*');
+
+    constexpr qsizetype CSUM_LEN = 2;
+    if (asteriskIndex < 0 || asteriskIndex >= bv.size() - CSUM_LEN)
+        return false;
+
+    int result = 0;
+    for (qsizetype i = 1; i < asteriskIndex; ++i)
+        result ^= bv[i];
+
+    QByteArrayView checkSumBytes = bv.sliced(asteriskIndex + 1, 2);
+    bool ok = false;
+    int checksum = checkSumBytes.toInt(&ok,16);
+    return ok && checksum == result;
+}
+
+void tst_QNmeaParsingBenchmark::parsePosition_data()
+{
+    QTest::addColumn<QByteArray>("sentence");
+
+    QTest::newRow("RMC") << rmc;
+    QTest::newRow("GGA") << gga;
+    QTest::newRow("GSA") << gsa;
+    QTest::newRow("GLL") << gll;
+    QTest::newRow("VTG") << vtg;
+    QTest::newRow("ZDA") << zda;
+}
+
+void tst_QNmeaParsingBenchmark::parsePosition()
+{
+    QFETCH(QByteArray, sentence);
+
+    QBENCHMARK {
+        QGeoPositionInfo info;
+        const bool parsed = QLocationUtils::getPosInfoFromNmea(sentence, &info, 5.1);
+        Q_UNUSED(parsed)
+    }
+}
+
+void tst_QNmeaParsingBenchmark::parseSatellitesInView()
+{
+    QList<QGeoSatelliteInfo> infos;
+    QGeoSatelliteInfo::SatelliteSystem system;
+    QBENCHMARK {
+        const auto status = QLocationUtils::getSatInfoFromNmea(gsv, infos, system);
+        Q_UNUSED(status)
+    }
+}
+
+void tst_QNmeaParsingBenchmark::parseSatellitesInUse()
+{
+    QList<int> pnrsInUse;
+    QBENCHMARK {
+        const auto system = QLocationUtils::getSatInUseFromNmea(gsa, pnrsInUse);
+        Q_UNUSED(system)
+    }
+}
+
+void tst_QNmeaParsingBenchmark::allocationsPerSentence_data()
+{
+    parsePosition_data();
+    QTest::newRow("GSV") << gsv;
+}
+
+void tst_QNmeaParsingBenchmark::allocationsPerSentence()
+{
+#ifdef HAS_ALLOCATION_COUNTER
+    QFETCH(QByteArray, sentence);
+
+    constexpr int iterations = 1000;
+    const bool isGsv = QLocationUtils::getNmeaSentenceType(sentence)
+            == QLocationUtils::NmeaSentenceGSV;
+
+    // Reuse the output objects, so that only the allocations made by the
+    // parser itself are counted.
+    QGeoPositionInfo info;
+    QList<QGeoSatelliteInfo> infos;
+    infos.reserve(4);
+    QGeoSatelliteInfo::SatelliteSystem system;
+    info.setAttribute(QGeoPositionInfo::Direction, 0.0); // detach
+
+    const quint64 before = allocationCount.load(std::memory_order_relaxed);
+    for (int i = 0; i < iterations; ++i) {
+        if (isGsv) {
+            infos.clear();
+            QLocationUtils::getSatInfoFromNmea(sentence, infos, system);
+        } else {
+            QLocationUtils::getPosInfoFromNmea(sentence, &info, 5.1);
+        }
+    }
+    const quint64 allocations = allocationCount.load(std::memory_order_relaxed) - before;
+
+    QTest::setBenchmarkResult(qreal(allocations) / iterations, QTest::Events);
+#else
+    QSKIP("Configure with -DQT_NMEA_BENCHMARK_COUNT_ALLOCATIONS=ON on Linux, without "
+          "sanitizers, to count allocations");
+#endif
+}
+
+void tst_QNmeaParsingBenchmark::decodeBatch_data()
+{
+    QTest::addColumn<int>("threadCount");
+
+    QTest::newRow("sequential") << 1;
+    QTest::newRow("2 threads") << 2;
+    QTest::newRow("4 threads") << 4;
+    QTest::newRow("ideal thread count") << 0;
+}
+
+void tst_QNmeaParsingBenchmark::decodeBatch()
+{
+    QFETCH(int, threadCount);
+
+    // A log of 10000 epochs with four sentences each. Divide the number of
+    // sentences by the measured time to get the throughput.
+    QByteArray log;
+    for (int i = 0; i < 10000; ++i)
+        log += rmc + gga + gsa + gsv;
+
+    QBENCHMARK {
+        QNmeaBatchDecoder decoder(5.1);
+        decoder.setThreadCount(threadCount);
+        const QList<QGeoPositionInfo> positions = decoder.decode(log);
+        Q_UNUSED(positions)
+    }
+}
+
+void tst_QNmeaParsingBenchmark::validateChecksum_data()
+{
+    QTest::addColumn<QByteArray>("sentence");
+    QTest::addColumn<bool>("legacy");
+
+    QTest::newRow("RMC, byte by byte") << rmc << true;
+    QTest::newRow("RMC, scanner") << rmc << false;
+    QTest::newRow("GSA, byte by byte") << gsa << true;
+    QTest::newRow("GSA, scanner") << gsa << false;
+    QTest::newRow("GSV, byte by byte") << gsv << true;
+    QTest::newRow("GSV, scanner") << gsv << false;
+}
+
+void tst_QNmeaParsingBenchmark::validateChecksum()
+{
+    QFETCH(QByteArray, sentence);
+    QFETCH(bool, legacy);
+
+    QCOMPARE(QNmeaSentenceScanner::hasValidChecksum(sentence), true);
+    QCOMPARE(legacyHasValidNmeaChecksum(sentence), true);
+
+    bool valid = true;
+    if (legacy) {
+        QBENCHMARK {
+            valid &= legacyHasValidNmeaChecksum(sentence);
+        }
+    } else {
+        QBENCHMARK {
+            valid &= QNmeaSentenceScanner::hasValidChecksum(sentence);
+        }
+    }
+    QVERIFY(valid);
+}
+
+void tst_QNmeaParsingBenchmark::splitStream_data()
+{
+    QTest::addColumn<bool>("legacy");
+
+    QTest::newRow("readLine") << true;
+    QTest::newRow("scanner") << false;
+}
+
+void tst_QNmeaParsingBenchmark::splitStream()
+{
+    QFETCH(bool, legacy);
+
+    // How the real-time readers get the sentences out of the device, without
+    // parsing them.
+    constexpr int epochs = 10000;
+    QByteArray log;
+    for (int i = 0; i < epochs; ++i)
+        log += rmc + gga + gsa + gsv;
+
+    qsizetype sentences = 0;
+    QBENCHMARK {
+        QBuffer device(&log);
+        device.open(QIODevice::ReadOnly);
+        sentences = 0;
+        if (legacy) {
+            char buf[1024];
+            while (device.canReadLine()) {
+                if (device.readLine(buf, sizeof(buf)) > 0)
+                    ++sentences;
+            }
+        } else {
+            QNmeaSentenceScanner scanner;
+            char buf[4096];
+            qint64 size;
+            while ((size = device.read(buf, sizeof(buf))) > 0) {
+                scanner.addData(QByteArrayView(buf, qsizetype(size)), [&](QByteArrayView) {
+                    ++sentences;
+                });
+            }
+        }
+    }
+    QCOMPARE(sentences, 4 * epochs);
+}
+
+QTEST_MAIN(tst_QNmeaParsingBenchmark)
+
+#include "tst_bench_qnmeaparsing.moc"